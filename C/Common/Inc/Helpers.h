@@ -16,6 +16,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
+#include "SCIconfig.h"
 
 /******************************************************************************
  * Defines
@@ -36,10 +37,23 @@
  * @param   b_round         Value gets rounded according to the after point digits or not.
  * @returns Output string size in bytes.
  */
+#ifndef SCI_NO_FLOAT
 uint8_t ftoa (uint8_t *pui8_resBuf, float val, bool b_round);
+#endif
 
 bool strToHex (uint8_t *pui8_strBuf, uint32_t *pui32_val);
 
+/** \brief Converts a string of hex digit pairs into bytes.
+ *
+ * The conversion can be done in place (pui8_bytes == pui8_strBuf).
+ * 
+ * @param   *pui8_strBuf    Hex digits (upper case, two per byte).
+ * @param   ui8_strLen      Number of digits.
+ * @param   *pui8_bytes     Output buffer (ui8_strLen / 2 bytes).
+ * @returns False on an odd number of digits or an invalid digit.
+ */
+bool strToHexBytes (uint8_t *pui8_strBuf, uint8_t ui8_strLen, uint8_t *pui8_bytes);
+
 // int8_t hexToStr (uint8_t *pui8_strBuf, uint32_t *pui32_val, uint8_t ui8_maxDataNibbles, bool shrinkZeros);
 
 int8_t hexToStrByte (uint8_t *pui8_strBuf, uint8_t *pui8_val, bool shrinkZeros);
@@ -29,12 +29,21 @@
 #define EEPROM_WORD_ADDRESSABLE      2
 #define EEPROM_LONG_ADDRESSABLE      4
 
+// EEPROM read policies on GETVAR
+#define EEPROM_READ_ALWAYS          0   /*!< Every GETVAR reads the EEPROM.*/
+#define EEPROM_READ_ONCE            1   /*!< The EEPROM is read once, afterwards the RAM value is served.*/
+#define EEPROM_READ_AFTER_WRITE     2   /*!< Like EEPROM_READ_ONCE, but the first GETVAR after a write reads back the EEPROM.*/
+
 #define UNKNOWN_IDENTIFIER      '#'
 #define GETVAR_IDENTIFIER       '?'
 #define SETVAR_IDENTIFIER       '!'
 #define COMMAND_IDENTIFIER      ':'
 #define UPSTREAM_IDENTIFIER     '>'
 #define DOWNSTREAM_IDENTIFIER   '<'
+#define NOTIFY_IDENTIFIER       '*'
+#define DELTA_IDENTIFIER        '%'
+#define MEMORY_IDENTIFIER       '@'
+#define COMPLETE_IDENTIFIER     '$'
 /******************************************************************************
  * Type definitions
  *****************************************************************************/
@@ -51,7 +60,11 @@ typedef enum
     eSCI_MASTER_ERROR_PARAMETER_CONVERSION_FAILED,
     eSCI_MASTER_ERROR_EXPECTED_DATALENGTH_NOT_MET,
     eSCI_MASTER_ERROR_MESSAGE_EXCEEDS_TX_BUFFER_SIZE,
-    eSCI_MASTER_ERROR_FEATURE_NOT_IMPLEMENTED
+    eSCI_MASTER_ERROR_FEATURE_NOT_IMPLEMENTED,
+    eSCI_MASTER_ERROR_NOTIFICATION_MALFORMED,
+    eSCI_MASTER_ERROR_RESPONSE_TIMEOUT,
+    eSCI_MASTER_ERROR_OUT_OF_TRANSFER_MEMORY,
+    eSCI_MASTER_ERROR_DOWNSTREAM_REFUSED
 }teSCI_MASTER_ERROR;
 
 /** \brief SCI Slave errors */
@@ -68,7 +81,20 @@ typedef enum
     eSCI_SLAVE_ERROR_VARIABLE_NUMBER_CONVERSION_FAILED,
     eSCI_SLAVE_ERROR_REQUEST_VALUE_CONVERSION_FAILED,
     eSCI_SLAVE_ERROR_REQUEST_UNKNOWN,
-    eSCI_SLAVE_ERROR_UPSTREAM_NOT_INITIATED
+    eSCI_SLAVE_ERROR_UPSTREAM_NOT_INITIATED,
+    eSCI_SLAVE_ERROR_SUBSCRIPTION_TABLE_FULL,
+    eSCI_SLAVE_ERROR_VAR_NOT_SCALAR,
+    eSCI_SLAVE_ERROR_ARRAY_RANGE_INVALID,
+    eSCI_SLAVE_ERROR_MEM_WINDOW_INVALID,
+    eSCI_SLAVE_ERROR_MEM_ACCESS_INVALID,
+    eSCI_SLAVE_ERROR_DOWNSTREAM_NOT_INITIATED,
+    eSCI_SLAVE_ERROR_DOWNSTREAM_REJECTED,
+    eSCI_SLAVE_ERROR_DOWNSTREAM_RANGE_INVALID,
+    eSCI_SLAVE_ERROR_PENDING_TABLE_FULL,
+    eSCI_SLAVE_ERROR_COMMAND_NOT_PENDING,
+    eSCI_SLAVE_ERROR_UPSTREAM_WINDOW_INVALID,
+    eSCI_SLAVE_ERROR_VAR_LIST_TOO_LONG,
+    eSCI_SLAVE_ERROR_VAR_LIST_INVALID
 }teSCI_SLAVE_ERROR;
 
 /** @brief SCI version data structure */
@@ -26,6 +26,29 @@
 #define COMMAND_IDENTIFIER      ':'
 #define UPSTREAM_IDENTIFIER     '>'
 #define DOWNSTREAM_IDENTIFIER   '<'
+#define NOTIFY_IDENTIFIER       '*'
+#define DELTA_IDENTIFIER        '%'
+#define MEMORY_IDENTIFIER       '@'
+#define COMPLETE_IDENTIFIER     '$'
+
+// Memory window write: Offset, byte count and the data bytes (4 per request value, LSB first).
+// A write is a single request, larger blocks are split by the application.
+#define SCI_MEM_WRITE_MAX_BYTES ((MAX_NUM_REQUEST_VALUES - 2) * 4)
+
+// DOWNSTREAM chunk: "FFFF<FFFFFFFF;" header, followed by two hex digits per data byte
+#define SCI_DOWNSTREAM_CHUNK_MAX_BYTES  ((RX_PACKET_LENGTH - 16) / 2)
+
+// GETVAR of a variable list: The first request value is SCI_VAR_LIST_MARKER, the others are the numbers of
+// the variables read along with the requested one (a GETVAR of a scalar with any other values is rejected).
+// The answer is one "FFFF?DAT;FF;" message, up to 8 hex digits and a separator per value: A status word
+// followed by a value per variable, the requested one first. Bit n of the status word is set if variable n
+// could not be read, its value is the slave error number then.
+#define SCI_VAR_LIST_MARKER     0x10000
+#define SCI_VAR_LIST_BY_LENGTH  ((TX_PACKET_LENGTH - 16) / 9)
+#define SCI_VAR_LIST_MAX_CNT    ((SCI_VAR_LIST_BY_LENGTH < MAX_NUM_RESPONSE_VALUES ? SCI_VAR_LIST_BY_LENGTH : MAX_NUM_RESPONSE_VALUES) - 1)
+
+// COMMAND result generator: Values produced per call while a DAT packet is assembled (held on the stack)
+#define SCI_RESPONSE_GEN_WINDOW 8
 /******************************************************************************
  * Type definitions
  *****************************************************************************/
@@ -38,7 +61,8 @@ typedef enum
     eREQUEST_ACK_STATUS_SUCCESS_DATA        = 1,
     eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM    = 2,
     eREQUEST_ACK_STATUS_ERROR               = 3,
-    eREQUEST_ACK_STATUS_UNKNOWN             = 4
+    eREQUEST_ACK_STATUS_UNKNOWN             = 4,
+    eREQUEST_ACK_STATUS_PENDING             = 5     /*!< Command accepted, the result is delivered when completed.*/
 }teREQUEST_ACKNOWLEDGE;
 
 /** \brief Return value of the Transfer callbacks*/
@@ -57,7 +81,11 @@ typedef enum
     eREQUEST_TYPE_SETVAR        = 2,
     eREQUEST_TYPE_COMMAND       = 3,
     eREQUEST_TYPE_UPSTREAM      = 4,
-    eREQUEST_TYPE_DOWNSTREAM    = 5
+    eREQUEST_TYPE_DOWNSTREAM    = 5,
+    eREQUEST_TYPE_NOTIFY        = 6,    /*!< Unsolicited slave frame, never requested by the master.*/
+    eREQUEST_TYPE_DELTA         = 7,    /*!< Variables modified since a given generation.*/
+    eREQUEST_TYPE_MEMORY        = 8,    /*!< Memory window read / write.*/
+    eREQUEST_TYPE_COMPLETE      = 9     /*!< Unsolicited slave frame, a pending command has been completed.*/
 }teREQUEST_TYPE;
 
 typedef union
@@ -68,6 +96,32 @@ typedef union
 
 typedef tuREQUESTVALUE tuRESPONSEVALUE;
 
+/** \brief Pulls upstream data from the application.
+ *
+ * Called once per upstream packet with the byte offset within the upstream. The
+ * source must write ui8MaxLen bytes into pui8Dst and returns the number of bytes
+ * written (a short packet is zero padded, the master expects full packets).
+ */
+typedef uint8_t (*UPSTREAM_READ_CB)(void *pCtx, uint32_t ui32Offset, uint8_t *pui8Dst, uint8_t ui8MaxLen);
+
+/** \brief Generates COMMAND result values on demand.
+ *
+ * Called while a DAT packet is assembled with the index of the next value to send,
+ * as long as the packet has room (max. SCI_RESPONSE_GEN_WINDOW values per call and
+ * MAX_NUM_RESPONSE_VALUES per packet). Values that don't fit the packet are requested
+ * again for the next one. Writes up to
+ * ui8MaxCnt values into puVals and returns the number written (missing values are
+ * sent as 0, the master expects the announced count).
+ */
+typedef uint8_t (*RESPONSE_GEN_CB)(void *pCtx, uint32_t ui32Idx, tuRESPONSEVALUE *puVals, uint8_t ui8MaxCnt);
+
+/** \brief One slice of a command executed over several state machine calls.
+ *
+ * Returns eREQUEST_ACK_STATUS_PENDING to be invoked again, otherwise the final acknowledge.
+ * Result values (max. MAX_NUM_RESPONSE_VALUES) and error number are written on completion.
+ */
+typedef teREQUEST_ACKNOWLEDGE (*COMMAND_STEP_CB)(void *pCtx, tuRESPONSEVALUE *puVals, uint8_t *pui8ValCnt, uint16_t *pui16Error);
+
 typedef struct
 {
     union
@@ -76,18 +130,32 @@ typedef struct
         {
             // uint8_t dataBufDynamic      : 1;
             uint8_t upstreamBufDynamic  : 1;
-            uint8_t reserved            : 7;
+            uint8_t respGenerated       : 1;    /*!< The result values are produced by cbRespGen (puRespVals is not used).*/
+            uint8_t reserved            : 6;
         }ui8InfoFlagBits;
 
         uint8_t ui8InfoFlagByte;
     };
     uint8_t         *pui8UpStreamBuf;
-    tuRESPONSEVALUE puRespVals[MAX_NUM_RESPONSE_VALUES];
+    UPSTREAM_READ_CB cbUpStreamRead;    /*!< Upstream source (used instead of pui8UpStreamBuf if set).*/
+    void            *pUpStreamCtx;      /*!< Context passed to the upstream source.*/
+    COMMAND_STEP_CB cbStep;             /*!< Step callback of a PENDING command (executed in slices if set).*/
+    void            *pStepCtx;          /*!< Context passed to the step callback.*/
+    union
+    {
+        tuRESPONSEVALUE puRespVals[MAX_NUM_RESPONSE_VALUES];
+        struct
+        {
+            RESPONSE_GEN_CB cbRespGen;  /*!< Result value generator (used instead of puRespVals if respGenerated is set).*/
+            void            *pRespGenCtx; /*!< Context passed to the result value generator.*/
+        };
+    };
     uint32_t        ui32DatLen;
+    uint32_t        ui32Generation;     /*!< DELTA: Generation the response synchronizes to.*/
     uint16_t        ui16Error;
 }tsTRANSFER_DATA;
 
-#define tsTRANSFER_DATA_DEFAULTS {{.ui8InfoFlagByte = 0}, NULL, {{.ui32_hex = 0}}, 0, 0}
+#define tsTRANSFER_DATA_DEFAULTS {{.ui8InfoFlagByte = 0}, NULL, NULL, NULL, NULL, NULL, {.puRespVals = {{.ui32_hex = 0}}}, 0, 0, 0}
 
 /** \brief REQUEST structure declaration.*/
 typedef struct
@@ -96,9 +164,11 @@ typedef struct
     teREQUEST_TYPE  eReqType;                          /*!< REQUEST Type.*/
     tuREQUESTVALUE  *uValArr;                          /*!< Pointer to the value array.*/
     uint8_t         ui8ValArrLen;                      /*!< Length of the value Array.*/
+    const uint8_t   *pui8Data;                         /*!< Binary data of a DOWNSTREAM chunk (NULL: No chunk).*/
+    uint8_t         ui8DataLen;                        /*!< Number of chunk data bytes.*/
 }tsREQUEST;
 
-#define tsREQUEST_DEFAULTS         {0, 0, NULL, eREQUEST_TYPE_NONE}
+#define tsREQUEST_DEFAULTS         {0, eREQUEST_TYPE_NONE, NULL, 0, NULL, 0}
 
 /** \brief Response structure declaration.*/
 typedef struct
@@ -44,7 +44,10 @@ typedef enum
     eDTYPE_INT16  = 3,
     eDTYPE_UINT32 = 4,
     eDTYPE_INT32  = 5,
-    eDTYPE_F32    = 6
+    eDTYPE_F32    = 6,
+    eDTYPE_UINT64 = 7,
+    eDTYPE_INT64  = 8,
+    eDTYPE_F64    = 9
 }teDTYPE;
 
 /** \brief Action procedure declaration for a setVar operation.*/
@@ -58,6 +61,8 @@ typedef struct
     teDTYPE     eDatatype;   /*!< Datatype of the linked variable.*/
 
     ACTION_PROCEDURE ap;
+
+    uint16_t    ui16Cnt;     /*!< Number of array elements pVal points to (0: Scalar variable).*/
 }tsSCIVAR;
 
 #endif //_SCIVARIABLES_H_
\ No newline at end of file
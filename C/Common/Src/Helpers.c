@@ -24,6 +24,7 @@ const uint8_t hexNibbleConv[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8',
 /******************************************************************************
  * Function definitions
  *****************************************************************************/
+#ifndef SCI_NO_FLOAT
 uint8_t ftoa (uint8_t *pui8_resBuf, float val, bool b_round)
 {
     float signum            = (val < 0) * -1 + (val > 0);
@@ -131,6 +132,7 @@ uint8_t ftoa (uint8_t *pui8_resBuf, float val, bool b_round)
     }
     return ui8_size;
 }
+#endif
 
 //=============================================================================
 bool strToHex (uint8_t *pui8_strBuf, uint32_t *pui32_val)
@@ -234,6 +236,34 @@ bool strToHex (uint8_t *pui8_strBuf, uint32_t *pui32_val)
 //     terminate: return numberOfDigits;
 // }
 
+//=============================================================================
+bool strToHexBytes (uint8_t *pui8_strBuf, uint8_t ui8_strLen, uint8_t *pui8_bytes)
+{
+    uint8_t ui8_nibble;
+
+    // Two digits per byte
+    if (ui8_strLen & 1)
+        return false;
+
+    for (uint8_t i = 0; i < ui8_strLen; i++)
+    {
+        if(pui8_strBuf[i] >='0' && pui8_strBuf[i] <= '9')
+            ui8_nibble = pui8_strBuf[i] - '0';
+        else if (pui8_strBuf[i] >= 'A' && pui8_strBuf[i] <= 'F')
+            ui8_nibble = pui8_strBuf[i] - 'A' + 10;
+        else
+            return false;
+
+        // Byte i/2 is written after digit i has been read (in place conversion)
+        if (i & 1)
+            pui8_bytes[i >> 1] |= ui8_nibble;
+        else
+            pui8_bytes[i >> 1] = ui8_nibble << 4;
+    }
+
+    return true;
+}
+
 //=============================================================================
 int8_t hexToStrByte (uint8_t *pui8_strBuf, uint8_t *pui8_val, bool shrinkZeros)
 {
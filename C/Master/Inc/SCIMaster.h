@@ -13,7 +13,6 @@
  *  - 2022-12-12 - Adapted code for unified master/slave repo structure.
  * 
  * <b> TODOs </b>
- * @todo Response Timeout
  * @todo Clean Error tracking and response
  *****************************************************************************/
 
@@ -42,14 +41,38 @@ extern "C" {
 #define SCI_RECEIVE_MODE_TRANSFER   0
 #define SCI_RECEIVE_MODE_STREAM     1
 
+#define SCI_REQUEST_TYPE_CNT        (eREQUEST_TYPE_COMPLETE + 1)
+
+// Variables read by one poll request (the first one is requested, the others are listed behind the marker)
+#define SCI_MASTER_POLL_BATCH       (SCI_VAR_LIST_MAX_CNT < MAX_NUM_REQUEST_VALUES ? SCI_VAR_LIST_MAX_CNT : MAX_NUM_REQUEST_VALUES)
+
 /******************************************************************************
  * Type definitions
  *****************************************************************************/
 
 typedef teTRANSFER_ACK (*MASTER_SETVAR_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum);
 typedef teTRANSFER_ACK (*MASTER_GETVAR_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
-typedef teTRANSFER_ACK (*MASTER_COMMAND_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint8_t ui8DataCnt, uint16_t ui16ErrNum);
+/** \brief COMMAND result callback.
+ *
+ * API change: ui32DataCnt used to be an uint8_t. Generated results (RESPONSE_GEN_CB) may exceed
+ * 255 values, existing callbacks have to be adapted to the uint32_t count.
+ */
+typedef teTRANSFER_ACK (*MASTER_COMMAND_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum);
 typedef teTRANSFER_ACK (*MASTER_UPSTREAM_CB)(int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt);
+typedef teTRANSFER_ACK (*MASTER_UPSTREAM_CHUNK_CB)(int16_t i16Num, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8Len);
+typedef void (*MASTER_NOTIFY_CB)(int16_t i16Num, uint32_t ui32Data);
+typedef teTRANSFER_ACK (*MASTER_DELTA_CB)(teREQUEST_ACKNOWLEDGE eAck, uint32_t ui32Generation, uint32_t *pui32Pairs, uint8_t ui8PairCnt, uint16_t ui16ErrNum);
+typedef teTRANSFER_ACK (*MASTER_GETARRAY_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum);
+typedef teTRANSFER_ACK (*MASTER_MEMORY_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Window, uint8_t *pui8Data, uint32_t ui32ByteCnt, uint16_t ui16ErrNum);
+typedef teTRANSFER_ACK (*MASTER_DOWNSTREAM_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32ByteCnt, uint16_t ui16ErrNum);
+typedef void (*MASTER_COMPLETE_CB)(int16_t i16Num, teREQUEST_ACKNOWLEDGE eAck);
+
+/** \brief Completion callback of a queued request.
+ *
+ * ui32Value holds the first value of the final response frame (e.g. the GETVAR value).
+ * Results spanning several frames are delivered through the type specific callbacks.
+ */
+typedef void (*MASTER_REQUEST_CB)(void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum);
 
 typedef struct
 {
@@ -58,16 +81,142 @@ typedef struct
     MASTER_GETVAR_CB GetVarExternalCB;
     MASTER_COMMAND_CB CommandExternalCB;
     MASTER_UPSTREAM_CB UpstreamExternalCB;
+    MASTER_UPSTREAM_CHUNK_CB UpstreamChunkExternalCB;  /*!< Streaming upstream delivery (optional, see SCIMasterInit).*/
+    MASTER_NOTIFY_CB NotifyExternalCB;
+    MASTER_DELTA_CB DeltaExternalCB;
+    MASTER_GETARRAY_CB GetArrayExternalCB;
+    MASTER_MEMORY_CB MemoryExternalCB;
+    MASTER_DOWNSTREAM_CB DownstreamExternalCB;
+    MASTER_COMPLETE_CB CompleteExternalCB;
 
     // Transmission related external callbacks
     void        (*BlockingTxExternalCB)(uint8_t* pui8Buf, uint8_t ui8Len);
     uint8_t     (*NonBlockingTxExternalCB)(uint8_t* pui8Buf, uint8_t ui8Len);
     bool        (*GetTxBusyStateExternalCB)(void);
 
+    // Millisecond tick for the response timeouts (optional, NULL: No timeouts)
+    uint32_t    (*GetTickMsExternalCB)(void);
+
 }tsSCI_MASTER_CALLBACKS;
 
 #define tsSCI_MASTER_CALLBACKS_DEFAULTS {NULL}
 
+/** \brief Request waiting in the master request queue.*/
+typedef struct
+{
+    teREQUEST_TYPE      eReqType;
+    int16_t             i16Num;
+    tuREQUESTVALUE      uValArr[MAX_NUM_REQUEST_VALUES];    /*!< Copy of the request values.*/
+    uint8_t             ui8ValArrLen;
+    MASTER_REQUEST_CB   cbDone;                             /*!< Completion callback (optional).*/
+    void                *pCtx;                              /*!< User context passed to cbDone.*/
+}tsSCI_QUEUED_REQUEST;
+
+/** \brief Bounded request queue (the head entry is kept until its request is completed).*/
+typedef struct
+{
+    tsSCI_QUEUED_REQUEST    sEntries[SCI_MASTER_QUEUE_LENGTH];
+    uint8_t                 ui8Head;    /*!< Oldest entry.*/
+    uint8_t                 ui8Cnt;     /*!< Number of entries.*/
+    bool                    bActive;    /*!< The head entry is being transferred.*/
+}tsSCI_REQUEST_QUEUE;
+
+#define tsSCI_REQUEST_QUEUE_DEFAULTS {{{eREQUEST_TYPE_NONE, 0, {{.ui32_hex = 0}}, 0, NULL, NULL}}, 0, 0, false}
+
+/** \brief Response timeout and retries of a request type.*/
+typedef struct
+{
+    uint16_t    ui16TimeoutMs;  /*!< Response window of the first attempt (0: No timeout).*/
+    uint8_t     ui8MaxRetries;  /*!< Number of times the request is sent again.*/
+}tsSCI_RETRY_POLICY;
+
+/** \brief Retry and timeout statistics of the master.*/
+typedef struct
+{
+    uint32_t    ui32Timeouts;       /*!< Response windows that elapsed without response.*/
+    uint32_t    ui32Retries;        /*!< Requests sent again after a timeout.*/
+    uint32_t    ui32Failures;       /*!< Requests given up (eSCI_MASTER_ERROR_RESPONSE_TIMEOUT).*/
+    uint32_t    ui32StaleFrames;    /*!< Responses dropped because they don't answer the pending request.*/
+    uint32_t    ui32MirrorHits;     /*!< Mirror reads served without transfer.*/
+    uint32_t    ui32MirrorCoalesced;/*!< Mirror reads answered by the GETVAR of another read.*/
+    uint32_t    ui32PollFrames;     /*!< Requests of the polling scheduler.*/
+}tsSCI_MASTER_STATS;
+
+#define tsSCI_MASTER_STATS_DEFAULTS {0, 0, 0, 0, 0, 0, 0}
+
+#ifdef SCI_MASTER_MIRROR_SIZE
+/** \brief Last known value of a variable.*/
+typedef struct
+{
+    int16_t     i16Num;
+    uint32_t    ui32Value;
+    uint32_t    ui32Tick;       /*!< Tick the value has been received or set.*/
+    bool        bValid;
+    bool        bPending;       /*!< The GETVAR of the mirror is queued.*/
+}tsSCI_MIRROR_ENTRY;
+
+/** \brief Mirror read waiting for the GETVAR of its variable.*/
+typedef struct
+{
+    tsSCI_MIRROR_ENTRY  *psEntry;   /*!< NULL: Unused.*/
+    MASTER_REQUEST_CB   cbDone;
+    void                *pCtx;
+}tsSCI_MIRROR_WAITER;
+
+/** \brief Variable values mirrored by the master.*/
+typedef struct
+{
+    tsSCI_MIRROR_ENTRY  sEntries[SCI_MASTER_MIRROR_SIZE];
+    tsSCI_MIRROR_WAITER sWaiters[SCI_MASTER_MIRROR_WAITERS];
+}tsSCI_MIRROR;
+
+#define tsSCI_MIRROR_DEFAULTS {{{0, 0, 0, false, false}}, {{NULL, NULL, NULL}}}
+#endif
+
+#ifdef SCI_MASTER_POLL_SIZE
+/** \brief Timing statistics of a polled variable.*/
+typedef struct
+{
+    uint32_t    ui32Polls;          /*!< Values delivered.*/
+    uint32_t    ui32Errors;         /*!< Polls answered with an error or given up.*/
+    uint32_t    ui32Missed;         /*!< Periods that passed without a poll (missed deadlines).*/
+    uint32_t    ui32LatencySumMs;   /*!< Sum of the delays between release and value (mean: / ui32Polls).*/
+    uint16_t    ui16MaxLatencyMs;   /*!< Largest delay between release and value.*/
+    uint16_t    ui16MinLatencyMs;   /*!< Smallest delay between release and value (valid once ui32Polls > 0).*/
+    uint16_t    ui16LastLatencyMs;  /*!< Delay between release and value of the latest poll.*/
+    uint16_t    ui16MaxJitterMs;    /*!< Largest change of the delay between two consecutive polls.*/
+    uint32_t    ui32JitterSumMs;    /*!< Sum of the delay changes between consecutive polls (mean: / (ui32Polls - 1)).*/
+}tsSCI_POLL_STATS;
+
+#define tsSCI_POLL_STATS_DEFAULTS {0, 0, 0, 0, 0, 0, 0, 0, 0}
+
+/** \brief Variable polled by the scheduler.*/
+typedef struct
+{
+    int16_t             i16Num;
+    uint16_t            ui16PeriodMs;   /*!< 0: Unused.*/
+    MASTER_REQUEST_CB   cbValue;
+    void                *pCtx;
+    uint32_t            ui32ReleaseTick;/*!< Tick the next poll is due.*/
+    bool                bInFlight;      /*!< Part of the pending poll request.*/
+    tsSCI_POLL_STATS    sStats;
+}tsSCI_POLL_ENTRY;
+
+/** \brief Polling scheduler (one request in flight at a time).*/
+typedef struct
+{
+    tsSCI_POLL_ENTRY    sEntries[SCI_MASTER_POLL_SIZE];
+    uint8_t             ui8Batch[SCI_MASTER_POLL_BATCH];    /*!< Entries read by the pending request.*/
+    uint32_t            ui32Values[SCI_MASTER_POLL_BATCH];  /*!< Values received for the pending request.*/
+    uint32_t            ui32Failed;                         /*!< Status word of the values (bit n: Value n is an error).*/
+    uint8_t             ui8BatchCnt;                        /*!< 0: No request pending.*/
+    uint8_t             ui8ValueCnt;
+    uint8_t             ui8GroupCnt;                        /*!< Rate groups created (phase of the next group).*/
+}tsSCI_POLL;
+
+#define tsSCI_POLL_DEFAULTS {{{0, 0, NULL, NULL, 0, false, tsSCI_POLL_STATS_DEFAULTS}}, {0}, {0}, 0, 0, 0, 0}
+#endif
+
 /** \brief SCI Master main structure */
 typedef struct
 {
@@ -86,6 +235,23 @@ typedef struct
 
     tsSCI_TRANSFER sSCITransfer;
 
+    tsSCI_REQUEST_QUEUE sQueue; /*!< Queued requests. */
+
+    uint32_t (*GetTickMs)(void);                            /*!< Millisecond tick (NULL: No timeouts). */
+    uint32_t ui32RequestTick;                               /*!< Tick the pending request has been sent. */
+    uint8_t ui8RetryCnt;                                    /*!< Retries of the pending request. */
+    tsSCI_RETRY_POLICY sRetryPolicy[SCI_REQUEST_TYPE_CNT];  /*!< Timeout and retries per request type. */
+    tsSCI_MASTER_STATS sStats;
+
+    uint8_t ui8EvalBuffer[RX_PACKET_LENGTH];    /*!< Frame being evaluated while the next one is received. */
+    tsFIFO_BUF sEvalFIFO;
+    bool bPipelined;                            /*!< The next upstream request has already been sent. */
+    bool bUnanswered;                           /*!< A request without response (or a dropped pipelined one) is being sent. */
+
+    tsREQUEST sDeferredReq;                     /*!< Request sent by the state machine later on (bDeferred). */
+    bool bDeferred;
+    bool bHold;                                 /*!< The next request is deferred until ui32HoldTick. */
+    uint32_t ui32HoldTick;
 }tsSCI_MASTER;
 
 #define tsSCI_MASTER_DEFAULTS { \
@@ -96,13 +262,25 @@ typedef struct
     tsFIFO_BUF_DEFAULTS, \
     SCI_RECEIVE_MODE_TRANSFER, \
     tsDATALINK_DEFAULTS, \
-    tsSCI_TRANSFER_DEFAULTS \
+    tsSCI_TRANSFER_DEFAULTS, \
+    tsSCI_REQUEST_QUEUE_DEFAULTS, \
+    NULL, 0, 0, {{0, 0}}, \
+    tsSCI_MASTER_STATS_DEFAULTS, \
+    {0}, tsFIFO_BUF_DEFAULTS, false, false, \
+    tsREQUEST_DEFAULTS, false, false, 0 \
 }
 
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
 /** \brief Initializes the SCI Master.
+ * 
+ * If the UpstreamChunkExternalCB is set, upstream data isn't buffered: Every 
+ * received upstream frame is passed to it straight from the receive buffer 
+ * (offset within the upstream, data, length). The UpstreamExternalCB (memory 
+ * reads: MemoryExternalCB) then signals the end of the upstream with pui8Data NULL
+ * and the number of bytes delivered. Returning eTRANSFER_ACK_ABORT from the chunk
+ * callback ends the upstream early.
  * 
  * @param sCallbacks    External functions to call by the SCI Master.
 */
@@ -144,10 +322,24 @@ void SCIFinishStreamReceive (void);
  * 
  * @param sReq Request data structure
  * 
- * @returns Success indicator
+ * @returns False if the master is busy or the request could not be assembled (nothing is sent)
 */
 bool SCIInitiateRequest (tsREQUEST sReq);
 
+/** \brief Sends a request the slave doesn't answer.
+ * 
+ * The request is sent in the background, the protocol stays ready for the next 
+ * request.
+ * 
+ * @param sReq Request data structure
+ * 
+ * @returns Success indicator
+*/
+bool SCIInitiateUnansweredRequest (tsREQUEST sReq);
+
+/** \brief Waits for the next frame of the stream without sending a request.*/
+void SCIContinueStreamReceive (void);
+
 /** \brief Releases the SCI protocol into IDLE state.*/
 void SCIReleaseProtocol (void);
 
@@ -157,23 +349,271 @@ void SCIReleaseProtocol (void);
 /** \brief Initiate a GETVAR request
  * 
  * @param i16VarNum Variable number to request
+ * @returns False if the master is busy (see SCIQueueRequest)
  */
-void SCIRequestGetVar (int16_t i16VarNum);
+bool SCIRequestGetVar (int16_t i16VarNum);
 
 /** \brief Initiate a SETVAR request
  * 
  * @param i16VarNum Variable number to request
  * @param uVal      Variable value to set
+ * @returns False if the master is busy (see SCIQueueRequest)
  */
-void SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal);
+bool SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal);
 
 /** \brief Initiate a COMMAND request
  * 
  * @param i16CmdNum Variable number to request
  * @param puValArr  Pointer to the value array to transmit
  * @param ui8ArgNum Number of elements in the value array
+ * @returns False if the master is busy (see SCIQueueRequest)
+ */
+bool SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint8_t ui8ArgNum);
+
+/** \brief Initiate a DELTA request
+ * 
+ * Requests all variables modified since the passed generation. The DeltaExternalCB
+ * receives the variable number / value pairs (alternating in pui32Pairs) and the 
+ * generation to pass with the next DELTA request. If the slave signals more pending
+ * modifications (DAT), the request is continued automatically unless the callback 
+ * returns eTRANSFER_ACK_ABORT.
+ * 
+ * @param ui32Generation    Generation of the last synchronization (0 requests all variables)
+ * @returns False if the master is busy (see SCIQueueRequest)
  */
-void SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint8_t ui8ArgNum);
+bool SCIRequestDelta (uint32_t ui32Generation);
+
+/** \brief Initiate a GETVAR request of an array or 64 bit variable
+ * 
+ * The slave sends the requested elements as a word stream (64 bit elements: low
+ * word first), which may span several messages. The GetArrayExternalCB receives 
+ * all words once the transfer is complete, or the error of the slave.
+ * 
+ * @param i16VarNum Variable number to request
+ * @param ui16Start First element to read
+ * @param ui16Cnt   Number of elements to read (0: All elements from ui16Start on)
+ * @returns False if the master is busy (see SCIQueueRequest)
+ */
+bool SCIRequestGetArray (int16_t i16VarNum, uint16_t ui16Start, uint16_t ui16Cnt);
+
+/** \brief Initiate a SETVAR request of an array or 64 bit variable
+ * 
+ * The result is reported by the SetVarExternalCB.
+ * 
+ * @param i16VarNum Variable number to request
+ * @param ui16Start First element to write
+ * @param puValArr  Words to write (complete elements, 64 bit elements: low word first)
+ * @param ui8Cnt    Number of words in puValArr
+ * @returns False if the words do not fit into one request
+ */
+bool SCIRequestSetArray (int16_t i16VarNum, uint16_t ui16Start, tuREQUESTVALUE *puValArr, uint8_t ui8Cnt);
+
+/** \brief Initiate a MEMORY read request
+ * 
+ * Reads bytes of a memory window the slave has whitelisted. The data is 
+ * transferred through the upstream path and passed to the MemoryExternalCB 
+ * once complete (eAck eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM).
+ * 
+ * @param i16Window     Memory window number
+ * @param ui32Offset    Offset within the window
+ * @param ui32ByteCnt   Number of bytes to read
+ * @returns False if the master is busy (see SCIQueueRequest)
+ */
+bool SCIRequestMemRead (int16_t i16Window, uint32_t ui32Offset, uint32_t ui32ByteCnt);
+
+/** \brief Initiate a MEMORY write request
+ * 
+ * The result is reported by the MemoryExternalCB.
+ * 
+ * The bytes are carried by the request values of a single request, so a write is 
+ * limited to SCI_MEM_WRITE_MAX_BYTES. Larger blocks have to be split into several 
+ * writes, or be sent with SCIRequestDownstream to a DOWNSTREAM sink of the slave 
+ * that stores them (the DOWNSTREAM path does not address memory windows).
+ * 
+ * @param i16Window     Memory window number
+ * @param ui32Offset    Offset within the window
+ * @param pui8Data      Bytes to write
+ * @param ui8ByteCnt    Number of bytes to write
+ * @returns False if the bytes do not fit into one request (SCI_MEM_WRITE_MAX_BYTES)
+ */
+bool SCIRequestMemWrite (int16_t i16Window, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8ByteCnt);
+
+/** \brief Initiate a DOWNSTREAM transfer
+ * 
+ * Announces ui32ByteCnt bytes to the downstream sink of the slave and sends them
+ * in chunks of up to SCI_DOWNSTREAM_CHUNK_MAX_BYTES. Every chunk is acknowledged 
+ * with the offset the slave expects next, so chunks the sink didn't take are 
+ * repeated. The DownstreamExternalCB reports the result once all bytes have been 
+ * acknowledged (ui32ByteCnt: Acknowledged bytes) or the slave returned an error.
+ * 
+ * @param i16Num        Downstream number (passed to the sink of the slave)
+ * @param pui8Data      Bytes to transfer (must stay valid until the callback)
+ * @param ui32ByteCnt   Number of bytes to transfer
+ * @returns False if the transfer could not be started
+ */
+bool SCIRequestDownstream (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32ByteCnt);
+
+/** \brief Resume an interrupted DOWNSTREAM transfer
+ * 
+ * Continues from the offset the slave has acknowledged last, without announcing
+ * the transfer again. Data and size must match the interrupted transfer.
+ * 
+ * @param i16Num        Downstream number of the interrupted transfer
+ * @param pui8Data      Bytes to transfer (all of them, starting with offset 0)
+ * @param ui32ByteCnt   Number of bytes to transfer
+ * @returns False if the transfer could not be started
+ */
+bool SCIRequestDownstreamResume (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32ByteCnt);
+
+/** \brief Resume an UPSTREAM that failed with a response timeout
+ * 
+ * Requests the data from the first byte that has not been received. The slave 
+ * keeps the upstream until another request is sent, a new request also drops 
+ * the suspended upstream on the master side. The upstream callback is invoked 
+ * as if the upstream had not been interrupted.
+ * 
+ * @returns False if there is no suspended upstream or the interface is busy
+ */
+bool SCIResumeUpstream (void);
+
+/** \brief Queue a request
+ * 
+ * The request is started as soon as the master is idle, queued requests are sent
+ * back to back in the order they have been queued. The request values are copied.
+ * Requests of all types started through SCITransferStart (GETVAR, SETVAR, COMMAND,
+ * DELTA, MEMORY) can be queued. Besides cbDone, the type specific callbacks are
+ * invoked as for directly started requests.
+ * 
+ * @param eReqType      Request type
+ * @param i16Num        Variable / command / window number
+ * @param puValArr      Request values (may be NULL if ui8ValCnt is 0)
+ * @param ui8ValCnt     Number of request values (max. MAX_NUM_REQUEST_VALUES)
+ * @param cbDone        Completion callback (optional)
+ * @param pCtx          User context passed to cbDone
+ * @returns False if the queue is full or the request is invalid
+ */
+bool SCIQueueRequest (teREQUEST_TYPE eReqType, int16_t i16Num, const tuREQUESTVALUE *puValArr, uint8_t ui8ValCnt, MASTER_REQUEST_CB cbDone, void *pCtx);
+
+#ifdef SCI_MASTER_MIRROR_SIZE
+/** \brief Read a variable through the mirror
+ * 
+ * A value not older than ui16MaxAgeMs is passed to cbDone right away. Otherwise a 
+ * GETVAR is queued (see SCIQueueRequest), reads of a variable whose GETVAR is still
+ * pending wait for it instead of queueing another one. Values are also taken over 
+ * from GETVAR responses and notifications of mirrored variables, regardless of who 
+ * sent the request. A SETVAR drops the mirrored value (the slave stores it in the 
+ * datatype of the variable, the next read transfers it). Requires the GetTickMsExternalCB, without it
+ * every read transfers the value (concurrent reads are still coalesced).
+ * 
+ * @param i16VarNum     Variable number (scalar variables only)
+ * @param ui16MaxAgeMs  Maximum age of a mirrored value (0: Always transfer)
+ * @param cbDone        Completion callback (optional)
+ * @param pCtx          User context passed to cbDone
+ * @returns False if the mirror, its waiters or the queue are exhausted
+ */
+bool SCIMirrorRead (int16_t i16VarNum, uint16_t ui16MaxAgeMs, MASTER_REQUEST_CB cbDone, void *pCtx);
+
+/** \brief Returns a mirrored value without transfer
+ * 
+ * @param i16VarNum     Variable number
+ * @param ui16MaxAgeMs  Maximum age of the value
+ * @param pui32Value    Mirrored value
+ * @returns False if the variable isn't mirrored or the value is too old
+ */
+bool SCIMirrorGet (int16_t i16VarNum, uint16_t ui16MaxAgeMs, uint32_t *pui32Value);
+
+/** \brief Drops the mirrored value of a variable, the next read transfers it.*/
+void SCIMirrorInvalidate (int16_t i16VarNum);
+#endif
+
+#ifdef SCI_MASTER_POLL_SIZE
+/** \brief Poll a variable periodically
+ * 
+ * Variables with the same period form a rate group and are released together. 
+ * A new group is released on the ticks of the fastest group, a minor cycle later 
+ * than the group before: Slower groups ride along with different requests of the
+ * fastest group, which spreads the load across the cycle (harmonic periods 
+ * registered fastest first give the best packing). Due variables are packed into as few requests as possible: A GETVAR
+ * of the first variable lists the others behind SCI_VAR_LIST_MARKER (up to SCI_MASTER_POLL_BATCH 
+ * variables, the status word and the values are also reported to the GetArrayExternalCB). 
+ * A variable the slave can't read is reported as error with the slave error number, 
+ * the others of the request still get their values (if the whole request fails, the 
+ * error is reported for the requested variable and the listed ones are polled again 
+ * right away). The requests are queued 
+ * like SCIQueueRequest, with one request in flight at a time. A variable whose 
+ * value arrives after its next release has missed that deadline, it continues 
+ * with the release after.
+ * 
+ * Requires the GetTickMsExternalCB. Registrations are dropped by SCIMasterInit.
+ * 
+ * @param i16VarNum     Variable number (scalar variables only)
+ * @param ui16PeriodMs  Poll period
+ * @param cbValue       Called with every value or error (optional)
+ * @param pCtx          User context passed to cbValue
+ * @returns Handle of the registration, -1 if the scheduler is full
+ */
+int8_t SCIPollRegister (int16_t i16VarNum, uint16_t ui16PeriodMs, MASTER_REQUEST_CB cbValue, void *pCtx);
+
+/** \brief Stop polling a variable (a value in flight is dropped)
+ * 
+ * @param i8Handle      Handle returned by SCIPollRegister
+ */
+void SCIPollUnregister (int8_t i8Handle);
+
+/** \brief Returns the latency, jitter and deadline statistics of a polled variable
+ * 
+ * The jitter is the change of the release-to-value delay from one poll to the next.
+ * 
+ * @param i8Handle      Handle returned by SCIPollRegister
+ * @param psStats       Statistics since the registration
+ * @returns False if the handle is not registered
+ */
+bool SCIPollGetStats (int8_t i8Handle, tsSCI_POLL_STATS *psStats);
+#endif
+
+/** \brief Returns the number of queued requests (including the active one).*/
+uint8_t SCIGetQueuedRequestCount (void);
+
+/** \brief Set the response timeout and retries of a request type
+ * 
+ * Requires the GetTickMsExternalCB. If no response arrives within the timeout, 
+ * the request is sent again up to ui8MaxRetries times, the response window doubles 
+ * with every retry (a late response is still accepted). Afterwards the request is 
+ * reported by its callback with eREQUEST_ACK_STATUS_ERROR and 
+ * eSCI_MASTER_ERROR_RESPONSE_TIMEOUT.
+ * 
+ * Only requests the slave can safely process twice are retried by default: GETVAR,
+ * DELTA and MEMORY reads, MEMORY writes of absolute values and DOWNSTREAM chunks 
+ * (addressed by their offset). SETVARs may trigger EEPROM writes or other side effects
+ * of the variable and COMMANDs may have side effects, both are not retried unless
+ * enabled with this function. Continuations of multi-message transfers (command / array results, 
+ * upstream) are never retried, the slave has already moved on to the next message.
+ * Policies are reset to the defaults by SCIMasterInit.
+ * 
+ * @param eReqType      Request type
+ * @param ui16TimeoutMs Response window of the first attempt (0: No timeout)
+ * @param ui8MaxRetries Number of retries
+ * @returns False if the request type is invalid
+ */
+bool SCISetRetryPolicy (teREQUEST_TYPE eReqType, uint16_t ui16TimeoutMs, uint8_t ui8MaxRetries);
+
+/** \brief Set the destination buffer of transfer results and upstream data
+ * 
+ * Command / array results and upstream data are stored in a static pool 
+ * (SCI_MASTER_POOL_BLOCK_SIZE bytes per transfer) unless a destination buffer 
+ * is set. The pointers passed to the result callbacks then point into this buffer,
+ * which is reused by every transfer. Transfers exceeding the buffer (or a pool 
+ * block) are reported with eREQUEST_ACK_STATUS_ERROR and 
+ * eSCI_MASTER_ERROR_OUT_OF_TRANSFER_MEMORY. Change the buffer only while the 
+ * master is idle.
+ * 
+ * @param pBuf      Destination buffer (4 byte aligned, NULL: Use the pool)
+ * @param ui32Size  Size of the buffer in bytes
+ */
+void SCISetTransferDestination (void *pBuf, uint32_t ui32Size);
+
+/** \brief Returns the retry and timeout statistics (reset by SCIMasterInit).*/
+tsSCI_MASTER_STATS SCIGetMasterStats (void);
 
 /** \brief Returns the current protocol state
  * 
@@ -60,29 +60,85 @@ typedef struct
     uint32_t        ui32TransferCnt;
     tuRESPONSEVALUE *uTransferResults;
     uint8_t         *pui8UpstreamBuffer;
+    tuREQUESTVALUE  uGeneration;        /*!< Generation of an ongoing DELTA request.*/
+    teREQUEST_TYPE  eStreamReqType;     /*!< Request type that initiated the ongoing upstream.*/
+    const uint8_t   *pui8DownstreamData;/*!< Data of the ongoing downstream (owned by the application).*/
+    uint32_t        ui32DownstreamSize; /*!< Number of bytes of the ongoing downstream.*/
+    tuREQUESTVALUE  uDownstreamArg;     /*!< Size (announce) or offset (chunk) of the downstream request.*/
+    tuREQUESTVALUE  uReqVals[MAX_NUM_REQUEST_VALUES];   /*!< Copy of the request values (the request may be repeated).*/
+    uint8_t         ui8ReqValCnt;       /*!< Number of values of the initial request.*/
+    tuREQUESTVALUE  uStreamArgs[2];     /*!< Window and offset (or acknowledged offset) of the upstream request.*/
+    uint32_t        ui32AckedDataCnt;   /*!< Upstream bytes acknowledged to the slave (free running upstream).*/
+    uint8_t         ui8DownstreamRefusals; /*!< Consecutive refusals of the downstream chunk at uDownstreamArg.*/
 }tsTRANSFER_INFO;
 
-#define tsTRANSFER_INFO_DEFAULTS {tsREQUEST_DEFAULTS, 0, 0, 0, 0, NULL, NULL}
+#define tsTRANSFER_INFO_DEFAULTS {tsREQUEST_DEFAULTS, 0, 0, 0, 0, NULL, NULL, {.ui32_hex = 0}, eREQUEST_TYPE_NONE, NULL, 0, {.ui32_hex = 0}, {{.ui32_hex = 0}}, 0, {{.ui32_hex = 0}}, 0, 0}
+
+/** \brief Static memory for transfer results and upstream data.
+ * 
+ * Blocks are handed out in O(1) from a stack of released blocks. A destination 
+ * buffer of the application replaces the pool while it is set.
+ */
+typedef struct
+{
+    uint32_t    ui32Blocks[SCI_MASTER_POOL_BLOCK_CNT][SCI_MASTER_POOL_BLOCK_SIZE / sizeof(uint32_t)];
+    uint8_t     ui8Released[SCI_MASTER_POOL_BLOCK_CNT];  /*!< Indices of released blocks.*/
+    uint8_t     ui8ReleasedCnt;
+    uint8_t     ui8UnusedIdx;                           /*!< First block that has never been handed out.*/
+    void        *pDestination;                          /*!< Destination buffer of the application (NULL: Pool).*/
+    uint32_t    ui32DestinationSize;
+}tsSCI_TRANSFER_POOL;
+
+#define tsSCI_TRANSFER_POOL_DEFAULTS {{{0}}, {0}, 0, 0, NULL, 0}
+
+/** \brief Upstream that has been cut off by link errors.
+ * 
+ * The slave keeps its state as long as no other request is sent, the upstream 
+ * can be continued from the data received so far.
+ */
+typedef struct
+{
+    int16_t         i16Num;             /*!< Number of the upstream.*/
+    teREQUEST_TYPE  eStreamReqType;     /*!< Request type that initiated the upstream.*/
+    uint8_t         *pui8Buffer;        /*!< Data received so far (NULL: Handed over to the chunk callback).*/
+    uint32_t        ui32Offset;         /*!< Number of bytes received.*/
+    uint32_t        ui32Size;           /*!< Number of bytes announced by the slave.*/
+    bool            bValid;
+}tsSCI_UPSTREAM_RESUME;
+
+#define tsSCI_UPSTREAM_RESUME_DEFAULTS {0, eREQUEST_TYPE_NONE, NULL, 0, 0, false}
 
 typedef struct
 {
     tsTRANSFER_INFO     sTransferInfo;
+    tsSCI_TRANSFER_POOL sPool;
+    tsSCI_UPSTREAM_RESUME sResume;
 
     struct
     {
         teTRANSFER_ACK  (*SetVarCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum);
         teTRANSFER_ACK  (*GetVarCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
-        teTRANSFER_ACK  (*CommandCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint8_t ui8DataCnt, uint16_t ui16ErrNum);
+        teTRANSFER_ACK  (*CommandCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum);
         teTRANSFER_ACK  (*UpstreamCB)(int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt);
+        teTRANSFER_ACK  (*UpstreamChunkCB)(int16_t i16Num, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8Len);
+        void            (*NotifyCB)(int16_t i16Num, uint32_t ui32Data);
+        teTRANSFER_ACK  (*DeltaCB)(teREQUEST_ACKNOWLEDGE eAck, uint32_t ui32Generation, uint32_t *pui32Pairs, uint8_t ui8PairCnt, uint16_t ui16ErrNum);
+        teTRANSFER_ACK  (*GetArrayCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum);
+        teTRANSFER_ACK  (*MemoryCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Window, uint8_t *pui8Data, uint32_t ui32ByteCnt, uint16_t ui16ErrNum);
+        teTRANSFER_ACK  (*DownstreamCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32ByteCnt, uint16_t ui16ErrNum);
+        void            (*CompleteCB)(int16_t i16Num, teREQUEST_ACKNOWLEDGE eAck);
 
         bool        (*RequestCB)(tsREQUEST sReq);
         void        (*InitiateStreamCB)(uint32_t ui32ByteCount);
         void        (*FinishStreamCB)(void);
         void        (*ReleaseProtocolCB)(void);
+        void        (*ContinueStreamCB)(void);
+        bool        (*UnansweredRequestCB)(tsREQUEST sReq);
+        bool        (*BackoffCB)(uint8_t ui8Attempt);   /*!< Delays the next request (false: Give up).*/
     }sCallbacks;
 }tsSCI_TRANSFER;
 
-#define tsSCI_TRANSFER_DEFAULTS {tsTRANSFER_INFO_DEFAULTS, {NULL}}
+#define tsSCI_TRANSFER_DEFAULTS {tsTRANSFER_INFO_DEFAULTS, tsSCI_TRANSFER_POOL_DEFAULTS, tsSCI_UPSTREAM_RESUME_DEFAULTS, {NULL}}
 
 /******************************************************************************
  * Function declarations
@@ -100,17 +156,81 @@ typedef struct
  * */
 bool SCITransferStart (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16CmdNum, tuREQUESTVALUE *uVal, uint8_t ui8ArgNum);
 
+/** \brief Starts a DOWNSTREAM transfer.
+ * 
+ * The transfer is announced with its size, afterwards the chunks are sent from the
+ * offset the slave acknowledges. A resumed transfer skips the announce and queries
+ * the offset of the slave with an empty chunk instead. A chunk the sink refuses is
+ * repeated after the BackoffCB delay, the transfer fails with 
+ * eSCI_MASTER_ERROR_DOWNSTREAM_REFUSED once the BackoffCB gives up.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * @param i16Num        Request number of the transfer
+ * @param pui8Data      Data to transfer (must stay valid until the transfer is complete)
+ * @param ui32Size      Number of bytes to transfer
+ * @param bResume       Continue a transfer the slave already knows
+ * 
+ * @returns Error indicator
+ * */
+bool SCITransferStartDownstream (tsSCI_TRANSFER *psSciTransfer, int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Size, bool bResume);
+
 /** \brief Handles the transfer responses according to the protocol mechanisms.
  * 
  * TODO:
  * - What is going to be done if the device returns "UNKNOWN" ?
  * 
  * @param psSciTransfer Pointer to the transfer data
- * @param sRsp          Response data that has just been arrived
+ * @param psRsp         Response data that has just been arrived
  * 
  * @returns Error indicator
  * */
-bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp);
+bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp);
+
+/** \brief Returns all blocks to the transfer memory pool.
+ * 
+ * Must not be called while a transfer is ongoing. The destination buffer is kept.
+ * 
+ * @param psPool    Pointer to the pool
+ * */
+void SCITransferPoolReset (tsSCI_TRANSFER_POOL *psPool);
+
+/** \brief Gives up the pending request.
+ * 
+ * An ongoing upstream is suspended, it may be continued with 
+ * SCITransferResumeUpstream. The callback of the request type reports 
+ * eREQUEST_ACK_STATUS_ERROR with the passed error number, like an error response 
+ * of the slave.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * @param psRsp         Filled with the response that has been reported
+ * @param ui16Error     Error number to report
+ * */
+void SCITransferAbort (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp, uint16_t ui16Error);
+
+/** \brief Requests the upstream from the number of bytes received so far.
+ * 
+ * Used after chunks have been lost. Must only be called when the link is quiet, 
+ * a chunk still on its way would be taken for the requested one.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * 
+ * @returns Success indicator
+ * */
+bool SCITransferRestartUpstream (tsSCI_TRANSFER *psSciTransfer);
+
+/** \brief Continues a suspended upstream.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * 
+ * @returns false if there is no suspended upstream or the protocol is busy
+ * */
+bool SCITransferResumeUpstream (tsSCI_TRANSFER *psSciTransfer);
+
+/** \brief Drops a suspended upstream and releases its memory.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * */
+void SCITransferDiscardUpstream (tsSCI_TRANSFER *psSciTransfer);
 
 
 
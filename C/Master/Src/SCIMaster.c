@@ -28,48 +28,204 @@
 #include "Buffer.h"
 #include "Helpers.h"
 
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+// Largest doubling of a response window / backoff (keeps the shift defined for any retry count)
+#define SCI_MASTER_BACKOFF_SHIFT_MAX    16
+
 /******************************************************************************
  * Global variable definition
  *****************************************************************************/
 static tsSCI_MASTER sSciMaster = tsSCI_MASTER_DEFAULTS;
 
+#ifdef SCI_MASTER_MIRROR_SIZE
+static tsSCI_MIRROR sMirror = tsSCI_MIRROR_DEFAULTS;
+#endif
+
+#ifdef SCI_MASTER_POLL_SIZE
+static tsSCI_POLL sPoll = tsSCI_POLL_DEFAULTS;
+#endif
+
+// Requests the slave may process twice are retried
+static const tsSCI_RETRY_POLICY sDefaultRetryPolicy[SCI_REQUEST_TYPE_CNT] = {
+    [eREQUEST_TYPE_GETVAR]      = {SCI_MASTER_TIMEOUT_MS, SCI_MASTER_MAX_RETRIES},
+    [eREQUEST_TYPE_SETVAR]      = {SCI_MASTER_TIMEOUT_MS, 0},
+    [eREQUEST_TYPE_COMMAND]     = {SCI_MASTER_COMMAND_TIMEOUT_MS, 0},
+    [eREQUEST_TYPE_UPSTREAM]    = {SCI_MASTER_TIMEOUT_MS, SCI_MASTER_MAX_RETRIES},
+    [eREQUEST_TYPE_DOWNSTREAM]  = {SCI_MASTER_TIMEOUT_MS, SCI_MASTER_MAX_RETRIES},
+    [eREQUEST_TYPE_DELTA]       = {SCI_MASTER_TIMEOUT_MS, SCI_MASTER_MAX_RETRIES},
+    [eREQUEST_TYPE_MEMORY]      = {SCI_MASTER_TIMEOUT_MS, SCI_MASTER_MAX_RETRIES}
+};
+
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static void _SCIMasterTakeFrame (void);
+static void _SCIMasterEvaluateFrame (bool bSolicited);
+#ifdef SCI_MASTER_UPSTREAM_PIPELINE
+static void _SCIMasterPipelineUpstream (void);
+#endif
+static void _SCIMasterDropPipelined (void);
+static bool _SCIMasterTransmitRequest (tsREQUEST sReq);
+static bool _SCIMasterBackoff (uint8_t ui8Attempt);
+static void _SCIMasterProcessResponse (tsRESPONSE *psRsp);
+static void _SCIMasterCheckTimeout (void);
+static void _SCIMasterStartQueued (void);
+static void _SCIMasterFinishQueued (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum);
+#ifdef SCI_MASTER_MIRROR_SIZE
+static tsSCI_MIRROR_ENTRY* _SCIMasterMirrorFind (int16_t i16Num, bool bAllocate);
+static void _SCIMasterMirrorUpdate (tsRESPONSE *psRsp);
+static void _SCIMasterMirrorDone (void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum);
+#endif
+#ifdef SCI_MASTER_POLL_SIZE
+static void _SCIMasterPollService (void);
+static void _SCIMasterPollCollect (tsRESPONSE *psRsp);
+static void _SCIMasterPollDone (void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum);
+#endif
+
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
 void SCIMasterInit (tsSCI_MASTER_CALLBACKS sCallbacks)
 {
+    tsSCI_REQUEST_QUEUE sCleanQueue = tsSCI_REQUEST_QUEUE_DEFAULTS;
+    tsSCI_MASTER_STATS sCleanStats = tsSCI_MASTER_STATS_DEFAULTS;
+    tsSCI_UPSTREAM_RESUME sCleanResume = tsSCI_UPSTREAM_RESUME_DEFAULTS;
+    #ifdef SCI_MASTER_MIRROR_SIZE
+    tsSCI_MIRROR sCleanMirror = tsSCI_MIRROR_DEFAULTS;
+    #endif
+    #ifdef SCI_MASTER_POLL_SIZE
+    tsSCI_POLL sCleanPoll = tsSCI_POLL_DEFAULTS;
+    #endif
+
     // Connect the internal callbacks
     sSciMaster.sSCITransfer.sCallbacks.InitiateStreamCB = SCIInitiateStreamReceive;
     sSciMaster.sSCITransfer.sCallbacks.FinishStreamCB = SCIFinishStreamReceive;
     sSciMaster.sSCITransfer.sCallbacks.ReleaseProtocolCB = SCIReleaseProtocol;
     sSciMaster.sSCITransfer.sCallbacks.RequestCB = SCIInitiateRequest;
+    sSciMaster.sSCITransfer.sCallbacks.ContinueStreamCB = SCIContinueStreamReceive;
+    sSciMaster.sSCITransfer.sCallbacks.UnansweredRequestCB = SCIInitiateUnansweredRequest;
+    sSciMaster.sSCITransfer.sCallbacks.BackoffCB = _SCIMasterBackoff;
 
     // Connect the external callbacks
     sSciMaster.sSCITransfer.sCallbacks.GetVarCB = sCallbacks.GetVarExternalCB;
     sSciMaster.sSCITransfer.sCallbacks.SetVarCB = sCallbacks.SetVarExternalCB;
     sSciMaster.sSCITransfer.sCallbacks.CommandCB = sCallbacks.CommandExternalCB;
     sSciMaster.sSCITransfer.sCallbacks.UpstreamCB = sCallbacks.UpstreamExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.UpstreamChunkCB = sCallbacks.UpstreamChunkExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.NotifyCB = sCallbacks.NotifyExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.DeltaCB = sCallbacks.DeltaExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.GetArrayCB = sCallbacks.GetArrayExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.MemoryCB = sCallbacks.MemoryExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.DownstreamCB = sCallbacks.DownstreamExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.CompleteCB = sCallbacks.CompleteExternalCB;
     sSciMaster.sDatalink.txBlockingCallback = sCallbacks.BlockingTxExternalCB;
     sSciMaster.sDatalink.txNonBlockingCallback = sCallbacks.NonBlockingTxExternalCB;
     sSciMaster.sDatalink.txGetBusyStateCallback = sCallbacks.GetTxBusyStateExternalCB;
 
+    // Drop the requests queued before
+    sSciMaster.sQueue = sCleanQueue;
+    #ifdef SCI_MASTER_MIRROR_SIZE
+    sMirror = sCleanMirror;
+    #endif
+    #ifdef SCI_MASTER_POLL_SIZE
+    sPoll = sCleanPoll;
+    #endif
+
+    // Response timeouts
+    sSciMaster.GetTickMs = sCallbacks.GetTickMsExternalCB;
+    memcpy(sSciMaster.sRetryPolicy, sDefaultRetryPolicy, sizeof(sDefaultRetryPolicy));
+    sSciMaster.sStats = sCleanStats;
+
+    // Transfers cut off by the initialization release their memory
+    SCITransferPoolReset(&sSciMaster.sSCITransfer.sPool);
+    sSciMaster.sSCITransfer.sResume = sCleanResume;
+
     // Configure data structures
     fifoBufInit(&sSciMaster.sRxFIFO, sSciMaster.ui8RxBuffer, RX_PACKET_LENGTH);
+    fifoBufInit(&sSciMaster.sEvalFIFO, sSciMaster.ui8EvalBuffer, RX_PACKET_LENGTH);
     fifoBufInit(&sSciMaster.sTxFIFO, sSciMaster.ui8TxBuffer, TX_PACKET_LENGTH);
+    sSciMaster.bPipelined = false;
+    sSciMaster.bUnanswered = false;
+    sSciMaster.bDeferred = false;
+    sSciMaster.bHold = false;
+
+    // Listen for unsolicited frames of the slave
+    SCIDatalinkStartRx(&sSciMaster.sDatalink);
 }
 
 //=============================================================================
 void SCIMasterSM (void)
 {
-    teSCI_MASTER_ERROR eError = eSCI_MASTER_ERROR_NONE;
+    #ifdef SCI_MASTER_POLL_SIZE
+    _SCIMasterPollService();
+    #endif
 
     switch (sSciMaster.eProtocolState)
     {
         case ePROTOCOL_IDLE:
+
+            // Unsolicited frame (notification) arrived
+            if (sSciMaster.sDatalink.rState == eDATALINK_RSTATE_PENDING)
+            {
+                _SCIMasterTakeFrame();
+                _SCIMasterEvaluateFrame(false);
+            }
+
+            // Request without response sent in the background
+            if (sSciMaster.bUnanswered)
+            {
+                if (sSciMaster.sDatalink.tState != eDATALINK_TSTATE_READY)
+                    SCIDatalinkTransmitStateMachine(&sSciMaster.sDatalink);
+                else
+                {
+                    SCIDatalinkAcknowledgeTx(&sSciMaster.sDatalink);
+                    sSciMaster.bUnanswered = false;
+                }
+            }
+
+            // Requests queued while a directly started request was running
+            _SCIMasterStartQueued();
             break;
 
         case ePROTOCOL_SENDING:
 
+            // Deferred request: Sent once the transmitter is free and the backoff has passed
+            if (sSciMaster.bDeferred)
+            {
+                // The frame in the background is completed first (a partially sent frame would corrupt the request)
+                if (sSciMaster.bUnanswered)
+                {
+                    if (sSciMaster.sDatalink.tState != eDATALINK_TSTATE_READY)
+                        SCIDatalinkTransmitStateMachine(&sSciMaster.sDatalink);
+                    else
+                    {
+                        SCIDatalinkAcknowledgeTx(&sSciMaster.sDatalink);
+                        sSciMaster.bUnanswered = false;
+                    }
+                    break;
+                }
+
+                if (sSciMaster.bHold && (int32_t)(sSciMaster.GetTickMs() - sSciMaster.ui32HoldTick) < 0)
+                    break;
+
+                sSciMaster.bDeferred = false;
+                sSciMaster.bHold = false;
+                if (!_SCIMasterTransmitRequest(sSciMaster.sDeferredReq))
+                {
+                    sSciMaster.eProtocolState = ePROTOCOL_IDLE;
+
+                    // Same completion handling as a timeout, the queue continues with the next entry
+                    if (sSciMaster.sQueue.bActive)
+                    {
+                        _SCIMasterFinishQueued(eREQUEST_ACK_STATUS_ERROR, sSciMaster.sDeferredReq.i16Num, 0, 0);
+                        _SCIMasterStartQueued();
+                    }
+                }
+                break;
+            }
+
             if (sSciMaster.sDatalink.tState != eDATALINK_TSTATE_READY)
                 SCIDatalinkTransmitStateMachine(&sSciMaster.sDatalink);
             
@@ -83,39 +239,39 @@ void SCIMasterSM (void)
                 // flushBuf(&sSciMaster.sRxFIFO);
 
                 sSciMaster.eProtocolState = ePROTOCOL_RECEIVING;
+                if (sSciMaster.GetTickMs != NULL)
+                    sSciMaster.ui32RequestTick = sSciMaster.GetTickMs();
 
-                // Enable data receive
-                SCIDatalinkStartRx(&sSciMaster.sDatalink);
+                // Enable data receive (unless a notification is already being received)
+                if (sSciMaster.sDatalink.rState == eDATALINK_RSTATE_IDLE)
+                    SCIDatalinkStartRx(&sSciMaster.sDatalink);
             }    
             break;
 
         case ePROTOCOL_RECEIVING:
 
+            #ifdef SCI_MASTER_UPSTREAM_PIPELINE
+            _SCIMasterPipelineUpstream();
+            #endif
+
             // Wait until all data has been received
             if (sSciMaster.sDatalink.rState == eDATALINK_RSTATE_PENDING)
             {
-                SCIDatalinkAcknowledgeRx(&sSciMaster.sDatalink);
+                _SCIMasterTakeFrame();
 
                 sSciMaster.eProtocolState = ePROTOCOL_EVALUATING;
             }
+            else
+                _SCIMasterCheckTimeout();
 
             break;
 
         case ePROTOCOL_EVALUATING:
-            {
-                tsRESPONSE sRsp = tsRESPONSE_DEFAULTS;
-                uint8_t *pui8Buf;
-                uint8_t ui8DframeLen = readBuf(&sSciMaster.sRxFIFO, &pui8Buf);
-
-                // Parse the response
-                if (sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_TRANSFER)
-                    SCIMasterResponseParser(pui8Buf, ui8DframeLen, &sSciMaster.sSCITransfer.sTransferInfo.ui8MessageDataCnt ,&sRsp);
-                else if (sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_STREAM)
-                    SCIMasterStreamParser(pui8Buf, ui8DframeLen, &sSciMaster.sSCITransfer.sTransferInfo.ui8MessageDataCnt, &sRsp);
-
-                // Process the response
-                SCITransferControl(&sSciMaster.sSCITransfer, sRsp);
-            }
+
+            // Notifications, stale or malformed frames don't answer the request -> keep waiting for the response
+            _SCIMasterEvaluateFrame(true);
+            if (sSciMaster.eProtocolState == ePROTOCOL_EVALUATING)
+                sSciMaster.eProtocolState = ePROTOCOL_RECEIVING;
             break;
 
         default:
@@ -139,6 +295,10 @@ void SCIMasterReceiveData (uint8_t *pui8RecBuf, uint16_t ui16ByteCount)
         i++;
         ui16ByteCount--;
     }
+
+    // Upstream chunks are still arriving -> The link is not quiet yet
+    if (sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_STREAM && sSciMaster.GetTickMs != NULL)
+        sSciMaster.ui32RequestTick = sSciMaster.GetTickMs();
 }
 
 //=============================================================================
@@ -158,58 +318,389 @@ void SCIFinishStreamReceive (void)
 //=============================================================================
 bool SCIInitiateRequest (tsREQUEST sReq)
 {
-    uint8_t ui8Size = 0;
-
     // Interface busy -> Don't start transmission
     if (sSciMaster.eProtocolState != ePROTOCOL_IDLE)
         return false;
 
-    // Prepare transmission buffer
-    flushBuf(&sSciMaster.sTxFIFO);
-
-    // Assemble message
-    if (SCIMasterRequestBuilder(sSciMaster.sTxFIFO.pui8_bufPtr, &ui8Size, sReq) == eSCI_MASTER_ERROR_NONE)
+    // The next upstream chunk has already been requested
+    if (sSciMaster.bPipelined && sReq.eReqType == eREQUEST_TYPE_UPSTREAM)
     {
-        increaseBufIdx(&sSciMaster.sTxFIFO, ui8Size);
-
-        SCIDatalinkTransmit(&sSciMaster.sDatalink, &sSciMaster.sTxFIFO);
-
+        sSciMaster.bPipelined = false;
+        sSciMaster.ui8RetryCnt = 0;
         sSciMaster.eProtocolState = ePROTOCOL_SENDING;
+        return true;
     }
-    else
+    _SCIMasterDropPipelined();
+
+    // Transmitter busy or backoff -> The state machine sends the request later on
+    if (sSciMaster.bUnanswered || sSciMaster.bHold)
     {
-        // TODO: What to do on error?
-        ;
+        sSciMaster.ui8RetryCnt = 0;
+        sSciMaster.sDeferredReq = sReq;
+        sSciMaster.bDeferred = true;
+        sSciMaster.eProtocolState = ePROTOCOL_SENDING;
+        return true;
     }
 
+    // The request could not be assembled, nothing has been sent
+    if (!_SCIMasterTransmitRequest(sReq))
+        return false;
+
+    sSciMaster.ui8RetryCnt = 0;
     return true;
 }
 
+//=============================================================================
+bool SCIInitiateUnansweredRequest (tsREQUEST sReq)
+{
+    uint8_t ui8Size = 0;
+
+    // The transmitter must be free
+    if (sSciMaster.bPipelined || sSciMaster.bUnanswered || sSciMaster.eProtocolState == ePROTOCOL_SENDING)
+        return false;
+
+    flushBuf(&sSciMaster.sTxFIFO);
+
+    if (SCIMasterRequestBuilder(sSciMaster.sTxFIFO.pui8_bufPtr, &ui8Size, sReq) != eSCI_MASTER_ERROR_NONE)
+        return false;
+
+    increaseBufIdx(&sSciMaster.sTxFIFO, ui8Size);
+    sSciMaster.bUnanswered = SCIDatalinkTransmit(&sSciMaster.sDatalink, &sSciMaster.sTxFIFO);
+
+    return sSciMaster.bUnanswered;
+}
+
+//=============================================================================
+void SCIContinueStreamReceive (void)
+{
+    sSciMaster.ui8RetryCnt = 0;
+    sSciMaster.eProtocolState = ePROTOCOL_RECEIVING;
+    if (sSciMaster.GetTickMs != NULL)
+        sSciMaster.ui32RequestTick = sSciMaster.GetTickMs();
+}
+
 //=============================================================================
 void SCIReleaseProtocol (void)
 {
     sSciMaster.eProtocolState = ePROTOCOL_IDLE;
+
+    // Keep listening for notifications
+    if (sSciMaster.sDatalink.rState == eDATALINK_RSTATE_IDLE)
+        SCIDatalinkStartRx(&sSciMaster.sDatalink);
+}
+
+//=============================================================================
+bool SCIRequestGetVar (int16_t i16VarNum)
+{
+    // Request generation by the Transfer control module
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_GETVAR, i16VarNum, NULL, 0);
 }
 
 //=============================================================================
-void SCIRequestGetVar (int16_t i16VarNum)
+bool SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal)
 {
     // Request generation by the Transfer control module
-    SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_GETVAR, i16VarNum, NULL, 0);
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, i16VarNum, &uVal, 1);
 }
 
 //=============================================================================
-void SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal)
+bool SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint8_t ui8ArgNum)
 {
     // Request generation by the Transfer control module
-    SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, i16VarNum, &uVal, 1);
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_COMMAND, i16CmdNum, puValArr, ui8ArgNum);
 }
 
 //=============================================================================
-void SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint8_t ui8ArgNum)
+bool SCIRequestDelta (uint32_t ui32Generation)
 {
+    tuREQUESTVALUE uGeneration = {.ui32_hex = ui32Generation};
+
     // Request generation by the Transfer control module
-    SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_COMMAND, i16CmdNum, puValArr, ui8ArgNum);
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_DELTA, 0, &uGeneration, 1);
+}
+
+//=============================================================================
+bool SCIRequestGetArray (int16_t i16VarNum, uint16_t ui16Start, uint16_t ui16Cnt)
+{
+    tuREQUESTVALUE uSlice[2] = {{.ui32_hex = ui16Start}, {.ui32_hex = ui16Cnt}};
+
+    // Request generation by the Transfer control module
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_GETVAR, i16VarNum, uSlice, ui16Cnt > 0 ? 2 : 1);
+}
+
+//=============================================================================
+bool SCIRequestSetArray (int16_t i16VarNum, uint16_t ui16Start, tuREQUESTVALUE *puValArr, uint8_t ui8Cnt)
+{
+    tuREQUESTVALUE uValArr[MAX_NUM_REQUEST_VALUES];
+
+    // The first value is the start element
+    if (ui8Cnt == 0 || ui8Cnt > MAX_NUM_REQUEST_VALUES - 1)
+        return false;
+
+    uValArr[0].ui32_hex = ui16Start;
+    memcpy(&uValArr[1], puValArr, ui8Cnt * sizeof(tuREQUESTVALUE));
+
+    // Request generation by the Transfer control module
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, i16VarNum, uValArr, ui8Cnt + 1);
+}
+
+//=============================================================================
+bool SCIRequestMemRead (int16_t i16Window, uint32_t ui32Offset, uint32_t ui32ByteCnt)
+{
+    tuREQUESTVALUE uRange[2] = {{.ui32_hex = ui32Offset}, {.ui32_hex = ui32ByteCnt}};
+
+    // Request generation by the Transfer control module
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_MEMORY, i16Window, uRange, 2);
+}
+
+//=============================================================================
+bool SCIRequestMemWrite (int16_t i16Window, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8ByteCnt)
+{
+    tuREQUESTVALUE uValArr[MAX_NUM_REQUEST_VALUES] = {{.ui32_hex = ui32Offset}, {.ui32_hex = ui8ByteCnt}};
+
+    if (ui8ByteCnt == 0 || ui8ByteCnt > SCI_MEM_WRITE_MAX_BYTES)
+        return false;
+
+    // 4 bytes per request value, LSB first
+    for (uint8_t i = 0; i < ui8ByteCnt; i++)
+        uValArr[2 + i / 4].ui32_hex |= (uint32_t)pui8Data[i] << ((i % 4) * 8);
+
+    // Request generation by the Transfer control module
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_MEMORY, i16Window, uValArr, 2 + (ui8ByteCnt + 3) / 4);
+}
+
+//=============================================================================
+bool SCIRequestDownstream (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    return SCITransferStartDownstream(&sSciMaster.sSCITransfer, i16Num, pui8Data, ui32ByteCnt, false);
+}
+
+//=============================================================================
+bool SCIRequestDownstreamResume (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    return SCITransferStartDownstream(&sSciMaster.sSCITransfer, i16Num, pui8Data, ui32ByteCnt, true);
+}
+
+//=============================================================================
+bool SCIResumeUpstream (void)
+{
+    return SCITransferResumeUpstream(&sSciMaster.sSCITransfer);
+}
+
+//=============================================================================
+bool SCIQueueRequest (teREQUEST_TYPE eReqType, int16_t i16Num, const tuREQUESTVALUE *puValArr, uint8_t ui8ValCnt, MASTER_REQUEST_CB cbDone, void *pCtx)
+{
+    tsSCI_REQUEST_QUEUE *psQueue = &sSciMaster.sQueue;
+    tsSCI_QUEUED_REQUEST *psEntry;
+
+    if (psQueue->ui8Cnt >= SCI_MASTER_QUEUE_LENGTH || ui8ValCnt > MAX_NUM_REQUEST_VALUES || (ui8ValCnt > 0 && puValArr == NULL))
+        return false;
+
+    // Transfers with external data (DOWNSTREAM) or without request (UPSTREAM) are not queued
+    if (!(eReqType == eREQUEST_TYPE_GETVAR || eReqType == eREQUEST_TYPE_SETVAR || eReqType == eREQUEST_TYPE_COMMAND ||
+          eReqType == eREQUEST_TYPE_DELTA || eReqType == eREQUEST_TYPE_MEMORY))
+        return false;
+
+    psEntry = &psQueue->sEntries[(psQueue->ui8Head + psQueue->ui8Cnt) % SCI_MASTER_QUEUE_LENGTH];
+    psEntry->eReqType       = eReqType;
+    psEntry->i16Num         = i16Num;
+    psEntry->ui8ValArrLen   = ui8ValCnt;
+    psEntry->cbDone         = cbDone;
+    psEntry->pCtx           = pCtx;
+    if (ui8ValCnt > 0)
+        memcpy(psEntry->uValArr, puValArr, ui8ValCnt * sizeof(tuREQUESTVALUE));
+
+    psQueue->ui8Cnt++;
+
+    // Start right away if the master is idle
+    _SCIMasterStartQueued();
+
+    return true;
+}
+
+//=============================================================================
+uint8_t SCIGetQueuedRequestCount (void)
+{
+    return sSciMaster.sQueue.ui8Cnt;
+}
+
+#ifdef SCI_MASTER_MIRROR_SIZE
+//=============================================================================
+bool SCIMirrorRead (int16_t i16VarNum, uint16_t ui16MaxAgeMs, MASTER_REQUEST_CB cbDone, void *pCtx)
+{
+    tsSCI_MIRROR_ENTRY *psEntry;
+    tsSCI_MIRROR_WAITER *psWaiter = NULL;
+    uint32_t ui32Value;
+
+    // Recent enough -> No transfer
+    if (SCIMirrorGet(i16VarNum, ui16MaxAgeMs, &ui32Value))
+    {
+        sSciMaster.sStats.ui32MirrorHits++;
+
+        if (cbDone != NULL)
+            cbDone(pCtx, eREQUEST_ACK_STATUS_SUCCESS, i16VarNum, ui32Value, 0);
+        return true;
+    }
+
+    for (uint8_t i = 0; i < SCI_MASTER_MIRROR_WAITERS && psWaiter == NULL; i++)
+    {
+        if (sMirror.sWaiters[i].psEntry == NULL)
+            psWaiter = &sMirror.sWaiters[i];
+    }
+
+    psEntry = _SCIMasterMirrorFind(i16VarNum, true);
+    if (psWaiter == NULL || psEntry == NULL)
+        return false;
+
+    psWaiter->cbDone = cbDone;
+    psWaiter->pCtx = pCtx;
+    psWaiter->psEntry = psEntry;
+
+    // The GETVAR of another read answers this one as well
+    if (psEntry->bPending)
+    {
+        sSciMaster.sStats.ui32MirrorCoalesced++;
+        return true;
+    }
+
+    // Pending before queueing, a request that can't be started completes right away
+    psEntry->bPending = true;
+    if (SCIQueueRequest(eREQUEST_TYPE_GETVAR, i16VarNum, NULL, 0, _SCIMasterMirrorDone, psEntry))
+        return true;
+
+    psEntry->bPending = false;
+    psWaiter->psEntry = NULL;
+    return false;
+}
+
+//=============================================================================
+bool SCIMirrorGet (int16_t i16VarNum, uint16_t ui16MaxAgeMs, uint32_t *pui32Value)
+{
+    tsSCI_MIRROR_ENTRY *psEntry = _SCIMasterMirrorFind(i16VarNum, false);
+
+    if (psEntry == NULL || !psEntry->bValid || sSciMaster.GetTickMs == NULL ||
+        (uint32_t)(sSciMaster.GetTickMs() - psEntry->ui32Tick) > ui16MaxAgeMs)
+        return false;
+
+    *pui32Value = psEntry->ui32Value;
+    return true;
+}
+
+//=============================================================================
+void SCIMirrorInvalidate (int16_t i16VarNum)
+{
+    tsSCI_MIRROR_ENTRY *psEntry = _SCIMasterMirrorFind(i16VarNum, false);
+
+    if (psEntry != NULL)
+        psEntry->bValid = false;
+}
+#endif
+
+#ifdef SCI_MASTER_POLL_SIZE
+//=============================================================================
+int8_t SCIPollRegister (int16_t i16VarNum, uint16_t ui16PeriodMs, MASTER_REQUEST_CB cbValue, void *pCtx)
+{
+    tsSCI_POLL_STATS sCleanStats = tsSCI_POLL_STATS_DEFAULTS;
+    tsSCI_POLL_ENTRY *psGroup = NULL;
+    tsSCI_POLL_ENTRY *psFastest = NULL;
+    int8_t i8Handle = -1;
+    uint32_t ui32Now;
+
+    if (sSciMaster.GetTickMs == NULL || ui16PeriodMs == 0)
+        return -1;
+
+    for (uint8_t i = 0; i < SCI_MASTER_POLL_SIZE; i++)
+    {
+        if (sPoll.sEntries[i].ui16PeriodMs == 0)
+        {
+            if (i8Handle < 0)
+                i8Handle = (int8_t)i;
+        }
+        else
+        {
+            if (sPoll.sEntries[i].ui16PeriodMs == ui16PeriodMs && psGroup == NULL)
+                psGroup = &sPoll.sEntries[i];
+            if (psFastest == NULL || sPoll.sEntries[i].ui16PeriodMs < psFastest->ui16PeriodMs)
+                psFastest = &sPoll.sEntries[i];
+        }
+    }
+
+    if (i8Handle < 0)
+        return -1;
+
+    ui32Now = sSciMaster.GetTickMs();
+
+    // Join the rate group (its pending request advances the release already)
+    if (psGroup != NULL)
+        sPoll.sEntries[i8Handle].ui32ReleaseTick = psGroup->bInFlight ? psGroup->ui32ReleaseTick + ui16PeriodMs : psGroup->ui32ReleaseTick;
+    // New rate group: On a tick of the fastest group, one minor cycle after the group before
+    else if (psFastest != NULL)
+    {
+        int32_t i32Phase = (int32_t)(psFastest->ui32ReleaseTick + (uint32_t)sPoll.ui8GroupCnt * psFastest->ui16PeriodMs - ui32Now) % ui16PeriodMs;
+
+        sPoll.sEntries[i8Handle].ui32ReleaseTick = ui32Now + (uint32_t)(i32Phase < 0 ? i32Phase + ui16PeriodMs : i32Phase);
+        sPoll.ui8GroupCnt++;
+    }
+    else
+    {
+        sPoll.sEntries[i8Handle].ui32ReleaseTick = ui32Now;
+        sPoll.ui8GroupCnt = 1;
+    }
+
+    sPoll.sEntries[i8Handle].i16Num = i16VarNum;
+    sPoll.sEntries[i8Handle].ui16PeriodMs = ui16PeriodMs;
+    sPoll.sEntries[i8Handle].cbValue = cbValue;
+    sPoll.sEntries[i8Handle].pCtx = pCtx;
+    sPoll.sEntries[i8Handle].bInFlight = false;
+    sPoll.sEntries[i8Handle].sStats = sCleanStats;
+
+    return i8Handle;
+}
+
+//=============================================================================
+void SCIPollUnregister (int8_t i8Handle)
+{
+    if (i8Handle < 0 || i8Handle >= SCI_MASTER_POLL_SIZE)
+        return;
+
+    sPoll.sEntries[i8Handle].ui16PeriodMs = 0;
+    sPoll.sEntries[i8Handle].bInFlight = false;
+}
+
+//=============================================================================
+bool SCIPollGetStats (int8_t i8Handle, tsSCI_POLL_STATS *psStats)
+{
+    if (i8Handle < 0 || i8Handle >= SCI_MASTER_POLL_SIZE || sPoll.sEntries[i8Handle].ui16PeriodMs == 0)
+        return false;
+
+    *psStats = sPoll.sEntries[i8Handle].sStats;
+    return true;
+}
+#endif
+
+//=============================================================================
+bool SCISetRetryPolicy (teREQUEST_TYPE eReqType, uint16_t ui16TimeoutMs, uint8_t ui8MaxRetries)
+{
+    if (eReqType <= eREQUEST_TYPE_NONE || eReqType >= SCI_REQUEST_TYPE_CNT)
+        return false;
+
+    sSciMaster.sRetryPolicy[eReqType].ui16TimeoutMs = ui16TimeoutMs;
+    sSciMaster.sRetryPolicy[eReqType].ui8MaxRetries = ui8MaxRetries;
+
+    return true;
+}
+
+//=============================================================================
+void SCISetTransferDestination (void *pBuf, uint32_t ui32Size)
+{
+    sSciMaster.sSCITransfer.sPool.pDestination = ui32Size > 0 ? pBuf : NULL;
+    sSciMaster.sSCITransfer.sPool.ui32DestinationSize = ui32Size;
+}
+
+//=============================================================================
+tsSCI_MASTER_STATS SCIGetMasterStats (void)
+{
+    return sSciMaster.sStats;
 }
 
 //=============================================================================
@@ -217,3 +708,509 @@ tePROTOCOL_STATE SCIGetProtocolState (void)
 {
     return sSciMaster.eProtocolState;
 }
+
+//=============================================================================
+static void _SCIMasterTakeFrame (void)
+{
+    tsFIFO_BUF sFrame = sSciMaster.sRxFIFO;
+
+    // Evaluate the frame from the second buffer, the next frame can be received right away
+    sSciMaster.sRxFIFO = sSciMaster.sEvalFIFO;
+    sSciMaster.sEvalFIFO = sFrame;
+
+    SCIDatalinkAcknowledgeRx(&sSciMaster.sDatalink);
+    SCIDatalinkStartRx(&sSciMaster.sDatalink);
+}
+
+//=============================================================================
+static void _SCIMasterEvaluateFrame (bool bSolicited)
+{
+    tsRESPONSE sRsp = tsRESPONSE_DEFAULTS;
+    tsREQUEST *psReq = &sSciMaster.sSCITransfer.sTransferInfo.sReq;
+    uint8_t *pui8Buf;
+    uint8_t ui8DframeLen = readBuf(&sSciMaster.sEvalFIFO, &pui8Buf);
+
+    // Parse the response
+    if (sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_TRANSFER)
+        SCIMasterResponseParser(pui8Buf, ui8DframeLen, &sSciMaster.sSCITransfer.sTransferInfo.ui8MessageDataCnt ,&sRsp);
+    else if (sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_STREAM)
+        SCIMasterStreamParser(pui8Buf, ui8DframeLen, &sSciMaster.sSCITransfer.sTransferInfo.ui8MessageDataCnt, &sRsp);
+
+    // Responses arriving after their request has been retried or given up (upstream data carries no number)
+    if (sRsp.eReqType != eREQUEST_TYPE_NOTIFY && sRsp.eReqType != eREQUEST_TYPE_COMPLETE &&
+        (!bSolicited || sRsp.eReqType != psReq->eReqType || (sRsp.eReqType != eREQUEST_TYPE_UPSTREAM && sRsp.i16Num != psReq->i16Num)))
+    {
+        sSciMaster.sStats.ui32StaleFrames++;
+        return;
+    }
+
+    _SCIMasterProcessResponse(&sRsp);
+}
+
+//=============================================================================
+static void _SCIMasterProcessResponse (tsRESPONSE *psRsp)
+{
+    #ifdef SCI_MASTER_MIRROR_SIZE
+    _SCIMasterMirrorUpdate(psRsp);
+    #endif
+    #ifdef SCI_MASTER_POLL_SIZE
+    _SCIMasterPollCollect(psRsp);
+    #endif
+
+    SCITransferControl(&sSciMaster.sSCITransfer, psRsp);
+
+    // The upstream has ended before the pipelined request has been used
+    if (sSciMaster.eProtocolState == ePROTOCOL_IDLE)
+        _SCIMasterDropPipelined();
+
+    // A queued request has been completed -> Start the next one right away
+    if (sSciMaster.sQueue.bActive && sSciMaster.eProtocolState == ePROTOCOL_IDLE &&
+        psRsp->eReqType != eREQUEST_TYPE_NOTIFY && psRsp->eReqType != eREQUEST_TYPE_COMPLETE)
+    {
+        _SCIMasterFinishQueued(psRsp->eReqAck, psRsp->i16Num, psRsp->sTransferData.puRespVals[0].ui32_hex, psRsp->sTransferData.ui16Error);
+        _SCIMasterStartQueued();
+    }
+}
+
+//=============================================================================
+static void _SCIMasterCheckTimeout (void)
+{
+    tsTRANSFER_INFO *psInfo = &sSciMaster.sSCITransfer.sTransferInfo;
+    tsSCI_RETRY_POLICY *psPolicy = &sSciMaster.sRetryPolicy[psInfo->sReq.eReqType];
+    tsRESPONSE sRsp = tsRESPONSE_DEFAULTS;
+    uint8_t ui8RetryCnt = sSciMaster.ui8RetryCnt;
+    uint32_t ui32Window = (uint32_t)psPolicy->ui16TimeoutMs << (ui8RetryCnt < SCI_MASTER_BACKOFF_SHIFT_MAX ? ui8RetryCnt : SCI_MASTER_BACKOFF_SHIFT_MAX);
+
+    if (sSciMaster.GetTickMs == NULL || psPolicy->ui16TimeoutMs == 0 ||
+        (uint32_t)(sSciMaster.GetTickMs() - sSciMaster.ui32RequestTick) < ui32Window)
+        return;
+
+    sSciMaster.sStats.ui32Timeouts++;
+
+    // Drop a partially received frame
+    SCIDatalinkStartRx(&sSciMaster.sDatalink);
+    _SCIMasterDropPipelined();
+
+    // Upstream: Chunks have been lost, the link is quiet again -> Continue with the first missing byte
+    if (ui8RetryCnt < psPolicy->ui8MaxRetries && psInfo->sReq.eReqType == eREQUEST_TYPE_UPSTREAM)
+    {
+        sSciMaster.sStats.ui32Retries++;
+
+        sSciMaster.eProtocolState = ePROTOCOL_IDLE;
+        SCITransferRestartUpstream(&sSciMaster.sSCITransfer);
+        sSciMaster.ui8RetryCnt = ui8RetryCnt + 1;
+        return;
+    }
+
+    // Continuations are not repeated, the slave has already moved on to the next message
+    if (ui8RetryCnt < psPolicy->ui8MaxRetries && psInfo->ui32TransferCnt == 0 && psInfo->sReq.eReqType != eREQUEST_TYPE_UPSTREAM)
+    {
+        sSciMaster.eProtocolState = ePROTOCOL_IDLE;
+        if (SCIInitiateRequest(psInfo->sReq))
+        {
+            sSciMaster.sStats.ui32Retries++;
+            sSciMaster.ui8RetryCnt = ui8RetryCnt + 1;
+            return;
+        }
+        // The repetition could not be sent -> Failed
+    }
+
+    sSciMaster.sStats.ui32Failures++;
+
+    SCITransferAbort(&sSciMaster.sSCITransfer, &sRsp, eSCI_MASTER_ERROR_RESPONSE_TIMEOUT);
+
+    // Request type without callback handling
+    if (sSciMaster.eProtocolState == ePROTOCOL_RECEIVING)
+        SCIReleaseProtocol();
+
+    // Same completion handling as a response
+    if (sSciMaster.sQueue.bActive && sSciMaster.eProtocolState == ePROTOCOL_IDLE)
+    {
+        _SCIMasterFinishQueued(sRsp.eReqAck, sRsp.i16Num, 0, sRsp.sTransferData.ui16Error);
+        _SCIMasterStartQueued();
+    }
+}
+
+//=============================================================================
+static void _SCIMasterStartQueued (void)
+{
+    tsSCI_REQUEST_QUEUE *psQueue = &sSciMaster.sQueue;
+
+    while (!psQueue->bActive && psQueue->ui8Cnt > 0 && sSciMaster.eProtocolState == ePROTOCOL_IDLE)
+    {
+        tsSCI_QUEUED_REQUEST *psEntry = &psQueue->sEntries[psQueue->ui8Head];
+
+        if (SCITransferStart(&sSciMaster.sSCITransfer, psEntry->eReqType, psEntry->i16Num, psEntry->uValArr, psEntry->ui8ValArrLen) &&
+            sSciMaster.eProtocolState != ePROTOCOL_IDLE)
+            psQueue->bActive = true;
+        // The request could not be assembled
+        else
+            _SCIMasterFinishQueued(eREQUEST_ACK_STATUS_ERROR, psEntry->i16Num, 0, 0);
+    }
+}
+
+//=============================================================================
+static void _SCIMasterFinishQueued (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum)
+{
+    tsSCI_REQUEST_QUEUE *psQueue = &sSciMaster.sQueue;
+    MASTER_REQUEST_CB cbDone = psQueue->sEntries[psQueue->ui8Head].cbDone;
+    void *pCtx = psQueue->sEntries[psQueue->ui8Head].pCtx;
+
+    // Release the entry first, the callback may queue the next request
+    psQueue->ui8Head = (psQueue->ui8Head + 1) % SCI_MASTER_QUEUE_LENGTH;
+    psQueue->ui8Cnt--;
+    psQueue->bActive = false;
+
+    if (cbDone != NULL)
+        cbDone(pCtx, eAck, i16Num, ui32Value, ui16ErrNum);
+}
+
+#ifdef SCI_MASTER_MIRROR_SIZE
+//=============================================================================
+static tsSCI_MIRROR_ENTRY* _SCIMasterMirrorFind (int16_t i16Num, bool bAllocate)
+{
+    tsSCI_MIRROR_ENTRY *psFree = NULL;
+    uint32_t ui32Now = sSciMaster.GetTickMs != NULL ? sSciMaster.GetTickMs() : 0;
+
+    for (uint8_t i = 0; i < SCI_MASTER_MIRROR_SIZE; i++)
+    {
+        tsSCI_MIRROR_ENTRY *psEntry = &sMirror.sEntries[i];
+
+        if (!psEntry->bValid && !psEntry->bPending)
+        {
+            if (psFree == NULL || psFree->bValid)
+                psFree = psEntry;
+        }
+        else if (psEntry->i16Num == i16Num)
+            return psEntry;
+        // Replace the oldest value if the mirror is full
+        else if (!psEntry->bPending && (psFree == NULL ||
+                 (psFree->bValid && ui32Now - psEntry->ui32Tick > ui32Now - psFree->ui32Tick)))
+            psFree = psEntry;
+    }
+
+    if (!bAllocate || psFree == NULL)
+        return NULL;
+
+    psFree->i16Num = i16Num;
+    psFree->bValid = false;
+    return psFree;
+}
+
+//=============================================================================
+static void _SCIMasterMirrorUpdate (tsRESPONSE *psRsp)
+{
+    tsREQUEST *psReq = &sSciMaster.sSCITransfer.sTransferInfo.sReq;
+    tsSCI_MIRROR_ENTRY *psEntry = _SCIMasterMirrorFind(psRsp->i16Num, false);
+
+    if (psEntry == NULL)
+        return;
+
+    switch (psRsp->eReqType)
+    {
+        // Scalar GETVAR (array reads pass the elements)
+        case eREQUEST_TYPE_GETVAR:
+            if (psReq->ui8ValArrLen > 0)
+                return;
+            psEntry->bValid = psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS;
+            psEntry->ui32Value = psRsp->sTransferData.puRespVals[0].ui32_hex;
+            break;
+
+        // The slave converts the value to the datatype of the variable (unknown to the master):
+        // The requested value may differ from the stored one, the next read transfers it
+        case eREQUEST_TYPE_SETVAR:
+            psEntry->bValid = false;
+            return;
+
+        case eREQUEST_TYPE_NOTIFY:
+            psEntry->bValid = true;
+            psEntry->ui32Value = psRsp->sTransferData.puRespVals[0].ui32_hex;
+            break;
+
+        default:
+            return;
+    }
+
+    if (sSciMaster.GetTickMs != NULL)
+        psEntry->ui32Tick = sSciMaster.GetTickMs();
+}
+
+//=============================================================================
+static void _SCIMasterMirrorDone (void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum)
+{
+    tsSCI_MIRROR_ENTRY *psEntry = (tsSCI_MIRROR_ENTRY*)pCtx;
+    tsSCI_MIRROR_WAITER sDone[SCI_MASTER_MIRROR_WAITERS];
+    uint8_t ui8DoneCnt = 0;
+
+    // Timeouts and errors leave no value behind
+    psEntry->bPending = false;
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS)
+        psEntry->bValid = false;
+
+    // Release the waiters first, the callbacks may read again
+    for (uint8_t i = 0; i < SCI_MASTER_MIRROR_WAITERS; i++)
+    {
+        if (sMirror.sWaiters[i].psEntry == psEntry)
+        {
+            sDone[ui8DoneCnt++] = sMirror.sWaiters[i];
+            sMirror.sWaiters[i].psEntry = NULL;
+        }
+    }
+
+    for (uint8_t i = 0; i < ui8DoneCnt; i++)
+    {
+        if (sDone[i].cbDone != NULL)
+            sDone[i].cbDone(sDone[i].pCtx, eAck, i16Num, ui32Value, ui16ErrNum);
+    }
+}
+#endif
+
+#ifdef SCI_MASTER_POLL_SIZE
+//=============================================================================
+static void _SCIMasterPollService (void)
+{
+    tuREQUESTVALUE uVarList[SCI_MASTER_POLL_BATCH];
+    uint8_t ui8ValCnt;
+    uint32_t ui32Now;
+
+    if (sPoll.ui8BatchCnt > 0 || sSciMaster.GetTickMs == NULL || sSciMaster.sQueue.ui8Cnt >= SCI_MASTER_QUEUE_LENGTH)
+        return;
+
+    ui32Now = sSciMaster.GetTickMs();
+
+    // Due variables, the most overdue first
+    while (sPoll.ui8BatchCnt < SCI_MASTER_POLL_BATCH)
+    {
+        int8_t i8Next = -1;
+
+        for (uint8_t i = 0; i < SCI_MASTER_POLL_SIZE; i++)
+        {
+            tsSCI_POLL_ENTRY *psEntry = &sPoll.sEntries[i];
+
+            if (psEntry->ui16PeriodMs == 0 || psEntry->bInFlight || (int32_t)(ui32Now - psEntry->ui32ReleaseTick) < 0)
+                continue;
+            if (i8Next < 0 || (int32_t)(psEntry->ui32ReleaseTick - sPoll.sEntries[i8Next].ui32ReleaseTick) < 0)
+                i8Next = (int8_t)i;
+        }
+
+        if (i8Next < 0)
+            break;
+
+        sPoll.sEntries[i8Next].bInFlight = true;
+        sPoll.ui8Batch[sPoll.ui8BatchCnt] = (uint8_t)i8Next;
+        #ifdef VALUE_MODE_HEX
+        uVarList[sPoll.ui8BatchCnt].ui32_hex = sPoll.ui8BatchCnt > 0 ? (uint32_t)sPoll.sEntries[i8Next].i16Num : SCI_VAR_LIST_MARKER;
+        #else
+        uVarList[sPoll.ui8BatchCnt].f_float = sPoll.ui8BatchCnt > 0 ? (float)sPoll.sEntries[i8Next].i16Num : (float)SCI_VAR_LIST_MARKER;
+        #endif
+        sPoll.ui8BatchCnt++;
+    }
+
+    if (sPoll.ui8BatchCnt == 0)
+        return;
+
+    // A single variable is a plain GETVAR, a list starts with the marker
+    ui8ValCnt = sPoll.ui8BatchCnt > 1 ? sPoll.ui8BatchCnt : 0;
+
+    // Pending before queueing, a request that can't be started completes right away
+    sPoll.ui8ValueCnt = 0;
+    sPoll.ui32Failed = 0;
+    sSciMaster.sStats.ui32PollFrames++;
+    if (SCIQueueRequest(eREQUEST_TYPE_GETVAR, sPoll.sEntries[sPoll.ui8Batch[0]].i16Num, uVarList, ui8ValCnt, _SCIMasterPollDone, NULL))
+        return;
+
+    sSciMaster.sStats.ui32PollFrames--;
+    for (uint8_t i = 0; i < sPoll.ui8BatchCnt; i++)
+        sPoll.sEntries[sPoll.ui8Batch[i]].bInFlight = false;
+    sPoll.ui8BatchCnt = 0;
+}
+
+//=============================================================================
+static void _SCIMasterPollCollect (tsRESPONSE *psRsp)
+{
+    tsSCI_REQUEST_QUEUE *psQueue = &sSciMaster.sQueue;
+    tuRESPONSEVALUE *puVals = psRsp->sTransferData.puRespVals;
+    uint8_t ui8Cnt;
+
+    if (sPoll.ui8BatchCnt == 0 || !psQueue->bActive || psQueue->sEntries[psQueue->ui8Head].cbDone != _SCIMasterPollDone ||
+        psRsp->eReqType != eREQUEST_TYPE_GETVAR)
+        return;
+
+    // Single variable: Scalar response, variable list: Status word and all values in one DAT message
+    if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS)
+        ui8Cnt = 1;
+    else if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA && sSciMaster.sSCITransfer.sTransferInfo.ui8MessageDataCnt > 0)
+    {
+        sPoll.ui32Failed = puVals[0].ui32_hex;
+        ui8Cnt = sSciMaster.sSCITransfer.sTransferInfo.ui8MessageDataCnt - 1;
+        puVals++;
+    }
+    else
+        return;
+
+    for (uint8_t i = 0; i < ui8Cnt && sPoll.ui8ValueCnt < sPoll.ui8BatchCnt; i++)
+        sPoll.ui32Values[sPoll.ui8ValueCnt++] = puVals[i].ui32_hex;
+}
+
+//=============================================================================
+static void _SCIMasterPollDone (void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum)
+{
+    uint8_t ui8Batch[SCI_MASTER_POLL_BATCH];
+    uint32_t ui32Values[SCI_MASTER_POLL_BATCH];
+    uint8_t ui8BatchCnt = sPoll.ui8BatchCnt;
+    uint32_t ui32Failed = sPoll.ui32Failed;
+    bool bComplete = (eAck == eREQUEST_ACK_STATUS_SUCCESS || eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA) && sPoll.ui8ValueCnt == ui8BatchCnt;
+    uint32_t ui32Now = sSciMaster.GetTickMs();
+
+    (void)pCtx;
+    (void)i16Num;
+    (void)ui32Value;
+
+    // Release the request first, the callbacks may change the registrations
+    memcpy(ui8Batch, sPoll.ui8Batch, sizeof(ui8Batch));
+    memcpy(ui32Values, sPoll.ui32Values, sizeof(ui32Values));
+    sPoll.ui8BatchCnt = 0;
+
+    for (uint8_t i = 0; i < ui8BatchCnt; i++)
+    {
+        tsSCI_POLL_ENTRY *psEntry = &sPoll.sEntries[ui8Batch[i]];
+        uint32_t ui32Late = ui32Now - psEntry->ui32ReleaseTick;
+        uint32_t ui32Skipped;
+        // Failed variables of a list carry the slave error number instead of the value
+        bool bSuccess = bComplete && (ui32Failed & (1UL << i)) == 0;
+
+        // Unregistered while the request was pending
+        if (!psEntry->bInFlight)
+            continue;
+
+        psEntry->bInFlight = false;
+
+        // A failed list is blamed on the requested variable, the listed ones are polled again right away
+        if (!bComplete && i > 0)
+            continue;
+
+        // Releases that passed while waiting for the value have been missed
+        ui32Skipped = ui32Late / psEntry->ui16PeriodMs;
+        psEntry->sStats.ui32Missed += ui32Skipped;
+        psEntry->ui32ReleaseTick += (ui32Skipped + 1) * psEntry->ui16PeriodMs;
+
+        if (bSuccess)
+        {
+            uint16_t ui16Late = ui32Late > UINT16_MAX ? UINT16_MAX : (uint16_t)ui32Late;
+
+            if (psEntry->sStats.ui32Polls == 0 || ui16Late < psEntry->sStats.ui16MinLatencyMs)
+                psEntry->sStats.ui16MinLatencyMs = ui16Late;
+            if (ui16Late > psEntry->sStats.ui16MaxLatencyMs)
+                psEntry->sStats.ui16MaxLatencyMs = ui16Late;
+
+            // Jitter: change of the delay against the previous poll
+            if (psEntry->sStats.ui32Polls > 0)
+            {
+                uint16_t ui16Jitter = ui16Late > psEntry->sStats.ui16LastLatencyMs ?
+                    ui16Late - psEntry->sStats.ui16LastLatencyMs : psEntry->sStats.ui16LastLatencyMs - ui16Late;
+
+                psEntry->sStats.ui32JitterSumMs += ui16Jitter;
+                if (ui16Jitter > psEntry->sStats.ui16MaxJitterMs)
+                    psEntry->sStats.ui16MaxJitterMs = ui16Jitter;
+            }
+
+            psEntry->sStats.ui16LastLatencyMs = ui16Late;
+            psEntry->sStats.ui32Polls++;
+            psEntry->sStats.ui32LatencySumMs += ui32Late;
+        }
+        else
+            psEntry->sStats.ui32Errors++;
+
+        if (psEntry->cbValue != NULL && bSuccess)
+            psEntry->cbValue(psEntry->pCtx, eREQUEST_ACK_STATUS_SUCCESS, psEntry->i16Num, ui32Values[i], 0);
+        else if (psEntry->cbValue != NULL && bComplete)
+            psEntry->cbValue(psEntry->pCtx, eREQUEST_ACK_STATUS_ERROR, psEntry->i16Num, 0, (uint16_t)ui32Values[i]);
+        // Incomplete responses are reported as errors
+        else if (psEntry->cbValue != NULL)
+            psEntry->cbValue(psEntry->pCtx, eREQUEST_ACK_STATUS_ERROR, psEntry->i16Num, 0, ui16ErrNum);
+    }
+}
+#endif
+
+#ifdef SCI_MASTER_UPSTREAM_PIPELINE
+//=============================================================================
+static void _SCIMasterPipelineUpstream (void)
+{
+    tsTRANSFER_INFO *psInfo = &sSciMaster.sSCITransfer.sTransferInfo;
+    uint8_t ui8Size = 0;
+
+    // Request the next chunk as soon as the slave sends the current one (the size of the 
+    // last chunk tells whether the current one is the last, a resumed upstream has no last chunk)
+    if (!sSciMaster.bPipelined && psInfo->sReq.eReqType == eREQUEST_TYPE_UPSTREAM &&
+        sSciMaster.sDatalink.rState == eDATALINK_RSTATE_BUSY && sSciMaster.sDatalink.tState == eDATALINK_TSTATE_IDLE &&
+        psInfo->ui32ReceivedDataCnt > 0 && psInfo->ui8MessageDataCnt > 0 &&
+        psInfo->ui32ReceivedDataCnt + psInfo->ui8MessageDataCnt < psInfo->ui32ExpectedDataCnt)
+    {
+        flushBuf(&sSciMaster.sTxFIFO);
+
+        // The next chunk starts behind the current one
+        psInfo->uStreamArgs[0].ui32_hex = 0;
+        psInfo->uStreamArgs[1].ui32_hex = psInfo->ui32ReceivedDataCnt + psInfo->ui8MessageDataCnt;
+
+        if (SCIMasterRequestBuilder(sSciMaster.sTxFIFO.pui8_bufPtr, &ui8Size, psInfo->sReq) == eSCI_MASTER_ERROR_NONE)
+        {
+            increaseBufIdx(&sSciMaster.sTxFIFO, ui8Size);
+            sSciMaster.bPipelined = SCIDatalinkTransmit(&sSciMaster.sDatalink, &sSciMaster.sTxFIFO);
+        }
+    }
+
+    if (sSciMaster.bPipelined && sSciMaster.sDatalink.tState != eDATALINK_TSTATE_READY)
+        SCIDatalinkTransmitStateMachine(&sSciMaster.sDatalink);
+}
+#endif
+
+//=============================================================================
+static void _SCIMasterDropPipelined (void)
+{
+    if (!sSciMaster.bPipelined)
+        return;
+
+    // The frame is completed in the background, its response is dropped as stale
+    sSciMaster.bPipelined = false;
+    sSciMaster.bUnanswered = true;
+}
+
+//=============================================================================
+static bool _SCIMasterTransmitRequest (tsREQUEST sReq)
+{
+    uint8_t ui8Size = 0;
+
+    // Prepare transmission buffer
+    flushBuf(&sSciMaster.sTxFIFO);
+
+    // Assemble message
+    if (SCIMasterRequestBuilder(sSciMaster.sTxFIFO.pui8_bufPtr, &ui8Size, sReq) != eSCI_MASTER_ERROR_NONE)
+        return false;
+
+    increaseBufIdx(&sSciMaster.sTxFIFO, ui8Size);
+
+    SCIDatalinkTransmit(&sSciMaster.sDatalink, &sSciMaster.sTxFIFO);
+
+    sSciMaster.eProtocolState = ePROTOCOL_SENDING;
+    return true;
+}
+
+//=============================================================================
+static bool _SCIMasterBackoff (uint8_t ui8Attempt)
+{
+    tsSCI_RETRY_POLICY *psPolicy = &sSciMaster.sRetryPolicy[sSciMaster.sSCITransfer.sTransferInfo.sReq.eReqType];
+
+    if (ui8Attempt > psPolicy->ui8MaxRetries)
+        return false;
+
+    // Without a clock the request is repeated right away
+    if (sSciMaster.GetTickMs == NULL)
+        return true;
+
+    // The response window of the policy, doubled per attempt
+    sSciMaster.bHold = true;
+    sSciMaster.ui32HoldTick = sSciMaster.GetTickMs() + ((uint32_t)psPolicy->ui16TimeoutMs << (ui8Attempt - 1 < SCI_MASTER_BACKOFF_SHIFT_MAX ? ui8Attempt - 1 : SCI_MASTER_BACKOFF_SHIFT_MAX));
+    sSciMaster.sStats.ui32Retries++;
+    return true;
+}
+
@@ -26,13 +26,17 @@
  * Global variable definition
  *****************************************************************************/
 // Note: The idizes correspond to the values of the C enum values!
-static const char cAcknowledgeArr [5][4] = {"ACK", "DAT", "UPS", "ERR", "NAK"};
-static const uint8_t ui8CmdIdArr[6] = { UNKNOWN_IDENTIFIER, 
+static const char cAcknowledgeArr [6][4] = {"ACK", "DAT", "UPS", "ERR", "NAK", "PND"};
+static const uint8_t ui8CmdIdArr[10] = { UNKNOWN_IDENTIFIER, 
                                         GETVAR_IDENTIFIER,
                                         SETVAR_IDENTIFIER,
                                         COMMAND_IDENTIFIER,
                                         UPSTREAM_IDENTIFIER,
-                                        DOWNSTREAM_IDENTIFIER};
+                                        DOWNSTREAM_IDENTIFIER,
+                                        NOTIFY_IDENTIFIER,
+                                        DELTA_IDENTIFIER,
+                                        MEMORY_IDENTIFIER,
+                                        COMPLETE_IDENTIFIER};
 
 /******************************************************************************
  * Function declarations
@@ -94,6 +98,23 @@ teSCI_MASTER_ERROR SCIMasterRequestBuilder(uint8_t *pui8Buf, uint8_t *pui8Size,
 
     }
 
+    // DOWNSTREAM chunk: The binary data follows as hex digit pairs
+    if (sReq.pui8Data != NULL)
+    {
+        if ((*pui8Size + 1 + 2 * sReq.ui8DataLen) >= TX_PACKET_LENGTH)
+            return eSCI_MASTER_ERROR_MESSAGE_EXCEEDS_TX_BUFFER_SIZE;
+
+        *pui8Buf++ = ';';
+        (*pui8Size)++;
+
+        for (uint8_t i = 0; i < sReq.ui8DataLen; i++)
+        {
+            hexToStrByte(pui8Buf, (uint8_t*)&sReq.pui8Data[i], false);
+            pui8Buf += 2;
+            (*pui8Size) += 2;
+        }
+    }
+
     return eSCI_MASTER_ERROR_NONE;
 }
 
@@ -104,7 +125,9 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
     bool bAckPresent = false;
     int8_t i8Ack;
     int16_t i16BytesToGo = (int16_t)ui8DataframeLen;
+    uint8_t ui8Str[RX_PACKET_LENGTH + 1];   // Conversion string (no heap in the receive path)
     psRsp->sTransferData.pui8UpStreamBuf = pui8Buf;
+    *pui8MsgDataLen = 0;
     
     // uint8_t cmdIdx  = 0;
     // COMMAND cmd     = COMMAND_DEFAULT;
@@ -136,7 +159,27 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
         {
             psRsp->eReqType = eREQUEST_TYPE_DOWNSTREAM;
             break;
-        }      
+        }
+        else if (pui8Buf[i] == NOTIFY_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_NOTIFY;
+            break;
+        }
+        else if (pui8Buf[i] == DELTA_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_DELTA;
+            break;
+        }
+        else if (pui8Buf[i] == MEMORY_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_MEMORY;
+            break;
+        }
+        else if (pui8Buf[i] == COMPLETE_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_COMPLETE;
+            break;
+        }
     }
 
     // No valid command identifier found (TODO: Error handling)
@@ -151,7 +194,7 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
     {
         uint32_t ui32_tmp;
         // One additional character necessary for string termination
-        uint8_t *pui8NumStr = (uint8_t*)malloc(i+1);
+        uint8_t *pui8NumStr = ui8Str;
 
         // copy the number string into new array
         memcpy(pui8NumStr,pui8Buf,i);
@@ -165,14 +208,39 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
         #else
         psRsp->i16Num = (int16_t)(atoi((char*)pui8NumStr));
         #endif
-
-        free(pui8NumStr);
     }
 
     // let i correspond to the position of the char after the ID
     i++;
     i16BytesToGo -= i;
 
+    /*******************************************************************************************
+     * Notification (no acknowledge, exactly one value)
+    *******************************************************************************************/
+    if (psRsp->eReqType == eREQUEST_TYPE_NOTIFY)
+    {
+        uint8_t *pui8ValStr;
+
+        if (i16BytesToGo <= 0)
+            return eSCI_MASTER_ERROR_NOTIFICATION_MALFORMED;
+
+        pui8ValStr = ui8Str;
+        memcpy(pui8ValStr, &pui8Buf[i], i16BytesToGo);
+        pui8ValStr[i16BytesToGo] = '\0';
+
+        #ifdef VALUE_MODE_HEX
+        if(!strToHex(pui8ValStr, &psRsp->sTransferData.puRespVals[0].ui32_hex))
+        {
+            return eSCI_MASTER_ERROR_PARAMETER_CONVERSION_FAILED;
+        }
+        #else
+        psRsp->sTransferData.puRespVals[0].f_float = atof((char*)pui8ValStr);
+        #endif
+
+        psRsp->eReqAck = eREQUEST_ACK_STATUS_SUCCESS;
+        return eSCI_MASTER_ERROR_NONE;
+    }
+
     /*******************************************************************************************
      * Find the command acknowledge
     *******************************************************************************************/
@@ -207,7 +275,7 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
             j++;
         }
 
-        pui8NumStr = (uint8_t*)malloc(j+1);
+        pui8NumStr = ui8Str;
         memcpy(pui8NumStr,&pui8Buf[i],j);
         pui8NumStr[j] = '\0';
 
@@ -218,11 +286,18 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
             uNum.f_float = atof((char*)pui8NumStr);
         #endif
 
-        free(pui8NumStr);
-
         // Assign the number to the data field
         
-        switch (psRsp->eReqAck)
+        // DELTA: The control number is the generation of the slave
+        if (psRsp->eReqType == eREQUEST_TYPE_DELTA && psRsp->eReqAck != eREQUEST_ACK_STATUS_ERROR)
+        {
+            #ifdef VALUE_MODE_HEX
+            psRsp->sTransferData.ui32Generation = uNum.ui32_hex;
+            #else
+            psRsp->sTransferData.ui32Generation = uNum.f_float;
+            #endif
+        }
+        else switch (psRsp->eReqAck)
         {
             case eREQUEST_ACK_STATUS_SUCCESS_DATA:
             case eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM:
@@ -242,8 +317,8 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
                 break;
 
             default:
-                // Save GetVar result
-                if (psRsp->eReqType == eREQUEST_TYPE_GETVAR)
+                // Save GetVar result (DOWNSTREAM: The next offset the slave expects)
+                if (psRsp->eReqType == eREQUEST_TYPE_GETVAR || psRsp->eReqType == eREQUEST_TYPE_DOWNSTREAM)
                 {
                     psRsp->sTransferData.puRespVals[0] = uNum;
                 }
@@ -258,7 +333,7 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
     }
     // If we get into this else, that means we are dealing with a consecutive Command Data message,
     // which has no acknowledge, only data
-    else
+    else if (psRsp->eReqType != eREQUEST_TYPE_DELTA)
     {
         // We need to set this field here. Otherwise, the SCITransferControl function does not
         // know what to do with this message
@@ -290,7 +365,7 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
                 ui8_valueLen++;
             }
 
-            p_valStr = (uint8_t*)malloc(ui8_valueLen + 1);
+            p_valStr = ui8Str;
 
             // copy the number string into new array
             memcpy(p_valStr, &pui8Buf[i + j - ui8_valueLen], ui8_valueLen);
@@ -304,8 +379,6 @@ teSCI_MASTER_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8Datafram
             psRsp->sTransferData.puRespVals[ui8_numOfVals - 1].f_float = atof((char*)p_valStr);
             #endif
 
-            free(p_valStr);
-
             if (j == i16BytesToGo)
                 break;
             
@@ -344,13 +417,13 @@ int16_t _CheckAcknowledge (uint8_t *pui8Buf, uint8_t i16BytesToGo)
 
     cAck[3]='\0';
 
-    for ( ;j < 5; j++)
+    for ( ;j < 6; j++)
     {
         if (!strcmp(cAcknowledgeArr[j], cAck))
             break;
     }
 
-    if (j < 5)
+    if (j < 6)
         return j;
     else
         return REQUEST_ACKNOWLEDGE_NOT_FOUND;
@@ -25,113 +25,204 @@
 
 #include "SCIMasterTransfer.h"
 
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#ifdef SCI_MASTER_UPSTREAM_WINDOW
+#define UPSTREAM_WINDOW SCI_MASTER_UPSTREAM_WINDOW
+#else
+#define UPSTREAM_WINDOW 0       // One chunk per request
+#endif
+
 /******************************************************************************
  * Global variable definition
  *****************************************************************************/
 
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static bool _CollectTransferData(tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp, bool *pbComplete);
+static void _FinishTransferData(tsSCI_TRANSFER *psSciTransfer);
+static bool _StartUpstream(tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp);
+static bool _RequestUpstream(tsSCI_TRANSFER *psSciTransfer);
+#ifdef SCI_MASTER_UPSTREAM_WINDOW
+static void _ContinueUpstream(tsSCI_TRANSFER *psSciTransfer);
+#endif
+static void _AcknowledgeUpstream(tsSCI_TRANSFER *psSciTransfer, uint32_t ui32Offset, bool bFinal);
+static bool _RequestDownstreamChunk(tsSCI_TRANSFER *psSciTransfer, uint32_t ui32Offset, uint8_t ui8Len);
+static void _RepeatRequest(tsSCI_TRANSFER *psSciTransfer);
+static void *_PoolAlloc(tsSCI_TRANSFER_POOL *psPool, uint32_t ui32Size);
+static void _PoolRelease(tsSCI_TRANSFER_POOL *psPool, void *pBlock);
+
 /******************************************************************************
  * Function definitions
  *****************************************************************************/
 bool SCITransferStart (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16CmdNum, tuREQUESTVALUE *uVal, uint8_t ui8ArgNum)
 {
     tsREQUEST sReq = tsREQUEST_DEFAULTS;
+
+    if (ui8ArgNum > MAX_NUM_REQUEST_VALUES)
+        return false;
+
     // Take over the arguments
     sReq.eReqType       = eReqType;
     sReq.i16Num         = i16CmdNum;
     sReq.uValArr        = uVal;
     sReq.ui8ValArrLen   = ui8ArgNum;
 
+    // DELTA requests are continued with the generation of the last response
+    if (eReqType == eREQUEST_TYPE_DELTA && ui8ArgNum > 0)
+    {
+        psSciTransfer->sTransferInfo.uGeneration = uVal[0];
+        sReq.uValArr = &psSciTransfer->sTransferInfo.uGeneration;
+    }
+
     if(!psSciTransfer->sCallbacks.RequestCB(sReq))
         return false;
 
+    // The slave has dropped the upstream state
+    SCITransferDiscardUpstream(psSciTransfer);
+
+    // Keep a copy of the values, the request may have to be sent again
+    if (sReq.uValArr == uVal && ui8ArgNum > 0)
+    {
+        memcpy(psSciTransfer->sTransferInfo.uReqVals, uVal, ui8ArgNum * sizeof(tuREQUESTVALUE));
+        sReq.uValArr = psSciTransfer->sTransferInfo.uReqVals;
+    }
+    psSciTransfer->sTransferInfo.ui8ReqValCnt = ui8ArgNum;
     psSciTransfer->sTransferInfo.sReq = sReq;
+
+    return true;
 }
 
-bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
+//=============================================================================
+bool SCITransferStartDownstream (tsSCI_TRANSFER *psSciTransfer, int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Size, bool bResume)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+    tsREQUEST sReq = tsREQUEST_DEFAULTS;
+
+    if (pui8Data == NULL || ui32Size == 0)
+        return false;
+
+    psInfo->pui8DownstreamData = pui8Data;
+    psInfo->ui32DownstreamSize = ui32Size;
+    psInfo->ui8DownstreamRefusals = 0;
+    psInfo->uDownstreamArg.ui32_hex = bResume ? 0 : ui32Size;
+
+    sReq.eReqType       = eREQUEST_TYPE_DOWNSTREAM;
+    sReq.i16Num         = i16Num;
+    sReq.uValArr        = &psInfo->uDownstreamArg;
+    sReq.ui8ValArrLen   = 1;
+
+    // An empty chunk just returns the offset the slave expects next
+    if (bResume)
+        sReq.pui8Data = pui8Data;
+
+    if(!psSciTransfer->sCallbacks.RequestCB(sReq))
+        return false;
+
+    SCITransferDiscardUpstream(psSciTransfer);
+    psInfo->sReq = sReq;
+
+    return true;
+}
+
+//=============================================================================
+bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp)
 {
     teTRANSFER_ACK eTransferAck = eTRANSFER_ACK_ABORT;
     bool ret = true;
 
-    switch (sRsp.eReqType)
+    switch (psRsp->eReqType)
     {
         case eREQUEST_TYPE_SETVAR:
-            if (psSciTransfer->sCallbacks.GetVarCB != NULL)
+            if (psSciTransfer->sCallbacks.SetVarCB != NULL)
             {
-                eTransferAck = psSciTransfer->sCallbacks.SetVarCB(sRsp.eReqAck, sRsp.i16Num, sRsp.sTransferData.ui16Error);
+                eTransferAck = psSciTransfer->sCallbacks.SetVarCB(psRsp->eReqAck, psRsp->i16Num, psRsp->sTransferData.ui16Error);
             }
 
             if (eTransferAck != eTRANSFER_ACK_REPEAT_REQUEST)
                 psSciTransfer->sCallbacks.ReleaseProtocolCB();
             else
-                ; // TODO: Repeat?
+                _RepeatRequest(psSciTransfer);
             break;
         
         case eREQUEST_TYPE_GETVAR:
+            // Arrays and 64 bit variables: Data is collected like COMMAND results
+            if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA || psSciTransfer->sTransferInfo.sReq.ui8ValArrLen > 0 ||
+                psSciTransfer->sTransferInfo.ui32TransferCnt > 0)
+            {
+                bool bComplete = true;
+
+                if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA && !_CollectTransferData(psSciTransfer, psRsp, &bComplete))
+                {
+                    SCITransferAbort(psSciTransfer, psRsp, eSCI_MASTER_ERROR_OUT_OF_TRANSFER_MEMORY);
+                    return false;
+                }
+
+                // Request the remaining words
+                if (!bComplete)
+                {
+                    psSciTransfer->sTransferInfo.sReq.ui8ValArrLen = 0;
+
+                    psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                    psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
+                    break;
+                }
+
+                if (psSciTransfer->sCallbacks.GetArrayCB != NULL)
+                {
+                    eTransferAck = psSciTransfer->sCallbacks.GetArrayCB(psRsp->eReqAck, psRsp->i16Num, 
+                        psSciTransfer->sTransferInfo.uTransferResults != NULL ? &psSciTransfer->sTransferInfo.uTransferResults[0].ui32_hex : NULL,
+                        psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, psRsp->sTransferData.ui16Error);
+                }
+
+                _FinishTransferData(psSciTransfer);
+                psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                break;
+            }
+
             if (psSciTransfer->sCallbacks.GetVarCB != NULL)
             {
-                eTransferAck = psSciTransfer->sCallbacks.GetVarCB(sRsp.eReqAck, sRsp.i16Num, sRsp.sTransferData.puRespVals[0].ui32_hex, sRsp.sTransferData.ui16Error);
+                eTransferAck = psSciTransfer->sCallbacks.GetVarCB(psRsp->eReqAck, psRsp->i16Num, psRsp->sTransferData.puRespVals[0].ui32_hex, psRsp->sTransferData.ui16Error);
             }
 
             if (eTransferAck != eTRANSFER_ACK_REPEAT_REQUEST)
                 psSciTransfer->sCallbacks.ReleaseProtocolCB();
             else
-                ; // TODO: Repeat?
+                _RepeatRequest(psSciTransfer);
 
             break;
 
         case eREQUEST_TYPE_COMMAND:
 
-            switch (sRsp.eReqAck)
+            switch (psRsp->eReqAck)
             {
                 case eREQUEST_ACK_STATUS_SUCCESS_DATA:
+                {
+                    bool bComplete;
 
-                    // Generate a transfer value buffer and copy data
-                    // In first message
-                    if (psSciTransfer->sTransferInfo.ui32TransferCnt == 0)
+                    if (!_CollectTransferData(psSciTransfer, psRsp, &bComplete))
                     {
-                        psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = sRsp.sTransferData.ui32DatLen;
-
-                        // Allocate the memory for the COMMAND results
-                        psSciTransfer->sTransferInfo.uTransferResults = malloc(psSciTransfer->sTransferInfo.ui32ExpectedDataCnt * sizeof(tuRESPONSEVALUE));
-
-                        // TODO: Handling of not enough memory ?!?
-                        if(psSciTransfer->sTransferInfo.uTransferResults == NULL)
-                            return false;
+                        SCITransferAbort(psSciTransfer, psRsp, eSCI_MASTER_ERROR_OUT_OF_TRANSFER_MEMORY);
+                        return false;
                     }
 
-                    // Copy buffer values into the transfer memory
-                    memcpy(&psSciTransfer->sTransferInfo.uTransferResults[psSciTransfer->sTransferInfo.ui32ReceivedDataCnt], 
-                            sRsp.sTransferData.puRespVals, 
-                            sRsp.sTransferData.ui32DatLen * sizeof(tuRESPONSEVALUE));
-
-                    psSciTransfer->sTransferInfo.ui32ReceivedDataCnt += psSciTransfer->sTransferInfo.ui8MessageDataCnt;
-
-                    // Increment number of COMMAND transfers
-                    psSciTransfer->sTransferInfo.ui32TransferCnt++;
-
                     // All command transfers ready
-                    if (psSciTransfer->sTransferInfo.ui32ExpectedDataCnt == 
-                        psSciTransfer->sTransferInfo.ui32ReceivedDataCnt)
+                    if (bComplete)
                     {
                         // Callback invocation
                         if (psSciTransfer->sCallbacks.CommandCB != NULL)
                         {
-                            eTransferAck = psSciTransfer->sCallbacks.CommandCB(sRsp.eReqAck, sRsp.i16Num, &psSciTransfer->sTransferInfo.uTransferResults[0].ui32_hex, psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, sRsp.sTransferData.ui16Error);
+                            eTransferAck = psSciTransfer->sCallbacks.CommandCB(psRsp->eReqAck, psRsp->i16Num, &psSciTransfer->sTransferInfo.uTransferResults[0].ui32_hex, psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, psRsp->sTransferData.ui16Error);
                         }
 
-                        // Free data memory
-                        free(psSciTransfer->sTransferInfo.uTransferResults);
-
-                        // Reset the count variables
-                        psSciTransfer->sTransferInfo.ui32ReceivedDataCnt = 0;
-                        psSciTransfer->sTransferInfo.ui32TransferCnt = 0;
-                        psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = 0;
-                        psSciTransfer->sTransferInfo.ui8MessageDataCnt = 0;
+                        _FinishTransferData(psSciTransfer);
 
                         if (eTransferAck != eTRANSFER_ACK_REPEAT_REQUEST)
                             psSciTransfer->sCallbacks.ReleaseProtocolCB();
                         else
-                            ; // TODO: Repeat?
+                            _RepeatRequest(psSciTransfer);
                     }
                     // Invoke command again to get the remaining data
                     else
@@ -143,73 +234,84 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
                         psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
                     }
                     break;
+                }
 
                 // Upstream invocation
                 case eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM:
-                {
-                    tsREQUEST sUpstreamRequest = tsREQUEST_DEFAULTS;
-
-                    // Allocate memory for the upstream data
-                    psSciTransfer->sTransferInfo.pui8UpstreamBuffer = malloc(sRsp.sTransferData.ui32DatLen);
-
-                    // TODO: What to do if memory allocation failed?
-                    if (psSciTransfer->sTransferInfo.pui8UpstreamBuffer == NULL)
+                    if (!_StartUpstream(psSciTransfer, psRsp))
                         return false;
-
-                    psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = sRsp.sTransferData.ui32DatLen;
-
-                    // Switch the receive mode to stream
-                    psSciTransfer->sCallbacks.InitiateStreamCB(psSciTransfer->sTransferInfo.ui32ExpectedDataCnt);
-
-                    // Generate new upstream request message
-                    sUpstreamRequest.eReqType = eREQUEST_TYPE_UPSTREAM;
-                    sUpstreamRequest.i16Num = psSciTransfer->sTransferInfo.sReq.i16Num;
-
-                    // Initiate the upstream request
-                    psSciTransfer->sCallbacks.ReleaseProtocolCB();
-                    psSciTransfer->sCallbacks.RequestCB(sUpstreamRequest);
-
-                    psSciTransfer->sTransferInfo.sReq = sUpstreamRequest;
-
                     break;
-                }
 
                 // In case of a regular COMMAND without result values or an error
                 default:
                     if (psSciTransfer->sCallbacks.CommandCB != NULL)
                     {
-                        eTransferAck = psSciTransfer->sCallbacks.CommandCB(sRsp.eReqAck, sRsp.i16Num, NULL, 0, sRsp.sTransferData.ui16Error);
+                        eTransferAck = psSciTransfer->sCallbacks.CommandCB(psRsp->eReqAck, psRsp->i16Num, NULL, 0, psRsp->sTransferData.ui16Error);
                     }
-                    
-                    psSciTransfer->sCallbacks.ReleaseProtocolCB();
-                    break;
 
-            // TODO: Transfer handling depending on eTransferAck
+                    // Results collected before an error are dropped
+                    _FinishTransferData(psSciTransfer);
+
+                    if (eTransferAck != eTRANSFER_ACK_REPEAT_REQUEST)
+                        psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                    else
+                        _RepeatRequest(psSciTransfer);
+                    break;
             }
             break;
         
         case eREQUEST_TYPE_UPSTREAM:
 
+            eTransferAck = eTRANSFER_ACK_SUCCESS;
+
+            // Streaming: The frame is handed over straight from the receive buffer
+            if (psSciTransfer->sCallbacks.UpstreamChunkCB != NULL)
+            {
+                eTransferAck = psSciTransfer->sCallbacks.UpstreamChunkCB(psSciTransfer->sTransferInfo.sReq.i16Num, 
+                                    psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, psRsp->sTransferData.pui8UpStreamBuf,
+                                    psSciTransfer->sTransferInfo.ui8MessageDataCnt);
+            }
             // Copy transfer data from receive buffer into upstream memory
-            memcpy(&psSciTransfer->sTransferInfo.pui8UpstreamBuffer[psSciTransfer->sTransferInfo.ui32ReceivedDataCnt], 
-                    sRsp.sTransferData.pui8UpStreamBuf, psSciTransfer->sTransferInfo.ui8MessageDataCnt);
+            else
+            {
+                memcpy(&psSciTransfer->sTransferInfo.pui8UpstreamBuffer[psSciTransfer->sTransferInfo.ui32ReceivedDataCnt], 
+                        psRsp->sTransferData.pui8UpStreamBuf, psSciTransfer->sTransferInfo.ui8MessageDataCnt);
+            }
             
             psSciTransfer->sTransferInfo.ui32ReceivedDataCnt += psSciTransfer->sTransferInfo.ui8MessageDataCnt;
 
             // There is additional data to transfer
-            if (psSciTransfer->sTransferInfo.ui32ReceivedDataCnt < psSciTransfer->sTransferInfo.ui32ExpectedDataCnt)
+            if (psSciTransfer->sTransferInfo.ui32ReceivedDataCnt < psSciTransfer->sTransferInfo.ui32ExpectedDataCnt &&
+                eTransferAck != eTRANSFER_ACK_ABORT)
             {
                 // New request
-                psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
+                psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                #ifdef SCI_MASTER_UPSTREAM_WINDOW
+                _ContinueUpstream(psSciTransfer);
+                #else
+                _RequestUpstream(psSciTransfer);
+                #endif
             }
-            // All data arrived
+            // All data arrived (or the application aborted the stream)
             else
             {
                 // Switch back receive mode
                 psSciTransfer->sCallbacks.FinishStreamCB();
 
-                // Call the Upstream CB
-                if (psSciTransfer->sCallbacks.UpstreamCB != NULL)
+                // The slave keeps the data until everything is acknowledged (also stops an aborted stream)
+                _AcknowledgeUpstream(psSciTransfer, psSciTransfer->sTransferInfo.ui32ExpectedDataCnt, true);
+
+                // Call the Upstream CB (memory reads are reported by the memory CB)
+                if (psSciTransfer->sTransferInfo.eStreamReqType == eREQUEST_TYPE_MEMORY)
+                {
+                    if (psSciTransfer->sCallbacks.MemoryCB != NULL)
+                    {
+                        psSciTransfer->sCallbacks.MemoryCB(eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM, psSciTransfer->sTransferInfo.sReq.i16Num,
+                                                           psSciTransfer->sTransferInfo.pui8UpstreamBuffer,
+                                                           psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, 0);
+                    }
+                }
+                else if (psSciTransfer->sCallbacks.UpstreamCB != NULL)
                 {
                     psSciTransfer->sCallbacks.UpstreamCB(psSciTransfer->sTransferInfo.sReq.i16Num, 
                                                         psSciTransfer->sTransferInfo.pui8UpstreamBuffer,
@@ -221,11 +323,111 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
                 psSciTransfer->sTransferInfo.ui32TransferCnt = 0;
                 psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = 0;
 
-                // Free the formerly allocated memory
-                free(psSciTransfer->sTransferInfo.pui8UpstreamBuffer);
+                // Release the upstream memory
+                _PoolRelease(&psSciTransfer->sPool, psSciTransfer->sTransferInfo.pui8UpstreamBuffer);
+                psSciTransfer->sTransferInfo.pui8UpstreamBuffer = NULL;
+
+                psSciTransfer->sCallbacks.ReleaseProtocolCB();
+            }
+            break;
+
+        case eREQUEST_TYPE_DELTA:
+        {
+            uint32_t ui32Generation = psRsp->sTransferData.ui32Generation;
+            uint8_t ui8PairCnt = 0;
+
+            if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS || psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA)
+                ui8PairCnt = psSciTransfer->sTransferInfo.ui8MessageDataCnt / 2;
+
+            if (psSciTransfer->sCallbacks.DeltaCB != NULL)
+            {
+                eTransferAck = psSciTransfer->sCallbacks.DeltaCB(psRsp->eReqAck, ui32Generation, &psRsp->sTransferData.puRespVals[0].ui32_hex, ui8PairCnt, psRsp->sTransferData.ui16Error);
+            }
+            else
+                eTransferAck = eTRANSFER_ACK_SUCCESS;
+
+            psSciTransfer->sCallbacks.ReleaseProtocolCB();
+
+            // More modifications pending on the slave -> Continue with the new generation
+            if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA && eTransferAck != eTRANSFER_ACK_ABORT)
+            {
+                psSciTransfer->sTransferInfo.uGeneration.ui32_hex = ui32Generation;
+                psSciTransfer->sTransferInfo.sReq.uValArr = &psSciTransfer->sTransferInfo.uGeneration;
+                psSciTransfer->sTransferInfo.sReq.ui8ValArrLen = 1;
+                psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
+            }
+            break;
+        }
+
+        case eREQUEST_TYPE_MEMORY:
+            // Read data is transferred through the upstream path
+            if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM)
+            {
+                if (!_StartUpstream(psSciTransfer, psRsp))
+                    return false;
+                break;
+            }
+
+            // Write acknowledge or error
+            if (psSciTransfer->sCallbacks.MemoryCB != NULL)
+                psSciTransfer->sCallbacks.MemoryCB(psRsp->eReqAck, psRsp->i16Num, NULL, 0, psRsp->sTransferData.ui16Error);
+
+            psSciTransfer->sCallbacks.ReleaseProtocolCB();
+            break;
+
+        case eREQUEST_TYPE_DOWNSTREAM:
+        {
+            tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+            uint32_t ui32Offset = psRsp->sTransferData.puRespVals[0].ui32_hex;
+            uint32_t ui32Remaining;
+
+            // The sink did not take the chunk (busy) -> Repeat it after a delay, up to the retry limit
+            if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS && psInfo->sReq.ui8DataLen > 0 && ui32Offset == psInfo->uDownstreamArg.ui32_hex)
+            {
+                psInfo->ui8DownstreamRefusals++;
+                if (psSciTransfer->sCallbacks.BackoffCB != NULL && !psSciTransfer->sCallbacks.BackoffCB(psInfo->ui8DownstreamRefusals))
+                {
+                    psRsp->eReqAck = eREQUEST_ACK_STATUS_ERROR;
+                    psRsp->sTransferData.ui16Error = eSCI_MASTER_ERROR_DOWNSTREAM_REFUSED;
+                }
+            }
+            else
+                psInfo->ui8DownstreamRefusals = 0;
+
+            // Continue with the offset the slave expects next
+            if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS && psSciTransfer->sTransferInfo.pui8DownstreamData != NULL &&
+                ui32Offset < psSciTransfer->sTransferInfo.ui32DownstreamSize)
+            {
+                ui32Remaining = psSciTransfer->sTransferInfo.ui32DownstreamSize - ui32Offset;
 
                 psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                if (!_RequestDownstreamChunk(psSciTransfer, ui32Offset, 
+                        ui32Remaining < SCI_DOWNSTREAM_CHUNK_MAX_BYTES ? (uint8_t)ui32Remaining : SCI_DOWNSTREAM_CHUNK_MAX_BYTES))
+                    return false;
+                break;
             }
+
+            if (psSciTransfer->sCallbacks.DownstreamCB != NULL)
+            {
+                psSciTransfer->sCallbacks.DownstreamCB(psRsp->eReqAck, psRsp->i16Num, 
+                    psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS ? ui32Offset : 0, psRsp->sTransferData.ui16Error);
+            }
+
+            psSciTransfer->sTransferInfo.pui8DownstreamData = NULL;
+            psSciTransfer->sCallbacks.ReleaseProtocolCB();
+            break;
+        }
+
+        case eREQUEST_TYPE_NOTIFY:
+            // Unsolicited frame, the protocol state is not affected
+            if (psSciTransfer->sCallbacks.NotifyCB != NULL)
+                psSciTransfer->sCallbacks.NotifyCB(psRsp->i16Num, psRsp->sTransferData.puRespVals[0].ui32_hex);
+            break;
+
+        case eREQUEST_TYPE_COMPLETE:
+            // Unsolicited frame, the result is fetched by repeating the command
+            if (psSciTransfer->sCallbacks.CompleteCB != NULL)
+                psSciTransfer->sCallbacks.CompleteCB(psRsp->i16Num, psRsp->eReqAck);
             break;
         
         default:
@@ -235,3 +437,291 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
     return true;
 }
 
+//=============================================================================
+void SCITransferPoolReset (tsSCI_TRANSFER_POOL *psPool)
+{
+    psPool->ui8ReleasedCnt = 0;
+    psPool->ui8UnusedIdx = 0;
+}
+
+//=============================================================================
+void SCITransferAbort (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp, uint16_t ui16Error)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    psRsp->eReqType = psInfo->sReq.eReqType;
+    psRsp->i16Num = psInfo->sReq.i16Num;
+    psRsp->eReqAck = eREQUEST_ACK_STATUS_ERROR;
+    psRsp->sTransferData.ui16Error = ui16Error;
+
+    // Suspend the upstream, the error is reported to the request that initiated it
+    if (psInfo->sReq.eReqType == eREQUEST_TYPE_UPSTREAM)
+    {
+        tsSCI_UPSTREAM_RESUME *psResume = &psSciTransfer->sResume;
+
+        psSciTransfer->sCallbacks.FinishStreamCB();
+
+        psResume->i16Num            = psInfo->sReq.i16Num;
+        psResume->eStreamReqType    = psInfo->eStreamReqType;
+        psResume->pui8Buffer        = psInfo->pui8UpstreamBuffer;
+        psResume->ui32Offset        = psInfo->ui32ReceivedDataCnt;
+        psResume->ui32Size          = psInfo->ui32ExpectedDataCnt;
+        psResume->bValid            = true;
+
+        psInfo->pui8UpstreamBuffer = NULL;
+        psInfo->ui32ReceivedDataCnt = 0;
+        psInfo->ui32TransferCnt = 0;
+        psInfo->ui32ExpectedDataCnt = 0;
+
+        psRsp->eReqType = psInfo->eStreamReqType;
+        psInfo->sReq.eReqType = psInfo->eStreamReqType;
+    }
+
+    // Reported like an error response of the slave (the callback may repeat the request)
+    SCITransferControl(psSciTransfer, psRsp);
+}
+
+//=============================================================================
+static bool _CollectTransferData(tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp, bool *pbComplete)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+    uint32_t ui32Cnt = psInfo->ui8MessageDataCnt;
+
+    // Generate a transfer value buffer in the first message
+    if (psInfo->ui32TransferCnt == 0)
+    {
+        psInfo->ui32ExpectedDataCnt = psRsp->sTransferData.ui32DatLen;
+        psInfo->ui32ReceivedDataCnt = 0;
+
+        // Memory for the results
+        if (psInfo->ui32ExpectedDataCnt > UINT32_MAX / sizeof(tuRESPONSEVALUE))
+            return false;
+
+        psInfo->uTransferResults = _PoolAlloc(&psSciTransfer->sPool, psInfo->ui32ExpectedDataCnt * sizeof(tuRESPONSEVALUE));
+        if(psInfo->uTransferResults == NULL)
+            return false;
+    }
+
+    // Copy the values of this message (never more than announced)
+    if (ui32Cnt > psInfo->ui32ExpectedDataCnt - psInfo->ui32ReceivedDataCnt)
+        ui32Cnt = psInfo->ui32ExpectedDataCnt - psInfo->ui32ReceivedDataCnt;
+
+    memcpy(&psInfo->uTransferResults[psInfo->ui32ReceivedDataCnt], psRsp->sTransferData.puRespVals, ui32Cnt * sizeof(tuRESPONSEVALUE));
+
+    psInfo->ui32ReceivedDataCnt += ui32Cnt;
+    psInfo->ui32TransferCnt++;
+
+    *pbComplete = psInfo->ui32ReceivedDataCnt == psInfo->ui32ExpectedDataCnt;
+
+    return true;
+}
+
+//=============================================================================
+static void _FinishTransferData(tsSCI_TRANSFER *psSciTransfer)
+{
+    // Release data memory
+    _PoolRelease(&psSciTransfer->sPool, psSciTransfer->sTransferInfo.uTransferResults);
+    psSciTransfer->sTransferInfo.uTransferResults = NULL;
+
+    // Reset the count variables
+    psSciTransfer->sTransferInfo.ui32ReceivedDataCnt = 0;
+    psSciTransfer->sTransferInfo.ui32TransferCnt = 0;
+    psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = 0;
+    psSciTransfer->sTransferInfo.ui8MessageDataCnt = 0;
+}
+
+//=============================================================================
+static bool _StartUpstream(tsSCI_TRANSFER *psSciTransfer, tsRESPONSE *psRsp)
+{
+    tsREQUEST sUpstreamRequest = tsREQUEST_DEFAULTS;
+
+    // Memory for the upstream data (streamed upstreams are not buffered)
+    psSciTransfer->sTransferInfo.pui8UpstreamBuffer = NULL;
+    if (psSciTransfer->sCallbacks.UpstreamChunkCB == NULL)
+        psSciTransfer->sTransferInfo.pui8UpstreamBuffer = _PoolAlloc(&psSciTransfer->sPool, psRsp->sTransferData.ui32DatLen);
+
+    if (psSciTransfer->sCallbacks.UpstreamChunkCB == NULL && psSciTransfer->sTransferInfo.pui8UpstreamBuffer == NULL)
+    {
+        SCITransferAbort(psSciTransfer, psRsp, eSCI_MASTER_ERROR_OUT_OF_TRANSFER_MEMORY);
+        return false;
+    }
+
+    psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = psRsp->sTransferData.ui32DatLen;
+    psSciTransfer->sTransferInfo.eStreamReqType = psSciTransfer->sTransferInfo.sReq.eReqType;
+
+    // Switch the receive mode to stream
+    psSciTransfer->sCallbacks.InitiateStreamCB(psSciTransfer->sTransferInfo.ui32ExpectedDataCnt);
+
+    // Generate new upstream request message
+    sUpstreamRequest.eReqType = eREQUEST_TYPE_UPSTREAM;
+    sUpstreamRequest.i16Num = psSciTransfer->sTransferInfo.sReq.i16Num;
+
+    psSciTransfer->sTransferInfo.sReq = sUpstreamRequest;
+
+    // Initiate the upstream request
+    psSciTransfer->sCallbacks.ReleaseProtocolCB();
+    _RequestUpstream(psSciTransfer);
+
+    return true;
+}
+
+//=============================================================================
+bool SCITransferRestartUpstream (tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    // Bytes of a lost chunk must not be counted by the stream receiver
+    psSciTransfer->sCallbacks.InitiateStreamCB(psInfo->ui32ExpectedDataCnt - psInfo->ui32ReceivedDataCnt);
+
+    return _RequestUpstream(psSciTransfer);
+}
+
+//=============================================================================
+bool SCITransferResumeUpstream (tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+    tsSCI_UPSTREAM_RESUME *psResume = &psSciTransfer->sResume;
+    tsREQUEST sUpstreamRequest = tsREQUEST_DEFAULTS;
+
+    if (!psResume->bValid)
+        return false;
+
+    sUpstreamRequest.eReqType       = eREQUEST_TYPE_UPSTREAM;
+    sUpstreamRequest.i16Num         = psResume->i16Num;
+
+    psInfo->sReq                    = sUpstreamRequest;
+    psInfo->eStreamReqType          = psResume->eStreamReqType;
+    psInfo->pui8UpstreamBuffer      = psResume->pui8Buffer;
+    psInfo->ui32ReceivedDataCnt     = psResume->ui32Offset;
+    psInfo->ui32ExpectedDataCnt     = psResume->ui32Size;
+    psResume->bValid                = false;
+
+    if (SCITransferRestartUpstream(psSciTransfer))
+        return true;
+
+    // Protocol busy -> Keep the upstream suspended
+    psSciTransfer->sCallbacks.FinishStreamCB();
+    psResume->bValid = true;
+    psInfo->sReq.eReqType = psResume->eStreamReqType;
+    psInfo->pui8UpstreamBuffer = NULL;
+    psInfo->ui32ReceivedDataCnt = 0;
+    psInfo->ui32ExpectedDataCnt = 0;
+
+    return false;
+}
+
+//=============================================================================
+void SCITransferDiscardUpstream (tsSCI_TRANSFER *psSciTransfer)
+{
+    if (!psSciTransfer->sResume.bValid)
+        return;
+
+    _PoolRelease(&psSciTransfer->sPool, psSciTransfer->sResume.pui8Buffer);
+    psSciTransfer->sResume.pui8Buffer = NULL;
+    psSciTransfer->sResume.bValid = false;
+}
+
+//=============================================================================
+static bool _RequestUpstream(tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    // Window and the offset to (re)start from
+    psInfo->uStreamArgs[0].ui32_hex = UPSTREAM_WINDOW;
+    psInfo->uStreamArgs[1].ui32_hex = psInfo->ui32ReceivedDataCnt;
+    psInfo->ui32AckedDataCnt        = psInfo->ui32ReceivedDataCnt;
+    psInfo->sReq.uValArr            = psInfo->uStreamArgs;
+    psInfo->sReq.ui8ValArrLen       = 2;
+
+    return psSciTransfer->sCallbacks.RequestCB(psInfo->sReq);
+}
+
+#ifdef SCI_MASTER_UPSTREAM_WINDOW
+//=============================================================================
+static void _ContinueUpstream(tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+    uint32_t ui32AckDistance = (uint32_t)((SCI_MASTER_UPSTREAM_WINDOW + 1) / 2) * psInfo->ui8MessageDataCnt;
+
+    // Acknowledge every half window, the slave keeps sending meanwhile
+    if (psInfo->ui32ReceivedDataCnt - psInfo->ui32AckedDataCnt >= ui32AckDistance)
+        _AcknowledgeUpstream(psSciTransfer, psInfo->ui32ReceivedDataCnt, false);
+    else
+        psSciTransfer->sCallbacks.ContinueStreamCB();
+}
+#endif
+
+//=============================================================================
+static void _AcknowledgeUpstream(tsSCI_TRANSFER *psSciTransfer, uint32_t ui32Offset, bool bFinal)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    psInfo->uStreamArgs[0].ui32_hex = ui32Offset;
+    psInfo->ui32AckedDataCnt        = ui32Offset;
+    psInfo->sReq.uValArr            = psInfo->uStreamArgs;
+    psInfo->sReq.ui8ValArrLen       = 1;
+
+    // The final acknowledge is not answered, the next chunks answer the others
+    if (bFinal)
+        psSciTransfer->sCallbacks.UnansweredRequestCB(psInfo->sReq);
+    else
+        psSciTransfer->sCallbacks.RequestCB(psInfo->sReq);
+}
+
+//=============================================================================
+static bool _RequestDownstreamChunk(tsSCI_TRANSFER *psSciTransfer, uint32_t ui32Offset, uint8_t ui8Len)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    psInfo->uDownstreamArg.ui32_hex = ui32Offset;
+    psInfo->sReq.uValArr            = &psInfo->uDownstreamArg;
+    psInfo->sReq.ui8ValArrLen       = 1;
+    psInfo->sReq.pui8Data           = &psInfo->pui8DownstreamData[ui32Offset];
+    psInfo->sReq.ui8DataLen         = ui8Len;
+
+    return psSciTransfer->sCallbacks.RequestCB(psInfo->sReq);
+}
+
+//=============================================================================
+static void _RepeatRequest(tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    // Continuations don't pass the values of the initial request
+    psInfo->sReq.uValArr = psInfo->uReqVals;
+    psInfo->sReq.ui8ValArrLen = psInfo->ui8ReqValCnt;
+
+    psSciTransfer->sCallbacks.ReleaseProtocolCB();
+    psSciTransfer->sCallbacks.RequestCB(psInfo->sReq);
+}
+
+//=============================================================================
+static void *_PoolAlloc(tsSCI_TRANSFER_POOL *psPool, uint32_t ui32Size)
+{
+    // Destination buffer of the application
+    if (psPool->pDestination != NULL)
+        return ui32Size <= psPool->ui32DestinationSize ? psPool->pDestination : NULL;
+
+    if (ui32Size > SCI_MASTER_POOL_BLOCK_SIZE)
+        return NULL;
+
+    if (psPool->ui8ReleasedCnt > 0)
+        return psPool->ui32Blocks[psPool->ui8Released[--psPool->ui8ReleasedCnt]];
+
+    if (psPool->ui8UnusedIdx < SCI_MASTER_POOL_BLOCK_CNT)
+        return psPool->ui32Blocks[psPool->ui8UnusedIdx++];
+
+    return NULL;
+}
+
+//=============================================================================
+static void _PoolRelease(tsSCI_TRANSFER_POOL *psPool, void *pBlock)
+{
+    uintptr_t uOffset = (uintptr_t)pBlock - (uintptr_t)psPool->ui32Blocks;
+
+    // Destination buffers of the application aren't part of the pool
+    if (pBlock == NULL || (uintptr_t)pBlock < (uintptr_t)psPool->ui32Blocks || uOffset >= sizeof(psPool->ui32Blocks))
+        return;
+
+    psPool->ui8Released[psPool->ui8ReleasedCnt++] = (uint8_t)(uOffset / SCI_MASTER_POOL_BLOCK_SIZE);
+}
@@ -0,0 +1,120 @@
+/**************************************************************************//**
+ * \file SCIEEPROMJournal.h
+ * \author Roman Holderried
+ *
+ * \brief Wear leveling journal backend for EEPROM variables.
+ *
+ * The journal sits between the variable access and the EEPROM driver. Its read
+ * and write functions match READEEPROM_CB and WRITEEEPROM_CB, so they can be
+ * passed to SCISlaveInit instead of the driver functions.
+ *
+ * Every write appends a record (logical address, bank tag, value) to the active
+ * bank of the physical EEPROM instead of overwriting a fixed cell. When the
+ * bank is full, the current values are compacted into the other bank. At boot,
+ * the active bank is replayed with a single linear scan.
+ *
+ * Physical layout (32 bit units, each spanning 4 / EEPROM_ADDRESSTYPE addresses):
+ * - Bank header: Bank sequence number (0xFFFFFFFF = erased / invalid)
+ * - Records: Value unit, followed by the commit unit (logical address << 16 | bank tag)
+ *
+ * <b> History </b>
+ * 	- 2026-10-19 - File creation
+ *****************************************************************************/
+
+#ifndef _SCIEEPROMJOURNAL_H_
+#define _SCIEEPROMJOURNAL_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "SCIconfig.h"
+#include "SCICommon.h"
+#include "SCIVarAccess.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+// Number of logical EEPROM addresses (as assigned by the partition table)
+#ifndef EEPROM_JOURNAL_LOGICAL_SIZE
+#define EEPROM_JOURNAL_LOGICAL_SIZE ((MAX_NUMBER_OF_EEPROM_VARS * 4) / EEPROM_ADDRESSTYPE)
+#endif
+
+// Physical start address of the journal
+#ifndef EEPROM_JOURNAL_BASE_ADDRESS
+#define EEPROM_JOURNAL_BASE_ADDRESS 0
+#endif
+
+// Physical size of a single bank (in EEPROM addresses). Default: Room for two records per logical address
+#ifndef EEPROM_JOURNAL_BANK_SIZE
+#define EEPROM_JOURNAL_BANK_SIZE    ((4 + 16 * EEPROM_JOURNAL_LOGICAL_SIZE) / EEPROM_ADDRESSTYPE)
+#endif
+
+#define EEPROM_JOURNAL_UNIT_SIZE        (4 / EEPROM_ADDRESSTYPE)
+#define EEPROM_JOURNAL_RECORD_SIZE      (2 * EEPROM_JOURNAL_UNIT_SIZE)
+#define EEPROM_JOURNAL_RECORDS_PER_BANK ((EEPROM_JOURNAL_BANK_SIZE - EEPROM_JOURNAL_UNIT_SIZE) / EEPROM_JOURNAL_RECORD_SIZE)
+
+_Static_assert(EEPROM_JOURNAL_RECORDS_PER_BANK > EEPROM_JOURNAL_LOGICAL_SIZE,
+               "EEPROM journal bank must hold more records than there are logical addresses");
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Journal statistics (physical driver accesses).*/
+typedef struct
+{
+    uint32_t    ui32LogicalWrites;      /*!< Write calls of the variable access.*/
+    uint32_t    ui32PhysicalWrites;     /*!< Write calls of the EEPROM driver.*/
+    uint32_t    ui32PhysicalReads;      /*!< Read calls of the EEPROM driver.*/
+    uint32_t    ui32Compactions;        /*!< Number of bank changes.*/
+}tsEEPROM_JOURNAL_STATS;
+
+#define tsEEPROM_JOURNAL_STATS_DEFAULTS {0, 0, 0, 0}
+
+typedef struct
+{
+    READEEPROM_CB   cbReadEEPROM;       /*!< Physical EEPROM read driver.*/
+    WRITEEEPROM_CB  cbWriteEEPROM;      /*!< Physical EEPROM write driver.*/
+
+    uint32_t    ui32BankSeq;            /*!< Sequence number of the active bank.*/
+    uint8_t     ui8ActiveBank;          /*!< Active bank (0 or 1).*/
+    uint16_t    ui16NextRecord;         /*!< Index of the next free record in the active bank.*/
+
+    uint32_t    ui32Values[EEPROM_JOURNAL_LOGICAL_SIZE];    /*!< Current values of the logical addresses.*/
+
+    tsEEPROM_JOURNAL_STATS  sStats;
+}tsEEPROM_JOURNAL;
+
+#define tsEEPROM_JOURNAL_DEFAULTS {NULL, NULL, 0, 0, 0, {0}, tsEEPROM_JOURNAL_STATS_DEFAULTS}
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes the journal and replays the active bank.
+ *
+ * Must be called before SCISlaveInit, which reads the EEPROM variables through
+ * the journal. An unformatted EEPROM is formatted.
+ *
+ * @param cbRead    Physical EEPROM read driver
+ * @param cbWrite   Physical EEPROM write driver
+ * @returns Success indicator
+ */
+bool SCIEEPROMJournalInit(READEEPROM_CB cbRead, WRITEEEPROM_CB cbWrite);
+
+/** \brief Reads a logical EEPROM address (READEEPROM_CB).
+ *
+ * Served from RAM, never written addresses read as erased EEPROM.
+ */
+bool SCIEEPROMJournalRead(uint32_t *pui32Val, uint16_t ui16Address);
+
+/** \brief Writes a logical EEPROM address (WRITEEEPROM_CB).
+ *
+ * Appends a record. Writing the current value does not access the EEPROM.
+ */
+bool SCIEEPROMJournalWrite(uint32_t ui32Val, uint16_t ui16Address);
+
+/** \brief Returns the access statistics of the journal.*/
+tsEEPROM_JOURNAL_STATS SCIEEPROMJournalGetStats(void);
+
+#endif //_SCIEEPROMJOURNAL_H_
@@ -30,6 +30,7 @@ extern "C" {
 #include "SCISlaveTransfer.h"
 #include "SCIVariables.h"
 #include "SCIVarAccess.h"
+#include "SCISlaveNotify.h"
 #include "Buffer.h"
 #include "CommandStucture.h"
 #include "SCIDataLink.h"
@@ -62,6 +63,7 @@ typedef struct
     tsDATALINK              sDatalink;
     tsSCI_TRANSFER_SLAVE    sSciTransfer;   /*!< Commands variable structure. */
     tsVAR_ACCESS            sVarAccess;      /*!< Variable structure access. */
+    tsSCI_NOTIFY            sNotify;         /*!< Variable change notifications. */
 }tsSCI_SLAVE;
 
 #define tsSCI_SLAVE_DEFAULTS {  {SCI_VERSION_MAJOR, SCI_VERSION_MINOR, SCI_REVISION},\
@@ -71,7 +73,8 @@ typedef struct
                                 tsFIFO_BUF_DEFAULTS,\
                                 tsDATALINK_DEFAULTS,\
                                 tsSCI_TRANSFER_SLAVE_DEFAULTS,\
-                                tsVAR_ACCESS_DEFAULTS}
+                                tsVAR_ACCESS_DEFAULTS,\
+                                tsSCI_NOTIFY_DEFAULTS}
 
 typedef struct
 {
@@ -80,6 +83,12 @@ typedef struct
     BLOCKING_TX_CB cbTransmitBlocking;        /*!< Callback for the data transmission driver. Blocking. */
     NONBLOCKING_TX_CB cbTransmitNonBlocking;  /*!< Callback for the data transmission driver. Blocking. */
     GET_BUSY_STATE_CB cbGetTxBusyState;       /*!< Callback for polling the busy state of the transmitter. */
+    WRITEEEPROM_BLOCK_CB cbWriteEEPROMBlock;  /*!< Optional callback for writing multiple EEPROM words at once. */
+    READEEPROM_BLOCK_CB cbReadEEPROMBlock;    /*!< Optional callback for reading multiple EEPROM words at once. */
+    const tsSCI_MEM_WINDOW *pMemWindows;      /*!< Optional memory window whitelist (NULL: MEMORY requests are rejected). */
+    uint8_t ui8MemWindowCnt;                  /*!< Number of memory windows. */
+    DOWNSTREAM_CB cbDownstream;               /*!< Optional sink of DOWNSTREAM transfers (NULL: DOWNSTREAM requests are rejected). */
+    GET_TIME_US_CB cbGetTimeUs;               /*!< Optional microsecond clock bounding the command steps per state machine call. */
 }tsSCI_SLAVE_CALLBACKS;
 
 #define SCI_CALLBACKS_DEFAULT {NULL}
@@ -115,6 +124,72 @@ void SCISlaveReceiveData (uint8_t ui8Data);
  */
 teSCI_SLAVE_ERROR SCISlaveGetVarFromStruct(int16_t i16VarNum, tsSCIVAR* pVar);
 
+/** \brief Reports a variable modification by the application.
+ *
+ * Variables written through SETVAR are tracked automatically. Variables the
+ * application changes directly must be reported, so that DELTA requests of the
+ * master pick them up.
+ *
+ * @param i16VarNum    Variable number of the modified variable.
+ */
+teSCI_SLAVE_ERROR SCISlaveVarUpdated(int16_t i16VarNum);
+
+/** \brief Writes all dirty EEPROM variables (EEPROM_WRITE_BACK).
+ *
+ * Without EEPROM_WRITE_BACK, EEPROM variables are written synchronously and
+ * there is nothing to flush.
+ */
+teSCI_SLAVE_ERROR SCISlaveEEPROMFlush(void);
+
+/** \brief Returns the number of EEPROM variables waiting for the deferred write.*/
+uint8_t SCISlaveEEPROMGetDirtyCount(void);
+
+/** \brief Returns the number of failed deferred EEPROM writes (the variables stay dirty).*/
+uint32_t SCISlaveEEPROMGetFailCount(void);
+
+/** \brief Command callbacks exposing the EEPROM write-back to the master.
+ *
+ * Can be placed into the command structure of the application:
+ * - SCISlaveCmdEEPROMFlush writes all dirty EEPROM variables.
+ * - SCISlaveCmdEEPROMDirtyCount returns the number of dirty EEPROM variables.
+ */
+#ifdef VALUE_MODE_HEX
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMFlush(uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData);
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMDirtyCount(uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData);
+#else
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMFlush(float* pf_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData);
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMDirtyCount(float* pf_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData);
+#endif
+
+/** \brief Subscribe a variable for change notifications.
+ *
+ * Whenever the variable value moves by more than the deadband, an unsolicited
+ * frame is sent to the master in the idle time of the state machine.
+ *
+ * @param i16VarNum    Variable number of the desired variable.
+ * @param uDeadband    Deadband (f_float for eDTYPE_F32 variables, ui32_hex otherwise).
+ */
+teSCI_SLAVE_ERROR SCISlaveSubscribeVar(int16_t i16VarNum, tuREQUESTVALUE uDeadband);
+
+/** \brief Remove a variable subscription.
+ *
+ * @param i16VarNum    Variable number of the desired variable.
+ */
+void SCISlaveUnsubscribeVar(int16_t i16VarNum);
+
+/** \brief Completes a command whose callback returned eREQUEST_ACK_STATUS_PENDING.
+ *
+ * The completion is announced to the master with an unsolicited frame. The result
+ * is delivered when the master repeats the command (which returns PND until then).
+ *
+ * @param i16CmdNum    Number of the pending command.
+ * @param eAck         Final acknowledge (SUCCESS, SUCCESS_DATA or ERROR).
+ * @param puVals       Result values (SUCCESS_DATA only).
+ * @param ui8ValCnt    Number of result values (max. MAX_NUM_RESPONSE_VALUES).
+ * @param ui16Error    Error number (ERROR only).
+ */
+teSCI_SLAVE_ERROR SCISlaveCompleteCommand(int16_t i16CmdNum, teREQUEST_ACKNOWLEDGE eAck, const tuRESPONSEVALUE *puVals, uint8_t ui8ValCnt, uint16_t ui16Error);
+
 #ifdef __cplusplus
 }
 #endif
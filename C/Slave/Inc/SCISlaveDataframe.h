@@ -52,6 +52,24 @@ teSCI_SLAVE_ERROR SCISlaveRequestParser(uint8_t* pui8Buf, uint8_t ui8StringSize,
  */
 uint8_t SCISlaveResponseBuilder(uint8_t *pui8Buf, tsRESPONSECONTROL *psResponseControl);
 
+/** \brief Builds an unsolicited notification string.
+ *
+ * @param *pui8Buf  Pointer to the buffer where the string is going to be stored.
+ * @param i16Num    Number of the changed variable.
+ * @param uVal      Current value of the variable.
+ * @returns size of the generated message string.
+ */
+uint8_t SCISlaveNotificationBuilder(uint8_t *pui8Buf, int16_t i16Num, tuRESPONSEVALUE uVal);
+
+/** \brief Builds an unsolicited command completion string.
+ *
+ * @param *pui8Buf  Pointer to the buffer where the string is going to be stored.
+ * @param i16Num    Number of the completed command.
+ * @param eAck      Final acknowledge of the command.
+ * @returns size of the generated message string.
+ */
+uint8_t SCISlaveCompletionBuilder(uint8_t *pui8Buf, int16_t i16Num, teREQUEST_ACKNOWLEDGE eAck);
+
 uint8_t _SCIFillBufferWithValues(uint8_t * pui8Buf, uint8_t ui8MaxSize, tsRESPONSECONTROL *psResponseControl);
 
 
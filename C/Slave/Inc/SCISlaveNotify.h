@@ -0,0 +1,104 @@
+/**************************************************************************//**
+ * \file SCISlaveNotify.h
+ * \author Roman Holderried
+ *
+ * \brief Change driven variable notifications of the SCI slave.
+ *
+ * Subscribed variables are compared against a shadow copy in the idle time of
+ * the slave state machine. If the value moved by more than the configured
+ * deadband, an unsolicited NOTIFY frame is sent to the master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-19 - File creation
+ *****************************************************************************/
+
+#ifndef _SCISLAVENOTIFY_H_
+#define _SCISLAVENOTIFY_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "SCIconfig.h"
+#include "SCICommon.h"
+#include "SCITransferCommon.h"
+#include "SCIVarAccess.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#ifndef MAX_NUMBER_OF_SUBSCRIPTIONS
+#define MAX_NUMBER_OF_SUBSCRIPTIONS 4
+#endif
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Subscription of a single variable.*/
+typedef struct
+{
+    int16_t         i16VarNum;      /*!< Subscribed variable number (0 marks a free slot).*/
+    tuREQUESTVALUE  uDeadband;      /*!< Deadband (f_float for eDTYPE_F32, ui32_hex otherwise).*/
+    uint32_t        ui32Shadow;     /*!< Raw value of the last notification.*/
+}tsSCI_SUBSCRIPTION;
+
+#define tsSCI_SUBSCRIPTION_DEFAULTS {0, {.ui32_hex = 0}, 0}
+
+typedef struct
+{
+    tsSCI_SUBSCRIPTION  sSubscription[MAX_NUMBER_OF_SUBSCRIPTIONS];
+    uint8_t             ui8NextIdx;     /*!< Round robin index of the change detection.*/
+}tsSCI_NOTIFY;
+
+#define tsSCI_NOTIFY_DEFAULTS {{tsSCI_SUBSCRIPTION_DEFAULTS}, 0}
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Subscribes a variable for change notifications.
+ *
+ * The current value of the variable becomes the shadow value. Subscribing an
+ * already subscribed variable updates its deadband.
+ *
+ * @param psNotify      module data pointer
+ * @param pVarAccess    Variable access module data pointer
+ * @param i16VarNum     Variable number to subscribe
+ * @param uDeadband     Minimum change that triggers a notification
+ * @returns Error indicator
+ */
+teSCI_SLAVE_ERROR SCISlaveNotifySubscribe(tsSCI_NOTIFY *psNotify, tsVAR_ACCESS *pVarAccess, int16_t i16VarNum, tuREQUESTVALUE uDeadband);
+
+/** \brief Removes a variable subscription.
+ *
+ * @param psNotify      module data pointer
+ * @param i16VarNum     Variable number to unsubscribe
+ */
+void SCISlaveNotifyUnsubscribe(tsSCI_NOTIFY *psNotify, int16_t i16VarNum);
+
+/** \brief Searches the next subscribed variable that left its deadband.
+ *
+ * The search starts after the variable found on the last call, so that a
+ * steadily changing variable can't starve the others. The shadow value is
+ * left untouched, see SCISlaveNotifyCommit.
+ *
+ * @param psNotify      module data pointer
+ * @param pVarAccess    Variable access module data pointer
+ * @param pi16VarNum    Number of the changed variable
+ * @param pui32Val      Raw value that left the deadband (the value to notify)
+ * @returns True if a notification is due, false otherwise.
+ */
+bool SCISlaveNotifyCheck(tsSCI_NOTIFY *psNotify, tsVAR_ACCESS *pVarAccess, int16_t *pi16VarNum, uint32_t *pui32Val);
+
+/** \brief Takes over a notified value as the shadow value of its subscription.
+ *
+ * Called once the notification has been sent, a notification that could not be
+ * sent is found again by the next SCISlaveNotifyCheck.
+ *
+ * @param psNotify      module data pointer
+ * @param i16VarNum     Number of the notified variable
+ * @param ui32Val       Raw value returned by SCISlaveNotifyCheck
+ */
+void SCISlaveNotifyCommit(tsSCI_NOTIFY *psNotify, int16_t i16VarNum, uint32_t ui32Val);
+
+#endif //_SCISLAVENOTIFY_H_
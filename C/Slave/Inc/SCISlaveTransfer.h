@@ -28,6 +28,16 @@
  *****************************************************************************/
 // #define MAX_NUM_COMMAND_VALUES 10
 
+// A DELTA response holds the generation (control number) and number/value pairs.
+// Worst case sizes: "FFFF%DAT;FFFFFFFF;" header and "FFFF,FFFFFFFF," per pair.
+#define DELTA_PAIRS_PER_PACKET  ((TX_PACKET_LENGTH - 18) / 14)
+#define DELTA_PAIRS_PER_VALUES  (MAX_NUM_RESPONSE_VALUES / 2)
+#define MAX_NUM_DELTA_PAIRS     (DELTA_PAIRS_PER_PACKET < DELTA_PAIRS_PER_VALUES ? DELTA_PAIRS_PER_PACKET : DELTA_PAIRS_PER_VALUES)
+
+// Access rights of a memory window
+#define SCI_MEM_ACCESS_READ     0x01
+#define SCI_MEM_ACCESS_WRITE    0x02
+
 /******************************************************************************
  * Type definitions
  *****************************************************************************/
@@ -85,16 +95,69 @@ typedef struct
             uint8_t firstPacketNotSent  : 1;
             uint8_t ongoing             : 1;
             uint8_t upstream            : 1;
-            uint8_t reserved            : 5;
+            uint8_t varWords            : 1;    /*!< GETVAR of an array or 64 bit variable.*/
+            uint8_t generated           : 1;    /*!< COMMAND results produced by a generator.*/
+            uint8_t freeRunning         : 1;    /*!< Upstream chunks are sent without request (windowed acknowledges).*/
+            uint8_t noResponse          : 1;    /*!< The request is not answered (upstream acknowledges).*/
+            uint8_t acknowledged        : 1;    /*!< The upstream is kept until the master acknowledges all data.*/
         }ui8ControlBits;
         
         uint8_t ui8ControlByte;
     };
     uint32_t    ui32DataIdx;
+    uint32_t    ui32VarWordIdx;     /*!< Variable word held by puRespVals[0] (varWords transfers).*/
     tsRESPONSE  sRsp;
+    uint32_t    ui32AckIdx;         /*!< Upstream offset acknowledged by the master (free running upstream).*/
+    uint8_t     ui8Window;          /*!< Chunks that may be sent beyond ui32AckIdx (free running upstream).*/
 }tsRESPONSECONTROL;
 
-#define tsRESPONSECONTROL_DEFAULTS {{.ui8ControlByte = 0}, 0, tsRESPONSE_DEFAULTS}
+#define tsRESPONSECONTROL_DEFAULTS {{.ui8ControlByte = 0}, 0, 0, tsRESPONSE_DEFAULTS, 0, 0}
+
+/** \brief Memory range the master may access with MEMORY requests.*/
+typedef struct
+{
+    uint8_t     *pui8Base;  /*!< Start address of the window.*/
+    uint32_t    ui32Size;   /*!< Size of the window in bytes.*/
+    uint8_t     ui8Access;  /*!< Access rights (SCI_MEM_ACCESS_READ / SCI_MEM_ACCESS_WRITE).*/
+}tsSCI_MEM_WINDOW;
+
+/** \brief Sink of DOWNSTREAM transfers.
+ *
+ * Called with pui8Data == NULL when the master announces a transfer of ui32Size
+ * bytes (return false to reject it), then once per chunk in offset order. Returning
+ * false for a chunk leaves it unconsumed, the master repeats it (flow control).
+ */
+typedef bool(*DOWNSTREAM_CB)(int16_t i16Num, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8Len, uint32_t ui32Size);
+
+/** \brief Free running microsecond clock (wrap around allowed).*/
+typedef uint32_t(*GET_TIME_US_CB)(void);
+
+/** \brief State of the DOWNSTREAM transfer.*/
+typedef struct
+{
+    int16_t     i16Num;     /*!< Number the transfer has been announced with.*/
+    uint32_t    ui32Size;   /*!< Announced number of bytes.*/
+    uint32_t    ui32Offset; /*!< Next byte offset expected from the master.*/
+    bool        bActive;    /*!< A transfer has been announced.*/
+}tsSCI_DOWNSTREAM;
+
+#define tsSCI_DOWNSTREAM_DEFAULTS {0, 0, 0, false}
+
+/** \brief Command that is completed asynchronously by the application.*/
+typedef struct
+{
+    int16_t                 i16Num;     /*!< Command number (0: slot unused).*/
+    teREQUEST_ACKNOWLEDGE   eAck;       /*!< PENDING until the application completes the command.*/
+    bool                    bAnnounce;  /*!< Completion has not been announced to the master yet.*/
+    uint16_t                ui16Error;  /*!< Error number of a failed command.*/
+    uint8_t                 ui8ValCnt;  /*!< Number of result values.*/
+    tuRESPONSEVALUE         uVals[MAX_NUM_RESPONSE_VALUES]; /*!< Result values.*/
+    COMMAND_STEP_CB         cbStep;     /*!< Executes the command in slices (NULL: completed by the application).*/
+    void                    *pStepCtx;  /*!< Context passed to the step callback.*/
+    uint32_t                ui32StepUs; /*!< Duration of the latest step (expected duration of the next one).*/
+}tsSCI_PENDING_CMD;
+
+#define tsSCI_PENDING_CMD_DEFAULTS {0, eREQUEST_ACK_STATUS_PENDING, false, 0, 0, {{.ui32_hex = 0}}, NULL, NULL, 0}
 
 typedef struct
 {
@@ -102,9 +165,18 @@ typedef struct
 
     const COMMAND_CB *pCmdCBStruct;         /*!< Command callback structure.*/
 
+    const tsSCI_MEM_WINDOW  *pMemWindows;   /*!< Memory window whitelist (window number = index + 1).*/
+    uint8_t                 ui8MemWindowCnt;/*!< Number of memory windows.*/
+
+    DOWNSTREAM_CB           cbDownstream;   /*!< Sink of DOWNSTREAM transfers.*/
+    tsSCI_DOWNSTREAM        sDownstream;    /*!< Ongoing DOWNSTREAM transfer.*/
+
+    tsSCI_PENDING_CMD       sPendingCmd[MAX_NUMBER_OF_PENDING_COMMANDS];    /*!< Commands awaiting completion.*/
+    uint8_t                 ui8NextStepIdx; /*!< Pending command stepped first on the next call (round robin).*/
+    GET_TIME_US_CB          cbGetTimeUs;    /*!< Clock bounding the command steps per call (NULL: one step per call).*/
 }tsSCI_TRANSFER_SLAVE;
 
-#define tsSCI_TRANSFER_SLAVE_DEFAULTS    {tsRESPONSECONTROL_DEFAULTS, NULL}
+#define tsSCI_TRANSFER_SLAVE_DEFAULTS    {tsRESPONSECONTROL_DEFAULTS, NULL, NULL, 0, NULL, tsSCI_DOWNSTREAM_DEFAULTS, {tsSCI_PENDING_CMD_DEFAULTS}, 0, NULL}
 
 /******************************************************************************
  * Function declarations
@@ -122,4 +194,48 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
 
 void SCISlaveTransferClearResponseControl(tsSCI_TRANSFER_SLAVE *psTransfer);
 
+/** \brief Completes a command that has been acknowledged with PENDING.
+ *
+ * The result is kept until the master repeats the command.
+ *
+ * @param psTransfer    module data pointer
+ * @param i16Num        Number of the pending command
+ * @param eAck          Final acknowledge (SUCCESS, SUCCESS_DATA or ERROR)
+ * @param puVals        Result values (SUCCESS_DATA only)
+ * @param ui8ValCnt     Number of result values (max. MAX_NUM_RESPONSE_VALUES)
+ * @param ui16Error     Error number (ERROR only)
+ * @returns Error indicator
+ */
+teSCI_SLAVE_ERROR SCISlaveTransferCompleteCommand(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t i16Num, teREQUEST_ACKNOWLEDGE eAck, 
+    const tuRESPONSEVALUE *puVals, uint8_t ui8ValCnt, uint16_t ui16Error);
+
+/** \brief Returns a completed command that has not been announced yet.
+ *
+ * @param psTransfer    module data pointer
+ * @param pi16Num       Number of the completed command
+ * @param peAck         Final acknowledge of the command
+ * @returns true if a completion has to be announced
+ */
+bool SCISlaveTransferCheckCompletion(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t *pi16Num, teREQUEST_ACKNOWLEDGE *peAck);
+
+/** \brief Executes the steps of sliced commands.
+ *
+ * At least one step is executed per call. A further step is only started if it is
+ * expected to end within ui32BudgetUs (elapsed time measured with cbGetTimeUs plus
+ * the duration of the latest step of that command), or no sliced command is left.
+ *
+ * @param psTransfer    module data pointer
+ * @param ui32BudgetUs  Time budget of this call in microseconds
+ */
+void SCISlaveTransferRunCommandSteps(tsSCI_TRANSFER_SLAVE *psTransfer, uint32_t ui32BudgetUs);
+
+/** \brief Checks if the next chunk of a free running upstream may be sent.
+ *
+ * The master grants a window of chunks beyond the offset it has acknowledged.
+ *
+ * @param psTransfer    module data pointer
+ * @returns true if a chunk is due
+ */
+bool SCISlaveTransferUpstreamCredit(tsSCI_TRANSFER_SLAVE *psTransfer);
+
 #endif //_SCISLAVETRANSFER_H_
\ No newline at end of file
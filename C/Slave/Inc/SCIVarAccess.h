@@ -20,10 +20,15 @@
 #include "SCIconfig.h"
 #include "SCICommon.h"
 #include "SCIVariables.h"
+#include "SCITransferCommon.h"
 
 /******************************************************************************
  * defines
  *****************************************************************************/
+#if defined(SCI_NO_FLOAT) && !defined(VALUE_MODE_HEX)
+#error "SCI_NO_FLOAT requires VALUE_MODE_HEX"
+#endif
+
 #define EEPROM_ADDRESSTYPE_DEFAULT    EEPROM_BYTE_ADDRESSABLE
 #ifndef EEPROM_ADDRESSTYPE
 #define EEPROM_ADDRESSTYPE EEPROM_ADDRESSTYPE_DEFAULT
@@ -36,6 +41,30 @@
 
 #define EEEPROM_ADDRESS_ILLEGAL 0xFFFF
 
+// Maximum number of EEPROM words (addresses) per block transfer
+#define EEPROM_BLOCK_LENGTH_DEFAULT 16
+#ifndef EEPROM_BLOCK_LENGTH
+#define EEPROM_BLOCK_LENGTH EEPROM_BLOCK_LENGTH_DEFAULT
+#endif
+
+// Sparse variable IDs: Block index in the upper bits, position in the block in the lower bits
+#define SCI_VAR_ID_BLOCK_BITS_DEFAULT 12
+#ifndef SCI_VAR_ID_BLOCK_BITS
+#define SCI_VAR_ID_BLOCK_BITS SCI_VAR_ID_BLOCK_BITS_DEFAULT
+#endif
+
+#define SCI_VAR_ID_BLOCK_CNT    (1 << (16 - SCI_VAR_ID_BLOCK_BITS))
+#define SCI_VAR_ID_POS_MASK     ((1 << SCI_VAR_ID_BLOCK_BITS) - 1)
+
+#if defined(SCI_SPARSE_VAR_IDS) && !defined(SCI_STATIC_VAR_LAYOUT)
+#error "SCI_SPARSE_VAR_IDS requires SCI_STATIC_VAR_LAYOUT"
+#endif
+
+#define EEPROM_READ_POLICY_DEFAULT EEPROM_READ_ALWAYS
+#ifndef EEPROM_READ_POLICY
+#define EEPROM_READ_POLICY EEPROM_READ_POLICY_DEFAULT
+#endif
+
 /******************************************************************************
  * Type definitions
  *****************************************************************************/
@@ -44,6 +73,10 @@
 typedef bool(*WRITEEEPROM_CB)(uint32_t ui32Val, uint16_t ui16Address);
 /** \brief EEPROM read user callback.*/
 typedef bool(*READEEPROM_CB)(uint32_t *ui32Val, uint16_t ui16Address);
+/** \brief EEPROM block write user callback (optional). One array element per EEPROM address.*/
+typedef bool(*WRITEEEPROM_BLOCK_CB)(const uint32_t *pui32Vals, uint16_t ui16Address, uint16_t ui16Len);
+/** \brief EEPROM block read user callback (optional). One array element per EEPROM address.*/
+typedef bool(*READEEPROM_BLOCK_CB)(uint32_t *pui32Vals, uint16_t ui16Address, uint16_t ui16Len);
 
 
 typedef struct
@@ -54,7 +87,37 @@ typedef struct
 
 #define tsEEPROM_PARTITION_INFO_DEFAULTS {0,0}
 
-#define VAR_DEFAULT {NULL, eVARTYPE_NONE, eDTYPE_UINT8, NULL}
+// State flags of the EEPROM variables
+#define EEPROM_FLAG_VALID   0x01    /*!< RAM value is in sync with the EEPROM (see EEPROM_READ_POLICY).*/
+#define EEPROM_FLAG_DIRTY   0x02    /*!< RAM value still has to be written to the EEPROM (EEPROM_WRITE_BACK).*/
+#define EEPROM_FLAG_FAILED  0x04    /*!< The latest deferred write of the variable failed.*/
+
+#define EEPROM_PARTITION_IDX_NONE   0xFF
+
+/** \brief Compile time generated EEPROM layout (SCI_STATIC_VAR_LAYOUT, see SCIVarTable.h).*/
+typedef struct
+{
+    const tsEEPROM_PARTITION_INFO   *pPartitionTable;   /*!< Partition table, one entry per EEPROM variable.*/
+    const uint8_t                   *pui8PartitionIdx;  /*!< Partition table index of every variable (EEPROM_PARTITION_IDX_NONE for RAM variables).*/
+    uint8_t                         *pui8Flags;         /*!< State flags, one per EEPROM variable.*/
+    uint8_t                         ui8EEPROMVarCnt;    /*!< Number of EEPROM variables.*/
+}tsSCI_VAR_LAYOUT;
+
+/** \brief Variable numbers of an ID block (SCI_SPARSE_VAR_IDS, see SCIVarTable.h).*/
+typedef struct
+{
+    uint16_t    ui16First;  /*!< Variable number of the first variable in the block.*/
+    uint16_t    ui16Cnt;    /*!< Number of variables in the block (0: Unused block).*/
+}tsSCI_VAR_ID_BLOCK;
+
+/** \brief Compile time generated ID directory (SCI_SPARSE_VAR_IDS, see SCIVarTable.h).*/
+typedef struct
+{
+    const tsSCI_VAR_ID_BLOCK    *pBlocks;   /*!< One entry per ID block.*/
+    const uint16_t              *pui16Ids;  /*!< ID of every variable.*/
+}tsSCI_VAR_IDS;
+
+#define VAR_DEFAULT {NULL, eVARTYPE_NONE, eDTYPE_UINT8, NULL, 0}
 
 typedef struct
 {
@@ -62,11 +125,32 @@ typedef struct
 
     WRITEEEPROM_CB  cbWriteEEPROM;  /*!< Gets called in case of a EEPROM variable has been writen by command.*/
     READEEPROM_CB   cbReadEEPROM;   /*!< Gets called in case of a EEPROM variable has been read by command.*/
+    WRITEEEPROM_BLOCK_CB cbWriteEEPROMBlock;    /*!< Used instead of cbWriteEEPROM if present.*/
+    READEEPROM_BLOCK_CB  cbReadEEPROMBlock;     /*!< Used instead of cbReadEEPROM if present.*/
 
+    #ifdef SCI_STATIC_VAR_LAYOUT
+    const tsEEPROM_PARTITION_INFO *eepromPartitionTable;   /*!< Generated partition table.*/
+    const uint8_t   *pui8PartitionIdx;                      /*!< Partition table index of every variable.*/
+    uint8_t         *ui8EEPROMFlags;                        /*!< State flags of the EEPROM variables.*/
+    #else
     tsEEPROM_PARTITION_INFO eepromPartitionTable[MAX_NUMBER_OF_EEPROM_VARS];
+    uint8_t         ui8EEPROMFlags[MAX_NUMBER_OF_EEPROM_VARS];  /*!< State flags of the EEPROM variables.*/
+    #endif
+    uint8_t         ui8EEPROMVarCnt;                        /*!< Number of EEPROM variables.*/
+    uint8_t         ui8FlushIdx;                            /*!< EEPROM variable the next single flush starts with.*/
+    uint8_t         ui8FlushFailStreak;                     /*!< Consecutive failed single flushes.*/
+    uint16_t        ui16FlushBackoff;                       /*!< Single flushes to skip before the next write attempt.*/
+    uint32_t        ui32FlushFailCnt;                       /*!< Failed deferred writes.*/
+
+    uint32_t        ui32Generation;                         /*!< Generation of the latest variable modification.*/
+    uint32_t        ui32VarGeneration[SIZE_OF_VAR_STRUCT];  /*!< Modification generation of every variable.*/
 }tsVAR_ACCESS;
 
-#define tsVAR_ACCESS_DEFAULTS  {NULL, NULL, NULL, {tsEEPROM_PARTITION_INFO_DEFAULTS}}
+#ifdef SCI_STATIC_VAR_LAYOUT
+#define tsVAR_ACCESS_DEFAULTS  {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0, 0, 0, 0, 0, {0}}
+#else
+#define tsVAR_ACCESS_DEFAULTS  {NULL, NULL, NULL, NULL, NULL, {tsEEPROM_PARTITION_INFO_DEFAULTS}, {0}, 0, 0, 0, 0, 0, 0, {0}}
+#endif
 
 /******************************************************************************
  * Function declarations
@@ -74,30 +158,115 @@ typedef struct
 /** \brief Initializes the variable structure.
      * 
      * This function sets up the "partition table" for EEPROM accesses and reads writes the
-     * values currently stored in the EEPROM to the variable structure.
+     * values currently stored in the EEPROM to the variable structure. With a block read
+     * callback, contiguous EEPROM variables are read with a single transfer.
+     * With SCI_STATIC_VAR_LAYOUT, the generated partition table is used instead.
      *
      * @param   pVarAccess module data pointer
      * @returns Success indicator.
      */
 teSCI_SLAVE_ERROR InitVarstruct(tsVAR_ACCESS* pVarAccess);
 
+/** \brief Resolves a protocol variable ID into the variable number.
+ *
+ * Without SCI_SPARSE_VAR_IDS, IDs and variable numbers are identical.
+ *
+ * @param   ui16Id  Variable ID as transferred by the protocol.
+ * @returns Variable number, 0 if the ID is unknown.
+ */
+int16_t GetVarNumber(uint16_t ui16Id);
+
+/** \brief Returns the protocol ID of a variable number (inverse of GetVarNumber).*/
+uint16_t GetVarId(int16_t i16VarNum);
+
+/** \brief Returns the number of elements of a variable (1 for scalars, 0 if invalid).*/
+uint16_t GetVarElementCount(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+
+/** \brief Returns the number of 32 bit protocol words per element (2 for 64 bit types).*/
+uint8_t GetVarElementWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+
+/** \brief Checks if a variable fits into a single protocol value.
+ *
+ * Arrays and 64 bit variables are transferred as a sequence of 32 bit words
+ * (ReadVarWords / WriteVarWords), 64 bit values with the low word first.
+ */
+bool IsVarScalar(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+
+/** \brief Reads consecutive 32 bit words of an array or 64 bit variable.
+ *
+ * Elements smaller than 32 bit occupy one word each (sign / zero extended).
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   i16VarNum   Variable number (deduced from ID number) to access.
+ * @param   ui32WordIdx Index of the first word.
+ * @param * puVals      Destination of the words.
+ * @param   ui8Cnt      Number of words to read.
+ * @returns Success indicator.
+ */
+teSCI_SLAVE_ERROR ReadVarWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32WordIdx, tuRESPONSEVALUE *puVals, uint8_t ui8Cnt);
+
+/** \brief Writes consecutive 32 bit words of an array or 64 bit variable.
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   i16VarNum   Variable number (deduced from ID number) to access.
+ * @param   ui32WordIdx Index of the first word.
+ * @param * puVals      Words to write.
+ * @param   ui8Cnt      Number of words to write.
+ * @returns Success indicator.
+ */
+teSCI_SLAVE_ERROR WriteVarWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32WordIdx, const tuREQUESTVALUE *puVals, uint8_t ui8Cnt);
+
+/** \brief Reads a variable in its native width.
+ *
+ * Signed types are sign extended, unsigned types zero extended. eDTYPE_F32
+ * values are returned as raw IEEE 754 bits, so no float arithmetic is involved.
+ * Fails with eSCI_SLAVE_ERROR_VAR_NOT_SCALAR for arrays and 64 bit variables.
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   i16VarNum   Variable number (deduced from ID number) to access.
+ * @param * pui32Val    Address to the variable to which the value gets written.
+ * @returns Success indicator.
+ */
+teSCI_SLAVE_ERROR ReadRawFromVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t *pui32Val);
+
+/** \brief Writes a variable in its native width (truncated to the variable size).
+ *
+ * @param   pVarAccess  module data pointer
+ * @param i16VarNum     Variable number (deduced from ID number) to access.
+ * @param ui32Val       Raw value to write.
+ * @returns Success indicator.
+ */
+teSCI_SLAVE_ERROR WriteRawToVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32Val);
+
 /** \brief Performs a variable read operation through the variable structure.
+ *
+ * The value is returned in the representation of the protocol: Raw bits with
+ * VALUE_MODE_HEX, a float otherwise.
  *
  * @param   pVarAccess  module data pointer
  * @param   i16VarNum   Variable number (deduced from ID number) to access.
- * @param * pfVal       Address to the variable to which the value gets written.
+ * @param * puVal       Address to the variable to which the value gets written.
  * @returns Success indicator.
  */
-teSCI_SLAVE_ERROR ReadValFromVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, float *pfVal);
+teSCI_SLAVE_ERROR ReadValFromVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, tuREQUESTVALUE *puVal);
+
+/** \brief Converts a value read by ReadRawFromVarStruct into the protocol representation.
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   i16VarNum   Variable number the value belongs to (valid, scalar).
+ * @param   ui32Raw     Value in native width.
+ * @param * puVal       Address to the variable to which the value gets written.
+ */
+void RawToVal(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32Raw, tuREQUESTVALUE *puVal);
 
 /** \brief Performs a variable write operation through the variable structure.
  *
  * @param   pVarAccess  module data pointer
  * @param i16VarNum     Variable number (deduced from ID number) to access.
- * @param fVal          Value to write.
+ * @param uVal          Value to write (protocol representation, see ReadValFromVarStruct).
  * @returns Success indicator.
  */
-teSCI_SLAVE_ERROR WriteValToVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, float fVal);
+teSCI_SLAVE_ERROR WriteValToVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, tuREQUESTVALUE uVal);
 
 /** \brief Reads a value from the EEPROM into the Variable structure.
  *
@@ -107,6 +276,52 @@ teSCI_SLAVE_ERROR WriteValToVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNu
  */
 teSCI_SLAVE_ERROR ReadEEPROMValueIntoVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
 
+/** \brief Checks if the RAM value of an EEPROM variable can be served without EEPROM read.
+ *
+ * Depends on the configured EEPROM_READ_POLICY.
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   i16VarNum   Variable structure number.
+ * @returns true if the EEPROM read can be skipped.
+ */
+bool IsEEPROMValueCached(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+
+/** \brief Marks an EEPROM variable for a deferred EEPROM write.
+ *
+ * Multiple modifications before the next flush result in a single EEPROM write.
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   i16VarNum   Variable structure number.
+ * @returns Success indicator.
+ */
+teSCI_SLAVE_ERROR MarkEEPROMDirty(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+
+/** \brief Writes dirty EEPROM variables.
+ *
+ * A failed write leaves the variable dirty and marks it EEPROM_FLAG_FAILED, the
+ * other dirty variables are written nevertheless. Single flushes take the 
+ * variables in turn and back off after failures (EEPROM_FLUSH_BACKOFF_MAX).
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   bAll        true: Flush all dirty variables, false: Flush a single variable.
+ * @returns First error that occurred.
+ */
+teSCI_SLAVE_ERROR FlushEEPROM(tsVAR_ACCESS* pVarAccess, bool bAll);
+
+/** \brief Returns the number of EEPROM variables waiting for their deferred write.
+ *
+ * @param   pVarAccess  module data pointer
+ * @returns Number of dirty EEPROM variables.
+ */
+uint8_t GetEEPROMDirtyCount(tsVAR_ACCESS* pVarAccess);
+
+/** \brief Returns the number of failed deferred EEPROM writes.
+ *
+ * @param   pVarAccess  module data pointer
+ * @returns Number of failed writes since the initialization.
+ */
+uint32_t GetEEPROMFlushFailCount(tsVAR_ACCESS* pVarAccess);
+
 /** \brief Writes the EEPROM by the value read out from the variable structure.
  *
  * @param   pVarAccess  module data pointer
@@ -120,6 +335,29 @@ uint16_t GetEEPROMAddress(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
 
 teSCI_SLAVE_ERROR GetVar(tsVAR_ACCESS* pVarAccess, tsSCIVAR* pVar, int16_t i16VarNum);
 
+/** \brief Assigns a new modification generation to a variable.
+ *
+ * @param   pVarAccess  module data pointer
+ * @param   i16VarNum   Variable structure number.
+ * @returns Success indicator.
+ */
+teSCI_SLAVE_ERROR MarkVarModified(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+
+/** \brief Collects the variables modified after a given generation.
+ *
+ * The variables are returned in ascending generation order. If there are more
+ * modified variables than requested, the returned generation is the one of the
+ * last collected variable, so a consecutive call continues seamlessly.
+ *
+ * @param   pVarAccess          module data pointer
+ * @param   ui32Generation      Generation the caller is synchronized to.
+ * @param   pi16VarNums         Array receiving the variable numbers.
+ * @param   ui8MaxCnt           Size of the variable number array.
+ * @param   pui32NewGeneration  Generation the caller is synchronized to afterwards.
+ * @returns Number of collected variables.
+ */
+uint8_t GetModifiedVars(tsVAR_ACCESS* pVarAccess, uint32_t ui32Generation, int16_t *pi16VarNums, uint8_t ui8MaxCnt, uint32_t *pui32NewGeneration);
+
 /******************************************************************************
  * Global variable declaration
  *****************************************************************************/
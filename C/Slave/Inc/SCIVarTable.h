@@ -0,0 +1,190 @@
+/**************************************************************************//**
+ * \file SCIVarTable.h
+ * \author Roman Holderried
+ *
+ * \brief Compile time generated variable table and EEPROM layout.
+ *
+ * The variable structure is described once as an X-macro list:
+ *
+ * \code
+ * #define APP_VAR_TABLE(X) \
+ *     X(temperature,  &f_temp,     eVARTYPE_RAM,    eDTYPE_F32,    NULL, 0) \
+ *     X(setpoint,     &ui16_set,   eVARTYPE_EEPROM, eDTYPE_UINT16, NULL, 0) \
+ *     X(curve,        ui16_curve,  eVARTYPE_RAM,    eDTYPE_UINT16, NULL, 16)
+ *
+ * SCI_VAR_TABLE_DECLARE(APP_VAR_TABLE)            // Header: SCI_VAR_NUM_temperature, ...
+ * SCI_VAR_TABLE_DEFINE(APP_VAR_TABLE, varStruct)  // Exactly one source file
+ * \endcode
+ *
+ * SCI_VAR_TABLE_DEFINE emits the variable structure, the EEPROM partition table
+ * (sized to the number of EEPROM variables) and the variable-to-partition map as
+ * const data, together with the sSciVarLayout object InitVarstruct picks up when
+ * SCI_STATIC_VAR_LAYOUT is defined. Only the state flags of the EEPROM variables
+ * remain in RAM. MAX_NUMBER_OF_EEPROM_VARS is not used in this mode.
+ *
+ * The vartype and dtype arguments must be the plain enumerator tokens, they are
+ * resolved by the preprocessor. The last argument is the number of array
+ * elements (0 for scalars, see tsSCIVAR).
+ *
+ * With SCI_SPARSE_VAR_IDS, the variables are grouped into ID blocks instead
+ * (e.g. one per firmware module). The IDs of a block start at
+ * (block << SCI_VAR_ID_BLOCK_BITS) + 1 and stay stable when other blocks are
+ * added or removed:
+ *
+ * \code
+ * #define APP_VAR_BLOCKS(B) \
+ *     B(CORE,     0x0, CORE_VAR_TABLE)    \
+ *     B(HEATER,   0x1, HEATER_VAR_TABLE)
+ *
+ * SCI_VAR_BLOCKS_DECLARE(APP_VAR_BLOCKS)           // Additionally SCI_VAR_ID_<name>
+ * SCI_VAR_BLOCKS_DEFINE(APP_VAR_BLOCKS, varStruct) // Additionally the ID directory
+ * \endcode
+ *
+ * The variable numbers stay dense, the block directory resolves an ID with one
+ * table access (see GetVarNumber).
+ *
+ * <b> History </b>
+ * 	- 2026-10-19 - File creation
+ *****************************************************************************/
+
+#ifndef _SCIVARTABLE_H_
+#define _SCIVARTABLE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "SCIconfig.h"
+#include "SCIVariables.h"
+#include "SCIVarAccess.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+// Number of EEPROM addresses available for the variables
+#ifndef SCI_EEPROM_SIZE
+#define SCI_EEPROM_SIZE     0x10000
+#endif
+
+#define _SCI_CAT(a, b)      a##b
+#define SCI_CAT(a, b)       _SCI_CAT(a, b)
+
+// Byte length of the data types (see ui8ByteLength)
+#define SCI_DTYPE_BYTES_eDTYPE_UINT8    1
+#define SCI_DTYPE_BYTES_eDTYPE_INT8     1
+#define SCI_DTYPE_BYTES_eDTYPE_UINT16   2
+#define SCI_DTYPE_BYTES_eDTYPE_INT16    2
+#define SCI_DTYPE_BYTES_eDTYPE_UINT32   4
+#define SCI_DTYPE_BYTES_eDTYPE_INT32    4
+#define SCI_DTYPE_BYTES_eDTYPE_F32      4
+#define SCI_DTYPE_BYTES_eDTYPE_UINT64   8
+#define SCI_DTYPE_BYTES_eDTYPE_INT64    8
+#define SCI_DTYPE_BYTES_eDTYPE_F64      8
+
+#define SCI_VARTYPE_IS_EE_eVARTYPE_NONE     0
+#define SCI_VARTYPE_IS_EE_eVARTYPE_EEPROM   1
+#define SCI_VARTYPE_IS_EE_eVARTYPE_RAM      0
+
+#define SCI_IF_EE_eVARTYPE_NONE(...)
+#define SCI_IF_EE_eVARTYPE_EEPROM(...)      __VA_ARGS__
+#define SCI_IF_EE_eVARTYPE_RAM(...)
+
+#define SCI_DTYPE_BYTES(dtype)          SCI_CAT(SCI_DTYPE_BYTES_, dtype)
+#define SCI_VARTYPE_IS_EE(vartype)      SCI_CAT(SCI_VARTYPE_IS_EE_, vartype)
+#define SCI_IF_EE(vartype, ...)         SCI_CAT(SCI_IF_EE_, vartype)(__VA_ARGS__)
+
+// Number of EEPROM addresses of a variable (equals _GetEEPROMWordCount)
+#define SCI_EE_WORDS(vartype, dtype) \
+    (SCI_VARTYPE_IS_EE(vartype) * ((SCI_DTYPE_BYTES(dtype) + EEPROM_ADDRESSTYPE - 1) / EEPROM_ADDRESSTYPE))
+
+/* The offsets are calculated with helper structures holding one uint8_t array
+ * per variable. Every member is one byte larger than required (zero sized arrays
+ * are not allowed), so the offset of a member minus its index is the sum of the
+ * preceding sizes. */
+#define _SCI_VT_ENUM(name, pVal, vartype, dtype, ap, cnt)   SCI_VAR_NUM_##name,
+#define _SCI_VT_ADDR(name, pVal, vartype, dtype, ap, cnt)   uint8_t name[1 + SCI_EE_WORDS(vartype, dtype)];
+#define _SCI_VT_CNT(name, pVal, vartype, dtype, ap, cnt)    uint8_t name[1 + SCI_VARTYPE_IS_EE(vartype)];
+#define _SCI_VT_VAR(name, pVal, vartype, dtype, ap, cnt)    {pVal, vartype, dtype, ap, cnt},
+
+#define _SCI_VT_OFFSET(layout, name)    (offsetof(layout, name) - (SCI_VAR_NUM_##name - 1))
+
+#define _SCI_VT_PARTITION(name, pVal, vartype, dtype, ap, cnt) \
+    SCI_IF_EE(vartype, {SCI_VAR_NUM_##name - 1, ADDRESS_OFFET + _SCI_VT_OFFSET(tsSCI_VT_ADDR_LAYOUT, name)},)
+#define _SCI_VT_IDX(name, pVal, vartype, dtype, ap, cnt) \
+    (SCI_VARTYPE_IS_EE(vartype) ? _SCI_VT_OFFSET(tsSCI_VT_CNT_LAYOUT, name) : EEPROM_PARTITION_IDX_NONE),
+
+/* ID blocks: The first and last variable number of a block are captured with
+ * marker enumerators, which reset the enumeration to not consume a number. */
+#define _SCI_VT_ID_ENUM(name, pVal, vartype, dtype, ap, cnt)    SCI_VAR_ID_##name,
+#define _SCI_VT_ID(name, pVal, vartype, dtype, ap, cnt)         SCI_VAR_ID_##name,
+
+#define _SCI_VB_ENUM(blk, idx, TABLE) \
+    _SCI_VB_FIRST_##blk, _SCI_VB_FIRST_RESET_##blk = _SCI_VB_FIRST_##blk - 1, TABLE(_SCI_VT_ENUM) \
+    _SCI_VB_END_##blk, _SCI_VB_END_RESET_##blk = _SCI_VB_END_##blk - 1,
+#define _SCI_VB_ID_ENUM(blk, idx, TABLE) \
+    _SCI_VB_ID_BASE_##blk = (idx) << SCI_VAR_ID_BLOCK_BITS, TABLE(_SCI_VT_ID_ENUM)
+#define _SCI_VB_CHECK(blk, idx, TABLE) \
+    _Static_assert((idx) < SCI_VAR_ID_BLOCK_CNT, "Variable block " #blk " exceeds the ID range"); \
+    _Static_assert(_SCI_VB_END_##blk - _SCI_VB_FIRST_##blk <= SCI_VAR_ID_POS_MASK, "Variable block " #blk " too large");
+#define _SCI_VB_DIR(blk, idx, TABLE)        [idx] = {_SCI_VB_FIRST_##blk, _SCI_VB_END_##blk - _SCI_VB_FIRST_##blk},
+
+#define _SCI_VB_ADDR(blk, idx, TABLE)       TABLE(_SCI_VT_ADDR)
+#define _SCI_VB_CNT(blk, idx, TABLE)        TABLE(_SCI_VT_CNT)
+#define _SCI_VB_VAR(blk, idx, TABLE)        TABLE(_SCI_VT_VAR)
+#define _SCI_VB_PARTITION(blk, idx, TABLE)  TABLE(_SCI_VT_PARTITION)
+#define _SCI_VB_IDX(blk, idx, TABLE)        TABLE(_SCI_VT_IDX)
+#define _SCI_VB_ID(blk, idx, TABLE)         TABLE(_SCI_VT_ID)
+
+/* The expanded per-variable lists are passed as arguments, the commas they
+ * contain appear after argument separation. */
+#define _SCI_VAR_TABLE_DEFINE(varStructName, ADDR_LIST, CNT_LIST, VAR_LIST, PARTITION_LIST, IDX_LIST) \
+    typedef struct { ADDR_LIST } tsSCI_VT_ADDR_LAYOUT; \
+    typedef struct { CNT_LIST } tsSCI_VT_CNT_LAYOUT; \
+    enum { SCI_NUM_EEPROM_VARS = sizeof(tsSCI_VT_CNT_LAYOUT) - (_SCI_VAR_NUM_END - 1) }; \
+    _Static_assert(_SCI_VAR_NUM_END - 1 == SIZE_OF_VAR_STRUCT, "Variable table does not match SIZE_OF_VAR_STRUCT"); \
+    _Static_assert(SCI_NUM_EEPROM_VARS < EEPROM_PARTITION_IDX_NONE, "Too many EEPROM variables"); \
+    _Static_assert(ADDRESS_OFFET + sizeof(tsSCI_VT_ADDR_LAYOUT) - SIZE_OF_VAR_STRUCT <= SCI_EEPROM_SIZE, \
+                   "EEPROM variables exceed SCI_EEPROM_SIZE"); \
+    const tsSCIVAR varStructName[] = { VAR_LIST }; \
+    static const tsEEPROM_PARTITION_INFO sSciPartitionTable[SCI_NUM_EEPROM_VARS + 1] = \
+        { PARTITION_LIST tsEEPROM_PARTITION_INFO_DEFAULTS }; \
+    static const uint8_t ui8SciPartitionIdx[SIZE_OF_VAR_STRUCT] = { IDX_LIST }; \
+    static uint8_t ui8SciEEPROMFlags[SCI_NUM_EEPROM_VARS + 1]; \
+    const tsSCI_VAR_LAYOUT sSciVarLayout = {sSciPartitionTable, ui8SciPartitionIdx, ui8SciEEPROMFlags, SCI_NUM_EEPROM_VARS};
+
+/** \brief Declares the variable numbers SCI_VAR_NUM_<name> (starting with 1).*/
+#define SCI_VAR_TABLE_DECLARE(TABLE) \
+    enum { SCI_VAR_NUM_NONE = 0, TABLE(_SCI_VT_ENUM) _SCI_VAR_NUM_END };
+
+/** \brief Defines the variable structure and the EEPROM layout (once per application).*/
+#define SCI_VAR_TABLE_DEFINE(TABLE, varStructName) \
+    _SCI_VAR_TABLE_DEFINE(varStructName, TABLE(_SCI_VT_ADDR), TABLE(_SCI_VT_CNT), TABLE(_SCI_VT_VAR), \
+                          TABLE(_SCI_VT_PARTITION), TABLE(_SCI_VT_IDX))
+
+/** \brief Declares the variable numbers SCI_VAR_NUM_<name> and IDs SCI_VAR_ID_<name> of an ID block list.*/
+#define SCI_VAR_BLOCKS_DECLARE(BLOCKS) \
+    enum { SCI_VAR_NUM_NONE = 0, BLOCKS(_SCI_VB_ENUM) _SCI_VAR_NUM_END }; \
+    enum { BLOCKS(_SCI_VB_ID_ENUM) };
+
+/** \brief Defines the variable structure, the EEPROM layout and the ID directory (once per application).*/
+#define SCI_VAR_BLOCKS_DEFINE(BLOCKS, varStructName) \
+    _SCI_VAR_TABLE_DEFINE(varStructName, BLOCKS(_SCI_VB_ADDR), BLOCKS(_SCI_VB_CNT), BLOCKS(_SCI_VB_VAR), \
+                          BLOCKS(_SCI_VB_PARTITION), BLOCKS(_SCI_VB_IDX)) \
+    BLOCKS(_SCI_VB_CHECK) \
+    static const tsSCI_VAR_ID_BLOCK sSciVarIdBlocks[SCI_VAR_ID_BLOCK_CNT] = { BLOCKS(_SCI_VB_DIR) }; \
+    static const uint16_t ui16SciVarIds[SIZE_OF_VAR_STRUCT] = { BLOCKS(_SCI_VB_ID) }; \
+    const tsSCI_VAR_IDS sSciVarIds = {sSciVarIdBlocks, ui16SciVarIds};
+
+/******************************************************************************
+ * Global variable declaration
+ *****************************************************************************/
+#ifdef SCI_STATIC_VAR_LAYOUT
+extern const tsSCI_VAR_LAYOUT sSciVarLayout;
+#endif
+
+#ifdef SCI_SPARSE_VAR_IDS
+extern const tsSCI_VAR_IDS sSciVarIds;
+#endif
+
+#endif //_SCIVARTABLE_H_
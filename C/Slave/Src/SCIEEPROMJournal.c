@@ -0,0 +1,229 @@
+/**************************************************************************//**
+ * \file SCIEEPROMJournal.c
+ * \author Roman Holderried
+ *
+ * \brief Wear leveling journal backend for EEPROM variables.
+ *
+ * <b> History </b>
+ * 	- 2026-10-19 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "SCIEEPROMJournal.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define EEPROM_JOURNAL_ERASED_UNIT  0xFFFFFFFFUL
+
+#if EEPROM_ADDRESSTYPE == EEPROM_LONG_ADDRESSABLE
+#define EEPROM_JOURNAL_ERASED_WORD  0xFFFFFFFFUL
+#else
+#define EEPROM_JOURNAL_ERASED_WORD  ((1UL << (EEPROM_ADDRESSTYPE * 8)) - 1)
+#endif
+
+#define BANK_ADDRESS(bank)          (EEPROM_JOURNAL_BASE_ADDRESS + (bank) * EEPROM_JOURNAL_BANK_SIZE)
+#define RECORD_ADDRESS(bank, idx)   (BANK_ADDRESS(bank) + EEPROM_JOURNAL_UNIT_SIZE + (idx) * EEPROM_JOURNAL_RECORD_SIZE)
+#define BANK_TAG(seq)               ((seq) & 0xFFFF)
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsEEPROM_JOURNAL sJournal = tsEEPROM_JOURNAL_DEFAULTS;
+
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static bool _ReadUnit(uint16_t ui16Address, uint32_t *pui32Val);
+static bool _WriteUnit(uint16_t ui16Address, uint32_t ui32Val);
+static bool _AppendRecord(uint16_t ui16Key);
+static bool _Compact(void);
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+bool SCIEEPROMJournalInit(READEEPROM_CB cbRead, WRITEEEPROM_CB cbWrite)
+{
+    uint32_t ui32Header[2];
+    bool bValid[2];
+
+    sJournal.cbReadEEPROM   = cbRead;
+    sJournal.cbWriteEEPROM  = cbWrite;
+    sJournal.ui16NextRecord = 0;
+    sJournal.sStats         = (tsEEPROM_JOURNAL_STATS)tsEEPROM_JOURNAL_STATS_DEFAULTS;
+
+    for (uint16_t i = 0; i < EEPROM_JOURNAL_LOGICAL_SIZE; i++)
+        sJournal.ui32Values[i] = EEPROM_JOURNAL_ERASED_WORD;
+
+    if (!_ReadUnit(BANK_ADDRESS(0), &ui32Header[0]) || !_ReadUnit(BANK_ADDRESS(1), &ui32Header[1]))
+        return false;
+
+    bValid[0] = ui32Header[0] != EEPROM_JOURNAL_ERASED_UNIT;
+    bValid[1] = ui32Header[1] != EEPROM_JOURNAL_ERASED_UNIT;
+
+    // Unformatted EEPROM (bank sequence 0 is avoided, a zeroed record area would be valid otherwise)
+    if (!bValid[0] && !bValid[1])
+    {
+        sJournal.ui8ActiveBank  = 0;
+        sJournal.ui32BankSeq    = 1;
+        return _WriteUnit(BANK_ADDRESS(0), sJournal.ui32BankSeq);
+    }
+
+    // Both banks valid: The compaction has been interrupted before the old bank was invalidated
+    if (bValid[0] && bValid[1])
+        sJournal.ui8ActiveBank = (int32_t)(ui32Header[1] - ui32Header[0]) > 0 ? 1 : 0;
+    else
+        sJournal.ui8ActiveBank = bValid[1] ? 1 : 0;
+
+    sJournal.ui32BankSeq = ui32Header[sJournal.ui8ActiveBank];
+
+    // Replay: The records end at the first record without the tag of the active bank
+    while (sJournal.ui16NextRecord < EEPROM_JOURNAL_RECORDS_PER_BANK)
+    {
+        uint32_t ui32Commit, ui32Val;
+        uint16_t ui16Key;
+
+        if (!_ReadUnit(RECORD_ADDRESS(sJournal.ui8ActiveBank, sJournal.ui16NextRecord) + EEPROM_JOURNAL_UNIT_SIZE, &ui32Commit))
+            return false;
+
+        ui16Key = (uint16_t)(ui32Commit >> 16);
+
+        if (BANK_TAG(ui32Commit) != BANK_TAG(sJournal.ui32BankSeq) || ui16Key >= EEPROM_JOURNAL_LOGICAL_SIZE)
+            break;
+
+        if (!_ReadUnit(RECORD_ADDRESS(sJournal.ui8ActiveBank, sJournal.ui16NextRecord), &ui32Val))
+            return false;
+
+        sJournal.ui32Values[ui16Key] = ui32Val;
+        sJournal.ui16NextRecord++;
+    }
+
+    if (bValid[0] && bValid[1])
+        return _WriteUnit(BANK_ADDRESS(1 - sJournal.ui8ActiveBank), EEPROM_JOURNAL_ERASED_UNIT);
+
+    return true;
+}
+
+//=============================================================================
+bool SCIEEPROMJournalRead(uint32_t *pui32Val, uint16_t ui16Address)
+{
+    if (ui16Address >= EEPROM_JOURNAL_LOGICAL_SIZE)
+        return false;
+
+    *pui32Val = sJournal.ui32Values[ui16Address];
+
+    return true;
+}
+
+//=============================================================================
+bool SCIEEPROMJournalWrite(uint32_t ui32Val, uint16_t ui16Address)
+{
+    sJournal.sStats.ui32LogicalWrites++;
+
+    if (ui16Address >= EEPROM_JOURNAL_LOGICAL_SIZE)
+        return false;
+
+    ui32Val &= EEPROM_JOURNAL_ERASED_WORD;
+
+    // Nothing to do
+    if (sJournal.ui32Values[ui16Address] == ui32Val)
+        return true;
+
+    sJournal.ui32Values[ui16Address] = ui32Val;
+
+    // Active bank is full -> The compaction writes the new value as well
+    if (sJournal.ui16NextRecord >= EEPROM_JOURNAL_RECORDS_PER_BANK)
+        return _Compact();
+
+    return _AppendRecord(ui16Address);
+}
+
+//=============================================================================
+tsEEPROM_JOURNAL_STATS SCIEEPROMJournalGetStats(void)
+{
+    return sJournal.sStats;
+}
+
+//=============================================================================
+static bool _ReadUnit(uint16_t ui16Address, uint32_t *pui32Val)
+{
+    *pui32Val = 0;
+
+    for (uint8_t i = 0; i < EEPROM_JOURNAL_UNIT_SIZE; i++)
+    {
+        uint32_t ui32Word = 0;
+
+        sJournal.sStats.ui32PhysicalReads++;
+
+        if (!sJournal.cbReadEEPROM(&ui32Word, ui16Address + i))
+            return false;
+
+        *pui32Val |= (ui32Word & EEPROM_JOURNAL_ERASED_WORD) << (i * EEPROM_ADDRESSTYPE * 8);
+    }
+
+    return true;
+}
+
+//=============================================================================
+static bool _WriteUnit(uint16_t ui16Address, uint32_t ui32Val)
+{
+    for (uint8_t i = 0; i < EEPROM_JOURNAL_UNIT_SIZE; i++)
+    {
+        sJournal.sStats.ui32PhysicalWrites++;
+
+        if (!sJournal.cbWriteEEPROM((ui32Val >> (i * EEPROM_ADDRESSTYPE * 8)) & EEPROM_JOURNAL_ERASED_WORD, ui16Address + i))
+            return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static bool _AppendRecord(uint16_t ui16Key)
+{
+    uint16_t ui16Address = RECORD_ADDRESS(sJournal.ui8ActiveBank, sJournal.ui16NextRecord);
+
+    // The commit unit is written last, so an interrupted write leaves no valid record
+    if (!_WriteUnit(ui16Address, sJournal.ui32Values[ui16Key]))
+        return false;
+
+    if (!_WriteUnit(ui16Address + EEPROM_JOURNAL_UNIT_SIZE, ((uint32_t)ui16Key << 16) | BANK_TAG(sJournal.ui32BankSeq)))
+        return false;
+
+    sJournal.ui16NextRecord++;
+
+    return true;
+}
+
+//=============================================================================
+static bool _Compact(void)
+{
+    uint8_t ui8OldBank = sJournal.ui8ActiveBank;
+
+    sJournal.ui8ActiveBank  = 1 - ui8OldBank;
+    sJournal.ui16NextRecord = 0;
+
+    // The erased pattern marks an invalid bank
+    if (++sJournal.ui32BankSeq == EEPROM_JOURNAL_ERASED_UNIT)
+        sJournal.ui32BankSeq = 1;
+
+    // Copy all values that differ from erased EEPROM into the new bank
+    for (uint16_t i = 0; i < EEPROM_JOURNAL_LOGICAL_SIZE; i++)
+    {
+        if (sJournal.ui32Values[i] != EEPROM_JOURNAL_ERASED_WORD && !_AppendRecord(i))
+            return false;
+    }
+
+    // Commit the new bank, then invalidate the old one
+    if (!_WriteUnit(BANK_ADDRESS(sJournal.ui8ActiveBank), sJournal.ui32BankSeq))
+        return false;
+
+    sJournal.sStats.ui32Compactions++;
+
+    return _WriteUnit(BANK_ADDRESS(ui8OldBank), EEPROM_JOURNAL_ERASED_UNIT);
+}
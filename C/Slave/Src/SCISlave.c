@@ -17,6 +17,7 @@
 #include "SCISlave.h"
 #include "SCISlaveTransfer.h"
 #include "SCISlaveDataframe.h"
+#include "SCISlaveNotify.h"
 #include "SCIconfig.h"
 #include "CommandStucture.h"
 #include "Helpers.h"
@@ -38,6 +39,11 @@ static tsSCI_SLAVE sSciSlave = tsSCI_SLAVE_DEFAULTS;
 // static const uint8_t ui8CmdIdArr[6]         = {'#', '?', '!', ':', '>', '<'};
 // const uint8_t ui8ByteLength[7]              = {1,1,2,2,4,4,4};
 
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static void _SCISlaveTransmitResponse (void);
+
 /******************************************************************************
  * Function definitions
  *****************************************************************************/
@@ -53,6 +59,8 @@ teSCI_SLAVE_ERROR SCISlaveInit(tsSCI_SLAVE_CALLBACKS sCallbacks, const tsSCIVAR
     // Initialize the callbacks
     sSciSlave.sVarAccess.cbReadEEPROM           = sCallbacks.cbReadEEPROM;
     sSciSlave.sVarAccess.cbWriteEEPROM          = sCallbacks.cbWriteEEPROM;
+    sSciSlave.sVarAccess.cbReadEEPROMBlock      = sCallbacks.cbReadEEPROMBlock;
+    sSciSlave.sVarAccess.cbWriteEEPROMBlock     = sCallbacks.cbWriteEEPROMBlock;
     sSciSlave.sDatalink.txBlockingCallback      = sCallbacks.cbTransmitBlocking;
     sSciSlave.sDatalink.txNonBlockingCallback   = sCallbacks.cbTransmitNonBlocking;
     sSciSlave.sDatalink.txGetBusyStateCallback  = sCallbacks.cbGetTxBusyState;
@@ -61,6 +69,19 @@ teSCI_SLAVE_ERROR SCISlaveInit(tsSCI_SLAVE_CALLBACKS sCallbacks, const tsSCIVAR
     sSciSlave.sVarAccess.pVarStruct       = pVarStruct;
     sSciSlave.sSciTransfer.pCmdCBStruct   = pCmdStruct;
 
+    // Only the whitelisted memory windows are accessible by MEMORY requests
+    sSciSlave.sSciTransfer.pMemWindows      = sCallbacks.pMemWindows;
+    sSciSlave.sSciTransfer.ui8MemWindowCnt  = sCallbacks.pMemWindows != NULL ? sCallbacks.ui8MemWindowCnt : 0;
+
+    // Sink of DOWNSTREAM transfers
+    sSciSlave.sSciTransfer.cbDownstream = sCallbacks.cbDownstream;
+    sSciSlave.sSciTransfer.sDownstream.bActive = false;
+
+    // No command is pending after a restart
+    memset(sSciSlave.sSciTransfer.sPendingCmd, 0, sizeof(sSciSlave.sSciTransfer.sPendingCmd));
+    sSciSlave.sSciTransfer.ui8NextStepIdx   = 0;
+    sSciSlave.sSciTransfer.cbGetTimeUs      = sCallbacks.cbGetTimeUs;
+
     // Configure data structures
     fifoBufInit(&sSciSlave.sRxFIFO, sSciSlave.ui8RxBuffer, RX_PACKET_LENGTH);
     fifoBufInit(&sSciSlave.sTxFIFO, sSciSlave.ui8TxBuffer, TX_PACKET_LENGTH);
@@ -83,6 +104,9 @@ void SCISlaveReceiveData (uint8_t ui8Data)
 //=============================================================================
 void SCISlaveStatemachine (void)
 {
+    // Sliced commands progress independently of the protocol state
+    SCISlaveTransferRunCommandSteps(&sSciSlave.sSciTransfer, SCI_COMMAND_STEP_BUDGET_US);
+
     // Check the lower level datalink states and set the protocol state accordingly
     if (sSciSlave.e_state > ePROTOCOL_ERROR && sSciSlave.e_state != ePROTOCOL_SENDING)
     {
@@ -103,6 +127,46 @@ void SCISlaveStatemachine (void)
     switch(sSciSlave.e_state)
     {
         case ePROTOCOL_IDLE:
+            // Free running upstream: The chunks follow each other as long as the window of the master allows it
+            if (sSciSlave.sDatalink.rState == eDATALINK_RSTATE_WAIT_STX && SCISlaveTransferUpstreamCredit(&sSciSlave.sSciTransfer))
+                _SCISlaveTransmitResponse();
+            // Notifications are only sent when no request is being received and no transfer is ongoing
+            else if (sSciSlave.sDatalink.rState == eDATALINK_RSTATE_WAIT_STX && sSciSlave.sSciTransfer.sResponseControl.ui8ControlByte == 0)
+            {
+                int16_t         i16VarNum;
+                tuRESPONSEVALUE uVal;
+                uint32_t        ui32Raw;
+                teREQUEST_ACKNOWLEDGE eAck;
+
+                // Completed commands are announced first
+                if (SCISlaveTransferCheckCompletion(&sSciSlave.sSciTransfer, &i16VarNum, &eAck))
+                {
+                    flushBuf(&sSciSlave.sTxFIFO);
+                    increaseBufIdx(&sSciSlave.sTxFIFO, SCISlaveCompletionBuilder(sSciSlave.ui8TxBuffer, i16VarNum, eAck));
+
+                    if (SCIDatalinkTransmit(&sSciSlave.sDatalink, &sSciSlave.sTxFIFO))
+                        sSciSlave.e_state = ePROTOCOL_SENDING;
+                }
+                else if (SCISlaveNotifyCheck(&sSciSlave.sNotify, &sSciSlave.sVarAccess, &i16VarNum, &ui32Raw))
+                {
+                    // The value compared against the deadband is sent
+                    RawToVal(&sSciSlave.sVarAccess, i16VarNum, ui32Raw, &uVal);
+                    flushBuf(&sSciSlave.sTxFIFO);
+                    increaseBufIdx(&sSciSlave.sTxFIFO, SCISlaveNotificationBuilder(sSciSlave.ui8TxBuffer, (int16_t)GetVarId(i16VarNum), uVal));
+
+                    // The shadow follows once the notification is on its way, otherwise it is tried again
+                    if (SCIDatalinkTransmit(&sSciSlave.sDatalink, &sSciSlave.sTxFIFO))
+                    {
+                        SCISlaveNotifyCommit(&sSciSlave.sNotify, i16VarNum, ui32Raw);
+                        sSciSlave.e_state = ePROTOCOL_SENDING;
+                    }
+                }
+                #ifdef EEPROM_WRITE_BACK
+                // Write back one dirty EEPROM variable per idle cycle
+                else
+                    FlushEEPROM(&sSciSlave.sVarAccess, false);
+                #endif
+            }
             break;
         case ePROTOCOL_RECEIVING:
             break;
@@ -110,13 +174,18 @@ void SCISlaveStatemachine (void)
             {
                 uint8_t *   pui8Buf;
                 tsREQUEST    sReq = tsREQUEST_DEFAULTS;
+                tuREQUESTVALUE uReqVals[MAX_NUM_REQUEST_VALUES];
                 // tsRESPONSE   sRsp = tsRESPONSE_DEFAULTS; 
                 uint8_t     ui8_msgSize = readBuf(&sSciSlave.sRxFIFO, &pui8Buf);
                 teSCI_SLAVE_ERROR  eError = eSCI_SLAVE_ERROR_NONE;
 
                 // Parse the command (skip STX and don't care for ETX)
+                sReq.uValArr = uReqVals;
                 eError = SCISlaveRequestParser(pui8Buf, ui8_msgSize, &sReq);
 
+                // Request has been taken over
+                SCIDatalinkAcknowledgeRx(&sSciSlave.sDatalink);
+
                 // Take over command number and type
                 SCISlaveTransferInitiateResponse(&sSciSlave.sSciTransfer, sReq.i16Num, sReq.eReqType);
 
@@ -128,24 +197,17 @@ void SCISlaveStatemachine (void)
                 if(eError != eSCI_SLAVE_ERROR_NONE)
                     SCISlaveTransferSetError(&sSciSlave.sSciTransfer, GET_SCI_ERROR_NUMBER((uint16_t)eError));
 
+                // The request has been consumed -> Accept the next one while the response is sent (pipelined requests)
+                SCIDatalinkStartRx(&sSciSlave.sDatalink);
 
-                flushBuf(&sSciSlave.sTxFIFO);
-                
-                // "Put" the date into the tx buffer
-                pui8Buf = sSciSlave.ui8TxBuffer;
-                increaseBufIdx(&sSciSlave.sTxFIFO, SCISlaveResponseBuilder( pui8Buf, &sSciSlave.sSciTransfer.sResponseControl));
-
-                // Reset the ongoing flag when no data is left to transmit
-                if (sSciSlave.sSciTransfer.sResponseControl.sRsp.sTransferData.ui32DatLen == 0)
-                    SCISlaveTransferClearResponseControl(&sSciSlave.sSciTransfer);
-
-                /// @todo Error handling -> Message too long
-
-                if (SCIDatalinkTransmit(&sSciSlave.sDatalink, &sSciSlave.sTxFIFO))
-                    sSciSlave.e_state = ePROTOCOL_SENDING;
-                /// @todo Error handling?
-                else 
-                    sSciSlave.e_state = ePROTOCOL_IDLE;  
+                // Free running upstream requests are answered by the chunks
+                if (eError == eSCI_SLAVE_ERROR_NONE && sSciSlave.sSciTransfer.sResponseControl.ui8ControlBits.noResponse)
+                {
+                    sSciSlave.sSciTransfer.sResponseControl.ui8ControlBits.noResponse = false;
+                    sSciSlave.e_state = ePROTOCOL_IDLE;
+                }
+                else
+                    _SCISlaveTransmitResponse();
             }
     
             break;
@@ -159,8 +221,10 @@ void SCISlaveStatemachine (void)
                 SCIDatalinkAcknowledgeTx(&sSciSlave.sDatalink);
                 sSciSlave.e_state = ePROTOCOL_IDLE;
 
-                // Clear Datalink State
-                SCIDatalinkStartRx(&sSciSlave.sDatalink);
+                // Clear Datalink State (A notification has been sent with the receiver armed,
+                // so a request could already be on its way)
+                if (sSciSlave.sDatalink.rState == eDATALINK_RSTATE_IDLE)
+                    SCIDatalinkStartRx(&sSciSlave.sDatalink);
             }
             
             break;
@@ -174,4 +238,125 @@ void SCISlaveStatemachine (void)
 teSCI_SLAVE_ERROR SCISlaveGetVarFromStruct(int16_t i16VarNum, tsSCIVAR* pVar)
 {
     return GetVar(&sSciSlave.sVarAccess, pVar, i16VarNum);
-}
\ No newline at end of file
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR SCISlaveSubscribeVar(int16_t i16VarNum, tuREQUESTVALUE uDeadband)
+{
+    return SCISlaveNotifySubscribe(&sSciSlave.sNotify, &sSciSlave.sVarAccess, i16VarNum, uDeadband);
+}
+
+//=============================================================================
+void SCISlaveUnsubscribeVar(int16_t i16VarNum)
+{
+    SCISlaveNotifyUnsubscribe(&sSciSlave.sNotify, i16VarNum);
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR SCISlaveCompleteCommand(int16_t i16CmdNum, teREQUEST_ACKNOWLEDGE eAck, const tuRESPONSEVALUE *puVals, uint8_t ui8ValCnt, uint16_t ui16Error)
+{
+    return SCISlaveTransferCompleteCommand(&sSciSlave.sSciTransfer, i16CmdNum, eAck, puVals, ui8ValCnt, ui16Error);
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR SCISlaveVarUpdated(int16_t i16VarNum)
+{
+    #ifdef EEPROM_WRITE_BACK
+    if (i16VarNum > 0 && i16VarNum <= SIZE_OF_VAR_STRUCT && 
+        sSciSlave.sVarAccess.pVarStruct[i16VarNum - 1].eVartype == eVARTYPE_EEPROM)
+        MarkEEPROMDirty(&sSciSlave.sVarAccess, i16VarNum);
+    #endif
+
+    return MarkVarModified(&sSciSlave.sVarAccess, i16VarNum);
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR SCISlaveEEPROMFlush(void)
+{
+    return FlushEEPROM(&sSciSlave.sVarAccess, true);
+}
+
+//=============================================================================
+uint8_t SCISlaveEEPROMGetDirtyCount(void)
+{
+    return GetEEPROMDirtyCount(&sSciSlave.sVarAccess);
+}
+
+//=============================================================================
+uint32_t SCISlaveEEPROMGetFailCount(void)
+{
+    return GetEEPROMFlushFailCount(&sSciSlave.sVarAccess);
+}
+
+//=============================================================================
+#ifdef VALUE_MODE_HEX
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMFlush(uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+#else
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMFlush(float* pf_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+#endif
+{
+    teSCI_SLAVE_ERROR eError = SCISlaveEEPROMFlush();
+
+    #ifdef VALUE_MODE_HEX
+    (void)pui32_valArray;
+    #else
+    (void)pf_valArray;
+    #endif
+    (void)ui8_valArrayLen;
+
+    if (eError != eSCI_SLAVE_ERROR_NONE)
+    {
+        psData->ui16Error = GET_SCI_ERROR_NUMBER((uint16_t)eError);
+        return eREQUEST_ACK_STATUS_ERROR;
+    }
+
+    return eREQUEST_ACK_STATUS_SUCCESS;
+}
+
+//=============================================================================
+#ifdef VALUE_MODE_HEX
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMDirtyCount(uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+#else
+teREQUEST_ACKNOWLEDGE SCISlaveCmdEEPROMDirtyCount(float* pf_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+#endif
+{
+    #ifdef VALUE_MODE_HEX
+    (void)pui32_valArray;
+    #else
+    (void)pf_valArray;
+    #endif
+    (void)ui8_valArrayLen;
+
+    #ifdef VALUE_MODE_HEX
+    psData->puRespVals[0].ui32_hex = SCISlaveEEPROMGetDirtyCount();
+    #else
+    psData->puRespVals[0].f_float = (float)SCISlaveEEPROMGetDirtyCount();
+    #endif
+    psData->ui32DatLen = 1;
+
+    return eREQUEST_ACK_STATUS_SUCCESS_DATA;
+}
+
+//=============================================================================
+static void _SCISlaveTransmitResponse (void)
+{
+    tsRESPONSECONTROL *psControl = &sSciSlave.sSciTransfer.sResponseControl;
+
+    flushBuf(&sSciSlave.sTxFIFO);
+
+    // "Put" the date into the tx buffer
+    increaseBufIdx(&sSciSlave.sTxFIFO, SCISlaveResponseBuilder(sSciSlave.ui8TxBuffer, psControl));
+
+    // Reset the ongoing flag when no data is left to transmit (an upstream requested with offsets
+    // is kept until the master acknowledges the last chunk, it may request it again)
+    if (psControl->sRsp.sTransferData.ui32DatLen == 0 && !psControl->ui8ControlBits.acknowledged)
+        SCISlaveTransferClearResponseControl(&sSciSlave.sSciTransfer);
+
+    /// @todo Error handling -> Message too long
+
+    if (SCIDatalinkTransmit(&sSciSlave.sDatalink, &sSciSlave.sTxFIFO))
+        sSciSlave.e_state = ePROTOCOL_SENDING;
+    /// @todo Error handling?
+    else 
+        sSciSlave.e_state = ePROTOCOL_IDLE;  
+}
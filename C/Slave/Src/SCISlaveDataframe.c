@@ -27,15 +27,24 @@
  * Global variable definition
  *****************************************************************************/
 // Note: The idizes correspond to the values of the C enum values!
-static const char cAcknowledgeArr [5][4] = {"ACK", "DAT", "UPS", "ERR", "NAK"};
-static const uint8_t ui8CmdIdArr[6] = { UNKNOWN_IDENTIFIER, 
+static const char cAcknowledgeArr [6][4] = {"ACK", "DAT", "UPS", "ERR", "NAK", "PND"};
+static const uint8_t ui8CmdIdArr[10] = { UNKNOWN_IDENTIFIER, 
                                         GETVAR_IDENTIFIER,
                                         SETVAR_IDENTIFIER,
                                         COMMAND_IDENTIFIER,
                                         UPSTREAM_IDENTIFIER,
-                                        DOWNSTREAM_IDENTIFIER};
+                                        DOWNSTREAM_IDENTIFIER,
+                                        NOTIFY_IDENTIFIER,
+                                        DELTA_IDENTIFIER,
+                                        MEMORY_IDENTIFIER,
+                                        COMPLETE_IDENTIFIER};
 // const uint8_t ui8_byteLength[7] = {1,1,2,2,4,4,4};
 
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static uint8_t _SCIBuildDataResponse(uint8_t *pui8Buf, uint8_t ui8MaxSize, tsRESPONSECONTROL *psResponseControl);
+
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
@@ -73,7 +82,17 @@ teSCI_SLAVE_ERROR SCISlaveRequestParser(uint8_t* pui8Buf, uint8_t ui8StringSize,
         {
             psReq->eReqType = eREQUEST_TYPE_DOWNSTREAM;
             break;
-        }      
+        }
+        else if (pui8Buf[i] == DELTA_IDENTIFIER)
+        {
+            psReq->eReqType = eREQUEST_TYPE_DELTA;
+            break;
+        }
+        else if (pui8Buf[i] == MEMORY_IDENTIFIER)
+        {
+            psReq->eReqType = eREQUEST_TYPE_MEMORY;
+            break;
+        }
     }
 
     // No valid command identifier found (TODO: Error handling)
@@ -105,6 +124,28 @@ teSCI_SLAVE_ERROR SCISlaveRequestParser(uint8_t* pui8Buf, uint8_t ui8StringSize,
         free(p_numStr);
     }
 
+    /*******************************************************************************************
+     * DOWNSTREAM chunk data (hex digits after the ';', converted in place)
+    *******************************************************************************************/
+    if (psReq->eReqType == eREQUEST_TYPE_DOWNSTREAM)
+    {
+        for (uint8_t k = i + 1; k < ui8StringSize; k++)
+        {
+            if (pui8Buf[k] == ';')
+            {
+                if (!strToHexBytes(&pui8Buf[k + 1], ui8StringSize - k - 1, &pui8Buf[k + 1]))
+                    return eSCI_SLAVE_ERROR_REQUEST_VALUE_CONVERSION_FAILED;
+
+                psReq->pui8Data     = &pui8Buf[k + 1];
+                psReq->ui8DataLen   = (ui8StringSize - k - 1) / 2;
+
+                // Only the offset is left for the value conversion
+                ui8StringSize = k;
+                break;
+            }
+        }
+    }
+
     /************************************s*******************************************************
      * Variable value conversion
     *******************************************************************************************/
@@ -117,7 +158,7 @@ teSCI_SLAVE_ERROR SCISlaveRequestParser(uint8_t* pui8Buf, uint8_t ui8StringSize,
         uint8_t ui8_valueLen = 0;
         uint8_t *p_valStr = NULL;
 
-        while (ui8NumOfVals <= MAX_NUM_REQUEST_VALUES)
+        while (ui8NumOfVals < MAX_NUM_REQUEST_VALUES)
         {
             ui8NumOfVals++;
 
@@ -163,6 +204,7 @@ teSCI_SLAVE_ERROR SCISlaveRequestParser(uint8_t* pui8Buf, uint8_t ui8StringSize,
 uint8_t SCISlaveResponseBuilder(uint8_t *pui8Buf, tsRESPONSECONTROL *psResponseControl)
 {
     uint8_t ui8_size    = 0;
+    uint8_t ui8AsciiSize;
 
     // Convert variable number to ASCII
     #ifdef VALUE_MODE_HEX
@@ -182,6 +224,13 @@ uint8_t SCISlaveResponseBuilder(uint8_t *pui8Buf, tsRESPONSECONTROL *psResponseC
         switch (psResponseControl->sRsp.eReqType)
         {
             case eREQUEST_TYPE_GETVAR:
+                // Arrays, 64 bit variables and variable lists are sent like command data
+                if (psResponseControl->ui8ControlBits.varWords || psResponseControl->sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA)
+                {
+                    ui8_size += _SCIBuildDataResponse(pui8Buf, TX_PACKET_LENGTH - ui8_size, psResponseControl);
+                    break;
+                }
+
                 // Fill the response designator
                 memcpy(pui8Buf, &cAcknowledgeArr[(uint8_t)eREQUEST_ACK_STATUS_SUCCESS], 3);
                 pui8Buf+=3;
@@ -202,43 +251,48 @@ uint8_t SCISlaveResponseBuilder(uint8_t *pui8Buf, tsRESPONSECONTROL *psResponseC
                 ui8_size += 3;
                 break;
 
+            case eREQUEST_TYPE_DOWNSTREAM:
+                // Acknowledge with the next offset the slave expects
+                memcpy(pui8Buf, &cAcknowledgeArr[(uint8_t)eREQUEST_ACK_STATUS_SUCCESS], 3);
+                pui8Buf+=3;
+                *pui8Buf++ = ';';
+                ui8_size += 4;
+                #ifdef VALUE_MODE_HEX
+                ui8_size += (uint8_t)hexToStrDword(pui8Buf, &psResponseControl->sRsp.sTransferData.puRespVals[0].ui32_hex, true);
+                #else
+                ui8_size += ftoa(pui8Buf, (float)psResponseControl->sRsp.sTransferData.puRespVals[0].ui32_hex, true);
+                #endif
+                break;
+
             case eREQUEST_TYPE_COMMAND:
-                // No response designator on every consecutive packet
-                if (psResponseControl->ui8ControlBits.firstPacketNotSent)
-                {
-                    memcpy(pui8Buf, &cAcknowledgeArr[(uint8_t)psResponseControl->sRsp.eReqAck], 3);
-                    pui8Buf+=3;
-                    ui8_size += 3;
+            case eREQUEST_TYPE_MEMORY:
+                ui8_size += _SCIBuildDataResponse(pui8Buf, TX_PACKET_LENGTH - ui8_size, psResponseControl);
+                break;
+            
+            case eREQUEST_TYPE_DELTA:
+                memcpy(pui8Buf, &cAcknowledgeArr[(uint8_t)psResponseControl->sRsp.eReqAck], 3);
+                pui8Buf+=3;
+                *pui8Buf++ = ';';
+                ui8_size += 4;
 
-                    if (psResponseControl->sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA ||psResponseControl->sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM)
-                    {
-                        uint8_t ui8AsciiSize;
-
-                        *pui8Buf++ = ';';
-                        ui8_size++;
-                        #ifdef VALUE_MODE_HEX
-                        ui8AsciiSize = (uint8_t)hexToStrDword(pui8Buf, &psResponseControl->sRsp.sTransferData.ui32DatLen, true);
-                        #else
-                        ui8AsciiSize = ftoa(pui8Buf, (float)psResponseControl->sRsp.sTransferData.ui32_datLen, true);
-                        #endif
-                        pui8Buf += ui8AsciiSize;
-                        ui8_size += ui8AsciiSize;
-                    }
-                }
+                // Generation the master is synchronized to after this response
+                #ifdef VALUE_MODE_HEX
+                ui8AsciiSize = (uint8_t)hexToStrDword(pui8Buf, &psResponseControl->sRsp.sTransferData.ui32Generation, true);
+                #else
+                ui8AsciiSize = ftoa(pui8Buf, (float)psResponseControl->sRsp.sTransferData.ui32Generation, true);
+                #endif
+                pui8Buf += ui8AsciiSize;
+                ui8_size += ui8AsciiSize;
 
-                // Fill the rest of the packet with data
-                if (psResponseControl->ui8ControlBits.ongoing)
+                // Number / value pairs
+                if (psResponseControl->sRsp.sTransferData.ui32DatLen > 0)
                 {
-                    if(psResponseControl->ui8ControlBits.firstPacketNotSent)
-                    {
-                        *pui8Buf++ = ';';
-                        ui8_size++;
-                    }
+                    *pui8Buf++ = ';';
+                    ui8_size++;
                     ui8_size += _SCIFillBufferWithValues(pui8Buf, TX_PACKET_LENGTH - ui8_size, psResponseControl);
                 }
-
                 break;
-            
+
             case eREQUEST_TYPE_UPSTREAM:
                 // upstream is sent without command ID overhead
                 pui8Buf -= ui8_size;
@@ -279,6 +333,55 @@ uint8_t SCISlaveResponseBuilder(uint8_t *pui8Buf, tsRESPONSECONTROL *psResponseC
 
 }
 
+//=============================================================================
+uint8_t SCISlaveNotificationBuilder(uint8_t *pui8Buf, int16_t i16Num, tuRESPONSEVALUE uVal)
+{
+    uint8_t ui8_size = 0;
+
+    // Convert variable number to ASCII
+    #ifdef VALUE_MODE_HEX
+    ui8_size = (uint8_t)hexToStrWord(pui8Buf, (uint16_t*)&i16Num, true);
+    #else
+    ui8_size = ftoa(pui8Buf, (float)i16Num, true);
+    #endif
+
+    pui8Buf += ui8_size;
+    *pui8Buf++ = ui8CmdIdArr[eREQUEST_TYPE_NOTIFY];
+    ui8_size++;
+
+    // Notifications carry no acknowledge, just the new value
+    #ifdef VALUE_MODE_HEX
+    ui8_size += (uint8_t)hexToStrDword(pui8Buf, &uVal.ui32_hex, true);
+    #else
+    ui8_size += ftoa(pui8Buf, uVal.f_float, true);
+    #endif
+
+    return ui8_size;
+}
+
+//=============================================================================
+uint8_t SCISlaveCompletionBuilder(uint8_t *pui8Buf, int16_t i16Num, teREQUEST_ACKNOWLEDGE eAck)
+{
+    uint8_t ui8_size = 0;
+
+    // Convert command number to ASCII
+    #ifdef VALUE_MODE_HEX
+    ui8_size = (uint8_t)hexToStrWord(pui8Buf, (uint16_t*)&i16Num, true);
+    #else
+    ui8_size = ftoa(pui8Buf, (float)i16Num, true);
+    #endif
+
+    pui8Buf += ui8_size;
+    *pui8Buf++ = ui8CmdIdArr[eREQUEST_TYPE_COMPLETE];
+    ui8_size++;
+
+    // The results are fetched by repeating the command, just the outcome is announced
+    memcpy(pui8Buf, &cAcknowledgeArr[(uint8_t)eAck], 3);
+    ui8_size += 3;
+
+    return ui8_size;
+}
+
 //=============================================================================
 uint8_t _SCIFillBufferWithValues(uint8_t * pui8Buf, uint8_t ui8MaxSize, tsRESPONSECONTROL *psResponseControl)
 {
@@ -286,14 +389,26 @@ uint8_t _SCIFillBufferWithValues(uint8_t * pui8Buf, uint8_t ui8MaxSize, tsRESPON
 
     if (psResponseControl->sRsp.eReqType == eREQUEST_TYPE_UPSTREAM)
     {
-        // Check if there is a valid buffer pointer passed
-        if (psResponseControl->sRsp.sTransferData.pui8UpStreamBuf == NULL)
+        tsTRANSFER_DATA *psData = &psResponseControl->sRsp.sTransferData;
+
+        // Check if there is a valid buffer pointer or source passed
+        if (psData->pui8UpStreamBuf == NULL && psData->cbUpStreamRead == NULL)
             return 0;
 
         // Upstream data does not get converted into an ASCII-stream
         // Determine the actual packet length
-        ui8MaxSize = psResponseControl->sRsp.sTransferData.ui32DatLen < ui8MaxSize ? psResponseControl->sRsp.sTransferData.ui32DatLen : ui8MaxSize;
-        memcpy(pui8Buf, &psResponseControl->sRsp.sTransferData.pui8UpStreamBuf[psResponseControl->ui32DataIdx], ui8MaxSize);
+        ui8MaxSize = psData->ui32DatLen < ui8MaxSize ? psData->ui32DatLen : ui8MaxSize;
+
+        // The source is read packet by packet, directly into the tx buffer
+        if (psData->cbUpStreamRead != NULL)
+        {
+            uint8_t ui8Read = psData->cbUpStreamRead(psData->pUpStreamCtx, psResponseControl->ui32DataIdx, pui8Buf, ui8MaxSize);
+
+            if (ui8Read < ui8MaxSize)
+                memset(&pui8Buf[ui8Read], 0, ui8MaxSize - ui8Read);
+        }
+        else
+            memcpy(pui8Buf, &psData->pui8UpStreamBuf[psResponseControl->ui32DataIdx], ui8MaxSize);
 
         psResponseControl->sRsp.sTransferData.ui32DatLen -= ui8MaxSize;
         psResponseControl->ui32DataIdx += ui8MaxSize;
@@ -309,11 +424,16 @@ uint8_t _SCIFillBufferWithValues(uint8_t * pui8Buf, uint8_t ui8MaxSize, tsRESPON
         //     pui8Buf += 2;
         // }
     }
-    else if (psResponseControl->sRsp.eReqType == eREQUEST_TYPE_COMMAND)
+    else if (psResponseControl->sRsp.eReqType == eREQUEST_TYPE_COMMAND || psResponseControl->sRsp.eReqType == eREQUEST_TYPE_DELTA ||
+             psResponseControl->sRsp.eReqType == eREQUEST_TYPE_GETVAR)
     {
         bool    bCommaSet = false;
         uint8_t ui8AsciiSize;
         uint8_t ui8DataBuf[20];
+        tsTRANSFER_DATA *psData = &psResponseControl->sRsp.sTransferData;
+        tuRESPONSEVALUE *puVal;
+        tuRESPONSEVALUE uGenVals[SCI_RESPONSE_GEN_WINDOW];
+        uint8_t ui8GenIdx = 0, ui8GenCnt = 0, ui8PacketVals = 0;
 
         #ifndef VALUE_MODE_HEX
         float   f_passVal;
@@ -336,7 +456,48 @@ uint8_t _SCIFillBufferWithValues(uint8_t * pui8Buf, uint8_t ui8MaxSize, tsRESPON
                 break;
             }
 
-            ui8AsciiSize = (uint8_t)hexToStrDword(ui8DataBuf, (uint32_t*)&psResponseControl->sRsp.sTransferData.puRespVals[psResponseControl->ui32DataIdx], true);
+            // Variable words: The response values are refilled on the next request
+            if (psResponseControl->ui8ControlBits.varWords && psResponseControl->ui32DataIdx >= MAX_NUM_RESPONSE_VALUES)
+            {
+                if (bCommaSet)
+                {
+                    ui8_currentDataSize--;
+                    pui8Buf--;
+                }
+                break;
+            }
+
+            // Generated results: The window is refilled as long as the packet has room (the master takes
+            // up to MAX_NUM_RESPONSE_VALUES values per packet)
+            if (psResponseControl->ui8ControlBits.generated)
+            {
+                if (ui8PacketVals >= MAX_NUM_RESPONSE_VALUES)
+                {
+                    if (bCommaSet)
+                    {
+                        ui8_currentDataSize--;
+                        pui8Buf--;
+                    }
+                    break;
+                }
+
+                if (ui8GenIdx == ui8GenCnt)
+                {
+                    ui8GenCnt = MAX_NUM_RESPONSE_VALUES - ui8PacketVals < SCI_RESPONSE_GEN_WINDOW ? MAX_NUM_RESPONSE_VALUES - ui8PacketVals : SCI_RESPONSE_GEN_WINDOW;
+                    ui8GenCnt = psData->ui32DatLen < ui8GenCnt ? (uint8_t)psData->ui32DatLen : ui8GenCnt;
+                    ui8GenIdx = psData->cbRespGen(psData->pRespGenCtx, psResponseControl->ui32DataIdx, uGenVals, ui8GenCnt);
+
+                    // The master expects the announced number of values
+                    if (ui8GenIdx < ui8GenCnt)
+                        memset(&uGenVals[ui8GenIdx], 0, (ui8GenCnt - ui8GenIdx) * sizeof(tuRESPONSEVALUE));
+                    ui8GenIdx = 0;
+                }
+                puVal = &uGenVals[ui8GenIdx];
+            }
+            else
+                puVal = &psData->puRespVals[psResponseControl->ui32DataIdx];
+
+            ui8AsciiSize = (uint8_t)hexToStrDword(ui8DataBuf, (uint32_t*)puVal, true);
 
             // Fits the value in the buffer?
             if ((ui8_currentDataSize + ui8AsciiSize) < ui8MaxSize)
@@ -348,6 +509,8 @@ uint8_t _SCIFillBufferWithValues(uint8_t * pui8Buf, uint8_t ui8MaxSize, tsRESPON
                 // Handle all indices
                 psResponseControl->sRsp.sTransferData.ui32DatLen--;
                 psResponseControl->ui32DataIdx++;
+                ui8GenIdx++;
+                ui8PacketVals++;
                 pui8Buf += ui8AsciiSize;
 
                 if (ui8MaxSize > ui8_currentDataSize)
@@ -372,4 +535,45 @@ uint8_t _SCIFillBufferWithValues(uint8_t * pui8Buf, uint8_t ui8MaxSize, tsRESPON
     }
 
     return ui8_currentDataSize;
-}
\ No newline at end of file
+}
+
+//=============================================================================
+static uint8_t _SCIBuildDataResponse(uint8_t *pui8Buf, uint8_t ui8MaxSize, tsRESPONSECONTROL *psResponseControl)
+{
+    uint8_t ui8_size = 0;
+    uint8_t ui8AsciiSize;
+
+    // No response designator on every consecutive packet
+    if (psResponseControl->ui8ControlBits.firstPacketNotSent)
+    {
+        memcpy(pui8Buf, &cAcknowledgeArr[(uint8_t)psResponseControl->sRsp.eReqAck], 3);
+        pui8Buf+=3;
+        ui8_size += 3;
+
+        if (psResponseControl->sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA ||psResponseControl->sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM)
+        {
+            *pui8Buf++ = ';';
+            ui8_size++;
+            #ifdef VALUE_MODE_HEX
+            ui8AsciiSize = (uint8_t)hexToStrDword(pui8Buf, &psResponseControl->sRsp.sTransferData.ui32DatLen, true);
+            #else
+            ui8AsciiSize = ftoa(pui8Buf, (float)psResponseControl->sRsp.sTransferData.ui32_datLen, true);
+            #endif
+            pui8Buf += ui8AsciiSize;
+            ui8_size += ui8AsciiSize;
+        }
+    }
+
+    // Fill the rest of the packet with data
+    if (psResponseControl->ui8ControlBits.ongoing)
+    {
+        if(psResponseControl->ui8ControlBits.firstPacketNotSent)
+        {
+            *pui8Buf++ = ';';
+            ui8_size++;
+        }
+        ui8_size += _SCIFillBufferWithValues(pui8Buf, ui8MaxSize - ui8_size, psResponseControl);
+    }
+
+    return ui8_size;
+}
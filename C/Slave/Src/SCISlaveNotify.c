@@ -0,0 +1,153 @@
+/**************************************************************************//**
+ * \file SCISlaveNotify.c
+ * \author Roman Holderried
+ *
+ * \brief Change driven variable notifications of the SCI slave.
+ *
+ * <b> History </b>
+ * 	- 2026-10-19 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "SCISlaveNotify.h"
+#include "SCIVariables.h"
+#include "SCIconfig.h"
+
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static bool _DeadbandExceeded(const tsSCIVAR *psVar, uint32_t ui32Old, uint32_t ui32New, tuREQUESTVALUE uDeadband);
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+teSCI_SLAVE_ERROR SCISlaveNotifySubscribe(tsSCI_NOTIFY *psNotify, tsVAR_ACCESS *pVarAccess, int16_t i16VarNum, tuREQUESTVALUE uDeadband)
+{
+    tsSCI_SUBSCRIPTION *psFree = NULL;
+    tsSCI_SUBSCRIPTION *psSub = NULL;
+    teSCI_SLAVE_ERROR eError;
+
+    if (i16VarNum <= 0 || i16VarNum > SIZE_OF_VAR_STRUCT)
+        return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
+
+    for (uint8_t i = 0; i < MAX_NUMBER_OF_SUBSCRIPTIONS; i++)
+    {
+        if (psNotify->sSubscription[i].i16VarNum == i16VarNum)
+        {
+            psSub = &psNotify->sSubscription[i];
+            break;
+        }
+        else if (psNotify->sSubscription[i].i16VarNum == 0 && psFree == NULL)
+            psFree = &psNotify->sSubscription[i];
+    }
+
+    if (psSub == NULL)
+        psSub = psFree;
+
+    if (psSub == NULL)
+        return eSCI_SLAVE_ERROR_SUBSCRIPTION_TABLE_FULL;
+
+    eError = ReadRawFromVarStruct(pVarAccess, i16VarNum, &psSub->ui32Shadow);
+    if (eError != eSCI_SLAVE_ERROR_NONE)
+        return eError;
+
+    psSub->i16VarNum = i16VarNum;
+    psSub->uDeadband = uDeadband;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+void SCISlaveNotifyUnsubscribe(tsSCI_NOTIFY *psNotify, int16_t i16VarNum)
+{
+    tsSCI_SUBSCRIPTION cleanObj = tsSCI_SUBSCRIPTION_DEFAULTS;
+
+    for (uint8_t i = 0; i < MAX_NUMBER_OF_SUBSCRIPTIONS; i++)
+    {
+        if (psNotify->sSubscription[i].i16VarNum == i16VarNum)
+            psNotify->sSubscription[i] = cleanObj;
+    }
+}
+
+//=============================================================================
+bool SCISlaveNotifyCheck(tsSCI_NOTIFY *psNotify, tsVAR_ACCESS *pVarAccess, int16_t *pi16VarNum, uint32_t *pui32Val)
+{
+    uint32_t ui32Val;
+
+    for (uint8_t i = 0; i < MAX_NUMBER_OF_SUBSCRIPTIONS; i++)
+    {
+        tsSCI_SUBSCRIPTION *psSub = &psNotify->sSubscription[psNotify->ui8NextIdx];
+        const tsSCIVAR *psVar;
+
+        psNotify->ui8NextIdx = (psNotify->ui8NextIdx + 1) % MAX_NUMBER_OF_SUBSCRIPTIONS;
+
+        if (psSub->i16VarNum == 0)
+            continue;
+
+        psVar = &pVarAccess->pVarStruct[psSub->i16VarNum - 1];
+
+        if (ReadRawFromVarStruct(pVarAccess, psSub->i16VarNum, &ui32Val) != eSCI_SLAVE_ERROR_NONE)
+            continue;
+
+        if (_DeadbandExceeded(psVar, psSub->ui32Shadow, ui32Val, psSub->uDeadband))
+        {
+            *pi16VarNum = psSub->i16VarNum;
+            *pui32Val = ui32Val;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//=============================================================================
+void SCISlaveNotifyCommit(tsSCI_NOTIFY *psNotify, int16_t i16VarNum, uint32_t ui32Val)
+{
+    for (uint8_t i = 0; i < MAX_NUMBER_OF_SUBSCRIPTIONS; i++)
+    {
+        if (psNotify->sSubscription[i].i16VarNum == i16VarNum)
+            psNotify->sSubscription[i].ui32Shadow = ui32Val;
+    }
+}
+
+//=============================================================================
+static bool _DeadbandExceeded(const tsSCIVAR *psVar, uint32_t ui32Old, uint32_t ui32New, tuREQUESTVALUE uDeadband)
+{
+    switch (psVar->eDatatype)
+    {
+        case eDTYPE_UINT8:
+        case eDTYPE_UINT16:
+        case eDTYPE_UINT32:
+            return (ui32New > ui32Old ? ui32New - ui32Old : ui32Old - ui32New) > uDeadband.ui32_hex;
+
+        case eDTYPE_INT8:
+        case eDTYPE_INT16:
+        case eDTYPE_INT32:
+            {
+                // Signed values are sign extended, so the difference needs 33 bits
+                int64_t i64Diff = (int64_t)(int32_t)ui32New - (int64_t)(int32_t)ui32Old;
+                return (uint64_t)(i64Diff < 0 ? -i64Diff : i64Diff) > uDeadband.ui32_hex;
+            }
+
+        case eDTYPE_F32:
+            #ifdef SCI_NO_FLOAT
+            // Without float support, every change of a float variable is reported
+            return ui32New != ui32Old;
+            #else
+            {
+                tuREQUESTVALUE uOld = {.ui32_hex = ui32Old};
+                tuREQUESTVALUE uNew = {.ui32_hex = ui32New};
+                float fDiff = uNew.f_float - uOld.f_float;
+                return (fDiff < 0 ? -fDiff : fDiff) > uDeadband.f_float;
+            }
+            #endif
+
+        default:
+            return false;
+    }
+}
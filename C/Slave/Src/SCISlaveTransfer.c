@@ -31,11 +31,29 @@
  *****************************************************************************/
 extern const uint8_t ui8_byteLength[];
 
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static teSCI_SLAVE_ERROR _GetVarWords(tsSCI_TRANSFER_SLAVE *psTransfer, tsVAR_ACCESS *pVarAccess, tsREQUEST sReq);
+static teSCI_SLAVE_ERROR _GetVarList(tsSCI_TRANSFER_SLAVE *psTransfer, tsVAR_ACCESS *pVarAccess, tsREQUEST sReq);
+static teSCI_SLAVE_ERROR _ReadScalar(tsVAR_ACCESS *pVarAccess, int16_t i16Num, tuRESPONSEVALUE *puVal);
+static teSCI_SLAVE_ERROR _SetVarWords(tsVAR_ACCESS *pVarAccess, tsREQUEST sReq);
+static teSCI_SLAVE_ERROR _MemoryAccess(tsSCI_TRANSFER_SLAVE *psTransfer, tsREQUEST sReq);
+static teSCI_SLAVE_ERROR _Downstream(tsSCI_TRANSFER_SLAVE *psTransfer, tsREQUEST sReq);
+static teSCI_SLAVE_ERROR _UpstreamFromOffset(tsSCI_TRANSFER_SLAVE *psTransfer, tsREQUEST sReq);
+static tsSCI_PENDING_CMD* _FindPendingCmd(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t i16Num);
+static bool _AddPendingCmd(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t i16Num, const tsTRANSFER_DATA *psData);
+static teREQUEST_ACKNOWLEDGE _PollPendingCmd(tsSCI_PENDING_CMD *psPending, tsTRANSFER_DATA *psData);
+
 /******************************************************************************
  * Function definitions
  *****************************************************************************/
 void SCISlaveTransferInitiateResponse (tsSCI_TRANSFER_SLAVE *psTransfer, int16_t i16Num, teREQUEST_TYPE eReqType)
 {
+    // Any other request ends an upstream the master acknowledges
+    if (psTransfer->sResponseControl.ui8ControlBits.acknowledged && eReqType != eREQUEST_TYPE_UPSTREAM)
+        SCISlaveTransferClearResponseControl(psTransfer);
+
     psTransfer->sResponseControl.sRsp.i16Num = i16Num;
     psTransfer->sResponseControl.sRsp.eReqType = eReqType;
 }
@@ -43,7 +61,10 @@ void SCISlaveTransferInitiateResponse (tsSCI_TRANSFER_SLAVE *psTransfer, int16_t
 //=============================================================================
 void SCISlaveTransferSetError (tsSCI_TRANSFER_SLAVE *psTransfer, uint16_t ui16Error)
 {
+    // The acknowledge of a former response must not survive
+    psTransfer->sResponseControl.sRsp.eReqAck = eREQUEST_ACK_STATUS_ERROR;
     psTransfer->sResponseControl.sRsp.sTransferData.ui16Error = ui16Error;
+    psTransfer->sResponseControl.sRsp.sTransferData.ui32DatLen = 0;
 }
 
 //=============================================================================
@@ -52,55 +73,88 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
     // RESPONSE rsp = RESPONSE_DEFAULT;
     teSCI_SLAVE_ERROR eError = eSCI_SLAVE_ERROR_NONE;
 
+    // The response keeps the requested ID, the request is processed with the variable number
+    if (sReq.eReqType == eREQUEST_TYPE_GETVAR || sReq.eReqType == eREQUEST_TYPE_SETVAR)
+    {
+        sReq.i16Num = GetVarNumber((uint16_t)sReq.i16Num);
+
+        if (sReq.i16Num == 0)
+            return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
+    }
+
     switch (sReq.eReqType)
     {
 
         case eREQUEST_TYPE_GETVAR:
             {
-                float f_val = 0.0;
+                // Arrays and 64 bit variables are streamed like COMMAND data
+                if (!IsVarScalar(pVarAccess, sReq.i16Num))
+                {
+                    eError = _GetVarWords(psTransfer, pVarAccess, sReq);
+                    goto terminate;
+                }
 
-                // If there is no readEEPROM callback or this is no EEPROM var, simply skip this step
-                if (pVarAccess->pVarStruct[sReq.i16Num - 1].eVartype == eVARTYPE_EEPROM)
+                // A scalar GETVAR ends an interrupted array transfer
+                if (psTransfer->sResponseControl.ui8ControlBits.varWords)
+                    psTransfer->sResponseControl.ui8ControlByte = 0;
+
+                // Values: Variable list (SCI_VAR_LIST_MARKER and further variables read with this one)
+                if (sReq.ui8ValArrLen > 0)
                 {
-                    // If conditions are met, EEPROM read must be successful.
-                    eError = ReadEEPROMValueIntoVarStruct(pVarAccess, sReq.i16Num);
-                    if (eError != eSCI_SLAVE_ERROR_NONE)
-                        goto terminate;
+                    eError = _GetVarList(psTransfer, pVarAccess, sReq);
+                    goto terminate;
                 }
 
-                eError = ReadValFromVarStruct(pVarAccess, sReq.i16Num, &f_val);
+                eError = _ReadScalar(pVarAccess, sReq.i16Num, &psTransfer->sResponseControl.sRsp.sTransferData.puRespVals[0]);
                 if (eError != eSCI_SLAVE_ERROR_NONE)
                     goto terminate;
-                
-                psTransfer->sResponseControl.sRsp.sTransferData.puRespVals[0].f_float = f_val;
+
                 psTransfer->sResponseControl.sRsp.eReqAck = eREQUEST_ACK_STATUS_SUCCESS;   
             }
             break;
 
         case eREQUEST_TYPE_SETVAR:
             {
-                float f_formerVal, newVal = 0.0;
-                //bool writeSuccessful = false;
+                uint32_t ui32FormerVal;
+
+                if (!IsVarScalar(pVarAccess, sReq.i16Num))
+                {
+                    eError = _SetVarWords(pVarAccess, sReq);
+                    if (eError != eSCI_SLAVE_ERROR_NONE)
+                        goto terminate;
 
-                eError = ReadValFromVarStruct(pVarAccess, sReq.i16Num, &f_formerVal);
+                    if (pVarAccess->pVarStruct[sReq.i16Num - 1].ap != NULL)
+                        pVarAccess->pVarStruct[sReq.i16Num - 1].ap();
+
+                    psTransfer->sResponseControl.sRsp.eReqAck = eREQUEST_ACK_STATUS_SUCCESS;
+                    break;
+                }
+
+                // The former value is saved in its native width to restore it bit exact
+                eError = ReadRawFromVarStruct(pVarAccess, sReq.i16Num, &ui32FormerVal);
 
                 if (eError != eSCI_SLAVE_ERROR_NONE)
                     goto terminate;
 
                 // Read back actual value and write new one (write will only happen if read was successful)
-                eError = WriteValToVarStruct(pVarAccess, sReq.i16Num, sReq.uValArr[0].f_float);
+                eError = WriteValToVarStruct(pVarAccess, sReq.i16Num, sReq.uValArr[0]);
                 if (eError != eSCI_SLAVE_ERROR_NONE)
                     goto terminate;
 
                 // If the varStruct write operation was successful, trigger an EEPROM write (if callback present and variable is of type eVARTYPE_EEPROM)
                 if (pVarAccess->pVarStruct[sReq.i16Num - 1].eVartype == eVARTYPE_EEPROM)
                 {
+                    #ifdef EEPROM_WRITE_BACK
+                    // The EEPROM write is deferred to the idle time of the state machine
+                    eError = MarkEEPROMDirty(pVarAccess, sReq.i16Num);
+                    #else
                     // If conditions are met, write must be successful.
                     eError = WriteEEPROMwithValueFromVarStruct(pVarAccess, sReq.i16Num);
+                    #endif
                     if (eError != eSCI_SLAVE_ERROR_NONE)
                     {
                         // If the EEPROM write was not successful, write back the old value to the var struct to keep it in sync with the EEPROM.
-                        WriteValToVarStruct(pVarAccess, sReq.i16Num, f_formerVal);
+                        WriteRawToVarStruct(pVarAccess, sReq.i16Num, ui32FormerVal);
                         goto terminate;
                     }
                 }
@@ -109,10 +163,8 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
                 if (pVarAccess->pVarStruct[sReq.i16Num - 1].ap != NULL)
                     pVarAccess->pVarStruct[sReq.i16Num - 1].ap();
 
-                ReadValFromVarStruct(pVarAccess, sReq.i16Num, &newVal);
-
                 // If everything happens to be allright, create the response
-                psTransfer->sResponseControl.sRsp.sTransferData.puRespVals[0].f_float = newVal;
+                ReadValFromVarStruct(pVarAccess, sReq.i16Num, &psTransfer->sResponseControl.sRsp.sTransferData.puRespVals[0]);
                 psTransfer->sResponseControl.sRsp.eReqAck = eREQUEST_ACK_STATUS_SUCCESS;
             }
             break;
@@ -122,12 +174,24 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
                 teREQUEST_ACKNOWLEDGE eReqAck = eREQUEST_ACK_STATUS_UNKNOWN;
                 // tsTRANSFER_DATA sTransferData = tsTRANSFER_DATA_DEFAULTS;
                 // Determine if a new command has been sent or if the ongoing command is to be processed
-                bool bNewCmd = psTransfer->sResponseControl.ui8ControlBits.ongoing == false || (psTransfer->sResponseControl.sRsp.i16Num != sReq.i16Num);
+                bool bNewCmd = psTransfer->sResponseControl.ui8ControlBits.ongoing == false || (psTransfer->sResponseControl.sRsp.i16Num != sReq.i16Num) ||
+                    psTransfer->sResponseControl.ui8ControlBits.varWords;
 
                 if (bNewCmd)
                 {
+                    tsSCI_PENDING_CMD *psPending = _FindPendingCmd(psTransfer, sReq.i16Num);
+
+                    // A generator of an interrupted command must not leak into this one
+                    psTransfer->sResponseControl.sRsp.sTransferData.ui8InfoFlagBits.respGenerated = false;
+                    psTransfer->sResponseControl.sRsp.sTransferData.cbStep = NULL;
+
+                    // Repeating a pending command polls it instead of executing it again
+                    if (psPending != NULL)
+                    {
+                        eReqAck = _PollPendingCmd(psPending, &psTransfer->sResponseControl.sRsp.sTransferData);
+                    }
                     // Check if a command structure has been passed
-                    if (psTransfer->pCmdCBStruct != NULL && sReq.i16Num > 0 && sReq.i16Num <= SIZE_OF_CMD_STRUCT)
+                    else if (psTransfer->pCmdCBStruct != NULL && sReq.i16Num > 0 && sReq.i16Num <= SIZE_OF_CMD_STRUCT)
                     {
                         // TODO: Support for passing values to the command function
                         #ifdef VALUE_MODE_HEX
@@ -135,6 +199,13 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
                         #else
                         eReqAck = psTransfer->pCmdCBStruct[sReq.i16Num - 1](&sReq.uValArr[0].f_float,sReq.ui8ValArrLen, &psTransfer->sResponseControl.sRsp.sTransferData);
                         #endif
+
+                        // The command is completed later by the application
+                        if (eReqAck == eREQUEST_ACK_STATUS_PENDING && !_AddPendingCmd(psTransfer, sReq.i16Num, &psTransfer->sResponseControl.sRsp.sTransferData))
+                        {
+                            eError = eSCI_SLAVE_ERROR_PENDING_TABLE_FULL;
+                            goto terminate;
+                        }
                     }
                     else
                     {
@@ -149,6 +220,7 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
 
                     // Fill the response control struct
                     psTransfer->sResponseControl.ui8ControlBits.firstPacketNotSent  = true;
+                    psTransfer->sResponseControl.ui8ControlBits.varWords            = false;
                     psTransfer->sResponseControl.ui32DataIdx                        = 0;
                     
                     // Set the control bits if a data transfer has been initiated
@@ -156,10 +228,16 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
                         ((psTransfer->sResponseControl.sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS_DATA) && (psTransfer->sResponseControl.sRsp.sTransferData.ui32DatLen > 0));
                     psTransfer->sResponseControl.ui8ControlBits.upstream = 
                         ((psTransfer->sResponseControl.sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM) && (psTransfer->sResponseControl.sRsp.sTransferData.ui32DatLen > 0));
+                    psTransfer->sResponseControl.ui8ControlBits.generated = 
+                        psTransfer->sResponseControl.ui8ControlBits.ongoing && psTransfer->sResponseControl.sRsp.sTransferData.ui8InfoFlagBits.respGenerated &&
+                        (psTransfer->sResponseControl.sRsp.sTransferData.cbRespGen != NULL);
+
+                    // A data length without DAT / UPS acknowledge is not transferred
+                    if (!psTransfer->sResponseControl.ui8ControlBits.ongoing && !psTransfer->sResponseControl.ui8ControlBits.upstream)
+                        psTransfer->sResponseControl.sRsp.sTransferData.ui32DatLen = 0;
                     
                     // Save the response for later
                     // psTransfer->sResponseControl.sRsp = *psRsp;
-                    
                 }
                 else
                 {
@@ -170,11 +248,28 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
             }
             break;
         
+        case eREQUEST_TYPE_MEMORY:
+            eError = _MemoryAccess(psTransfer, sReq);
+            break;
+
+        case eREQUEST_TYPE_DOWNSTREAM:
+            eError = _Downstream(psTransfer, sReq);
+            break;
+
         case eREQUEST_TYPE_UPSTREAM:
 
             // Number must match with the previously sent command
             if (psTransfer->sResponseControl.sRsp.i16Num == sReq.i16Num && psTransfer->sResponseControl.ui8ControlBits.upstream == true)
             {
+                // Offset (and window) or acknowledge passed
+                if (sReq.ui8ValArrLen > 0)
+                {
+                    eError = _UpstreamFromOffset(psTransfer, sReq);
+                    break;
+                }
+
+                psTransfer->sResponseControl.ui8ControlBits.freeRunning = false;
+                psTransfer->sResponseControl.ui8ControlBits.acknowledged = false;
                 psTransfer->sResponseControl.sRsp.eReqAck   = eREQUEST_ACK_STATUS_SUCCESS;
                 // psRsp->sTransferData          = psTransfer->sResponseControl.sRsp.sTransferData;
                 // Change the command type
@@ -189,6 +284,51 @@ teSCI_SLAVE_ERROR SCISlaveTransferProcessRequest(tsSCI_TRANSFER_SLAVE *psTransfe
             }
             break;
 
+        case eREQUEST_TYPE_DELTA:
+            {
+                int16_t         i16VarNums[MAX_NUM_DELTA_PAIRS];
+                uint32_t        ui32Generation = 0;
+                uint32_t        ui32NewGeneration;
+                uint8_t         ui8Cnt;
+                tuRESPONSEVALUE *puRespVals = psTransfer->sResponseControl.sRsp.sTransferData.puRespVals;
+
+                // Without a generation passed, all variables are reported
+                if (sReq.ui8ValArrLen > 0)
+                {
+                    #ifdef VALUE_MODE_HEX
+                    ui32Generation = sReq.uValArr[0].ui32_hex;
+                    #else
+                    ui32Generation = (uint32_t)sReq.uValArr[0].f_float;
+                    #endif
+                }
+
+                ui8Cnt = GetModifiedVars(pVarAccess, ui32Generation, i16VarNums, MAX_NUM_DELTA_PAIRS, &ui32NewGeneration);
+
+                // Number / value pairs follow the generation
+                for (uint8_t i = 0; i < ui8Cnt; i++)
+                {
+                    puRespVals[2 * i].ui32_hex = GetVarId(i16VarNums[i]);
+
+                    // Arrays and 64 bit variables are reported with their first word,
+                    // the master fetches them with GETVAR.
+                    if (IsVarScalar(pVarAccess, i16VarNums[i]))
+                        eError = ReadValFromVarStruct(pVarAccess, i16VarNums[i], &puRespVals[2 * i + 1]);
+                    else
+                        eError = ReadVarWords(pVarAccess, i16VarNums[i], 0, &puRespVals[2 * i + 1], 1);
+                    if (eError != eSCI_SLAVE_ERROR_NONE)
+                        goto terminate;
+                }
+
+                psTransfer->sResponseControl.sRsp.sTransferData.ui32Generation = ui32NewGeneration;
+                psTransfer->sResponseControl.ui32DataIdx = 0;
+                psTransfer->sResponseControl.sRsp.sTransferData.ui32DatLen = 2 * ui8Cnt;
+
+                // DAT signals the master that there are more modifications to fetch
+                psTransfer->sResponseControl.sRsp.eReqAck = ui32NewGeneration < pVarAccess->ui32Generation ? 
+                    eREQUEST_ACK_STATUS_SUCCESS_DATA : eREQUEST_ACK_STATUS_SUCCESS;
+            }
+            break;
+
         default:
             // If COMMAND_TYPE_NONE, we don't kill ongoing data transmissions
             break;
@@ -212,4 +352,464 @@ void SCISlaveTransferClearResponseControl(tsSCI_TRANSFER_SLAVE *psTransfer)
 
     // Clean the structure
     memcpy(&psTransfer->sResponseControl, &cleanObj, sizeof(tsRESPONSECONTROL));
-}
\ No newline at end of file
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR SCISlaveTransferCompleteCommand(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t i16Num, teREQUEST_ACKNOWLEDGE eAck, 
+    const tuRESPONSEVALUE *puVals, uint8_t ui8ValCnt, uint16_t ui16Error)
+{
+    tsSCI_PENDING_CMD *psPending = _FindPendingCmd(psTransfer, i16Num);
+
+    // Sliced commands complete themselves
+    if (psPending == NULL || psPending->eAck != eREQUEST_ACK_STATUS_PENDING || psPending->cbStep != NULL)
+        return eSCI_SLAVE_ERROR_COMMAND_NOT_PENDING;
+
+    if (!(eAck == eREQUEST_ACK_STATUS_SUCCESS || eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA || eAck == eREQUEST_ACK_STATUS_ERROR))
+        return eSCI_SLAVE_ERROR_REQUEST_UNKNOWN;
+
+    if (eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA)
+    {
+        if (puVals == NULL || ui8ValCnt == 0 || ui8ValCnt > MAX_NUM_RESPONSE_VALUES)
+            return eSCI_SLAVE_ERROR_REQUEST_UNKNOWN;
+
+        memcpy(psPending->uVals, puVals, ui8ValCnt * sizeof(tuRESPONSEVALUE));
+        psPending->ui8ValCnt = ui8ValCnt;
+    }
+
+    psPending->ui16Error    = ui16Error;
+    psPending->eAck         = eAck;
+    psPending->bAnnounce    = true;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+bool SCISlaveTransferCheckCompletion(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t *pi16Num, teREQUEST_ACKNOWLEDGE *peAck)
+{
+    for (uint8_t i = 0; i < MAX_NUMBER_OF_PENDING_COMMANDS; i++)
+    {
+        tsSCI_PENDING_CMD *psPending = &psTransfer->sPendingCmd[i];
+
+        if (psPending->i16Num != 0 && psPending->bAnnounce)
+        {
+            psPending->bAnnounce = false;
+            *pi16Num = psPending->i16Num;
+            *peAck   = psPending->eAck;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//=============================================================================
+void SCISlaveTransferRunCommandSteps(tsSCI_TRANSFER_SLAVE *psTransfer, uint32_t ui32BudgetUs)
+{
+    uint32_t ui32Start  = psTransfer->cbGetTimeUs != NULL ? psTransfer->cbGetTimeUs() : 0;
+    uint32_t ui32Now    = ui32Start;
+    uint8_t  ui8Idle    = 0;
+    bool     bFirst     = true;
+
+    // Round robin over the sliced commands until the budget is spent
+    while (ui8Idle < MAX_NUMBER_OF_PENDING_COMMANDS)
+    {
+        tsSCI_PENDING_CMD *psPending = &psTransfer->sPendingCmd[psTransfer->ui8NextStepIdx];
+        psTransfer->ui8NextStepIdx = (psTransfer->ui8NextStepIdx + 1) % MAX_NUMBER_OF_PENDING_COMMANDS;
+
+        if (psPending->i16Num == 0 || psPending->cbStep == NULL || psPending->eAck != eREQUEST_ACK_STATUS_PENDING)
+        {
+            ui8Idle++;
+            continue;
+        }
+        ui8Idle = 0;
+
+        // Only one step without clock, further steps must end within the budget
+        if (!bFirst && (psTransfer->cbGetTimeUs == NULL || (uint32_t)(ui32Now - ui32Start) + psPending->ui32StepUs > ui32BudgetUs))
+        {
+            // The command is next on the following call
+            psTransfer->ui8NextStepIdx = (uint8_t)(psPending - psTransfer->sPendingCmd);
+            break;
+        }
+        bFirst = false;
+
+        psPending->eAck = psPending->cbStep(psPending->pStepCtx, psPending->uVals, &psPending->ui8ValCnt, &psPending->ui16Error);
+
+        if (psTransfer->cbGetTimeUs != NULL)
+        {
+            uint32_t ui32End = psTransfer->cbGetTimeUs();
+            psPending->ui32StepUs = ui32End - ui32Now;
+            ui32Now = ui32End;
+        }
+
+        if (psPending->eAck != eREQUEST_ACK_STATUS_PENDING)
+        {
+            // Same outcome as a completion by the application
+            if (psPending->ui8ValCnt > MAX_NUM_RESPONSE_VALUES)
+                psPending->ui8ValCnt = MAX_NUM_RESPONSE_VALUES;
+            psPending->cbStep       = NULL;
+            psPending->bAnnounce    = true;
+        }
+    }
+}
+
+//=============================================================================
+static tsSCI_PENDING_CMD* _FindPendingCmd(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t i16Num)
+{
+    for (uint8_t i = 0; i < MAX_NUMBER_OF_PENDING_COMMANDS; i++)
+    {
+        if (psTransfer->sPendingCmd[i].i16Num == i16Num && i16Num != 0)
+            return &psTransfer->sPendingCmd[i];
+    }
+
+    return NULL;
+}
+
+//=============================================================================
+static bool _AddPendingCmd(tsSCI_TRANSFER_SLAVE *psTransfer, int16_t i16Num, const tsTRANSFER_DATA *psData)
+{
+    tsSCI_PENDING_CMD cleanObj = tsSCI_PENDING_CMD_DEFAULTS;
+
+    for (uint8_t i = 0; i < MAX_NUMBER_OF_PENDING_COMMANDS; i++)
+    {
+        if (psTransfer->sPendingCmd[i].i16Num == 0)
+        {
+            psTransfer->sPendingCmd[i] = cleanObj;
+            psTransfer->sPendingCmd[i].i16Num   = i16Num;
+            psTransfer->sPendingCmd[i].cbStep   = psData->cbStep;
+            psTransfer->sPendingCmd[i].pStepCtx = psData->pStepCtx;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//=============================================================================
+static teREQUEST_ACKNOWLEDGE _PollPendingCmd(tsSCI_PENDING_CMD *psPending, tsTRANSFER_DATA *psData)
+{
+    tsSCI_PENDING_CMD cleanObj = tsSCI_PENDING_CMD_DEFAULTS;
+    teREQUEST_ACKNOWLEDGE eAck = psPending->eAck;
+
+    if (eAck == eREQUEST_ACK_STATUS_PENDING)
+        return eAck;
+
+    // Hand over the result, the slot is released once the result has been fetched
+    psData->ui32DatLen = 0;
+    if (eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA)
+    {
+        memcpy(psData->puRespVals, psPending->uVals, psPending->ui8ValCnt * sizeof(tuRESPONSEVALUE));
+        psData->ui32DatLen = psPending->ui8ValCnt;
+    }
+    psData->ui16Error = psPending->ui16Error;
+
+    *psPending = cleanObj;
+
+    return eAck;
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _GetVarList(tsSCI_TRANSFER_SLAVE *psTransfer, tsVAR_ACCESS *pVarAccess, tsREQUEST sReq)
+{
+    tsRESPONSECONTROL *psControl = &psTransfer->sResponseControl;
+    tuRESPONSEVALUE *puRespVals = psControl->sRsp.sTransferData.puRespVals;
+    teSCI_SLAVE_ERROR eError;
+    uint32_t ui32Failed = 0;
+
+    // Request values of a scalar GETVAR are a variable list only behind the marker
+    #ifdef VALUE_MODE_HEX
+    if (sReq.uValArr[0].ui32_hex != SCI_VAR_LIST_MARKER)
+    #else
+    if (sReq.uValArr[0].f_float != (float)SCI_VAR_LIST_MARKER)
+    #endif
+        return eSCI_SLAVE_ERROR_VAR_LIST_INVALID;
+
+    // All values and the status word must fit into one message
+    if (sReq.ui8ValArrLen > SCI_VAR_LIST_MAX_CNT)
+        return eSCI_SLAVE_ERROR_VAR_LIST_TOO_LONG;
+
+    // A variable that can't be read doesn't fail the others: Its status bit is set, the value is the error
+    for (uint8_t i = 0; i < sReq.ui8ValArrLen; i++)
+    {
+        int16_t i16Num = sReq.i16Num;
+
+        if (i > 0)
+        {
+            #ifdef VALUE_MODE_HEX
+            i16Num = GetVarNumber((uint16_t)sReq.uValArr[i].ui32_hex);
+            #else
+            i16Num = GetVarNumber((uint16_t)sReq.uValArr[i].f_float);
+            #endif
+        }
+
+        if (i16Num == 0)
+            eError = eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
+        else if (!IsVarScalar(pVarAccess, i16Num))
+            eError = eSCI_SLAVE_ERROR_VAR_NOT_SCALAR;
+        else
+            eError = _ReadScalar(pVarAccess, i16Num, &puRespVals[i + 1]);
+
+        if (eError != eSCI_SLAVE_ERROR_NONE)
+        {
+            ui32Failed |= 1UL << i;
+            puRespVals[i + 1].ui32_hex = eError + SCI_ERROR_OFFSET;
+        }
+    }
+    puRespVals[0].ui32_hex = ui32Failed;
+
+    // Sent like command data
+    psControl->ui8ControlByte                   = 0;
+    psControl->ui8ControlBits.firstPacketNotSent= true;
+    psControl->ui8ControlBits.ongoing           = true;
+    psControl->ui32DataIdx                      = 0;
+    psControl->sRsp.sTransferData.ui32DatLen    = sReq.ui8ValArrLen + 1;
+    psControl->sRsp.eReqAck                     = eREQUEST_ACK_STATUS_SUCCESS_DATA;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _ReadScalar(tsVAR_ACCESS *pVarAccess, int16_t i16Num, tuRESPONSEVALUE *puVal)
+{
+    // If there is no readEEPROM callback or this is no EEPROM var, simply skip this step.
+    // The read is also skipped if the RAM value is still valid (see EEPROM_READ_POLICY).
+    if (pVarAccess->pVarStruct[i16Num - 1].eVartype == eVARTYPE_EEPROM &&
+        !IsEEPROMValueCached(pVarAccess, i16Num))
+    {
+        // If conditions are met, EEPROM read must be successful.
+        teSCI_SLAVE_ERROR eError = ReadEEPROMValueIntoVarStruct(pVarAccess, i16Num);
+        if (eError != eSCI_SLAVE_ERROR_NONE)
+            return eError;
+    }
+
+    return ReadValFromVarStruct(pVarAccess, i16Num, puVal);
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _GetVarWords(tsSCI_TRANSFER_SLAVE *psTransfer, tsVAR_ACCESS *pVarAccess, tsREQUEST sReq)
+{
+    tsRESPONSECONTROL *psControl = &psTransfer->sResponseControl;
+    uint8_t ui8WordCnt;
+
+    // Requests without values continue an ongoing transfer
+    if (psControl->ui8ControlBits.ongoing && psControl->ui8ControlBits.varWords && sReq.ui8ValArrLen == 0)
+    {
+        psControl->ui8ControlBits.firstPacketNotSent = false;
+        psControl->ui32VarWordIdx += psControl->ui32DataIdx;
+    }
+    else
+    {
+        uint16_t ui16ElemCnt    = GetVarElementCount(pVarAccess, sReq.i16Num);
+        uint8_t  ui8ElemWords   = GetVarElementWords(pVarAccess, sReq.i16Num);
+        uint32_t ui32Start      = 0;
+        uint32_t ui32Cnt        = ui16ElemCnt;
+
+        // Optional slice: First element, number of elements
+        if (sReq.ui8ValArrLen > 0)
+        {
+            ui32Start = sReq.uValArr[0].ui32_hex;
+            ui32Cnt = sReq.ui8ValArrLen > 1 ? sReq.uValArr[1].ui32_hex : ui16ElemCnt - ui32Start;
+        }
+
+        if (ui32Cnt == 0 || ui32Start >= ui16ElemCnt || ui32Cnt > ui16ElemCnt - ui32Start)
+            return eSCI_SLAVE_ERROR_ARRAY_RANGE_INVALID;
+
+        psControl->ui8ControlByte                   = 0;
+        psControl->ui8ControlBits.firstPacketNotSent= true;
+        psControl->ui8ControlBits.ongoing           = true;
+        psControl->ui8ControlBits.varWords          = true;
+        psControl->ui32VarWordIdx                   = ui32Start * ui8ElemWords;
+        psControl->sRsp.sTransferData.ui32DatLen    = ui32Cnt * ui8ElemWords;
+        psControl->sRsp.eReqAck                     = eREQUEST_ACK_STATUS_SUCCESS_DATA;
+    }
+
+    // The response values hold the next words to send
+    psControl->ui32DataIdx = 0;
+    ui8WordCnt = psControl->sRsp.sTransferData.ui32DatLen < MAX_NUM_RESPONSE_VALUES ? 
+        (uint8_t)psControl->sRsp.sTransferData.ui32DatLen : MAX_NUM_RESPONSE_VALUES;
+
+    return ReadVarWords(pVarAccess, sReq.i16Num, psControl->ui32VarWordIdx, psControl->sRsp.sTransferData.puRespVals, ui8WordCnt);
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _SetVarWords(tsVAR_ACCESS *pVarAccess, tsREQUEST sReq)
+{
+    uint8_t ui8ElemWords = GetVarElementWords(pVarAccess, sReq.i16Num);
+
+    // First value: Element index, followed by complete elements
+    if (sReq.ui8ValArrLen < 2 || (sReq.ui8ValArrLen - 1) % ui8ElemWords != 0)
+        return eSCI_SLAVE_ERROR_ARRAY_RANGE_INVALID;
+
+    if (sReq.uValArr[0].ui32_hex >= GetVarElementCount(pVarAccess, sReq.i16Num))
+        return eSCI_SLAVE_ERROR_ARRAY_RANGE_INVALID;
+
+    return WriteVarWords(pVarAccess, sReq.i16Num, sReq.uValArr[0].ui32_hex * ui8ElemWords, &sReq.uValArr[1], sReq.ui8ValArrLen - 1);
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _MemoryAccess(tsSCI_TRANSFER_SLAVE *psTransfer, tsREQUEST sReq)
+{
+    tsRESPONSECONTROL *psControl = &psTransfer->sResponseControl;
+    const tsSCI_MEM_WINDOW *psWindow;
+    uint32_t ui32Offset, ui32Len;
+
+    if (sReq.i16Num <= 0 || sReq.i16Num > psTransfer->ui8MemWindowCnt)
+        return eSCI_SLAVE_ERROR_MEM_WINDOW_INVALID;
+
+    psWindow = &psTransfer->pMemWindows[sReq.i16Num - 1];
+
+    // Offset and byte count, followed by the data of a write request
+    if (sReq.ui8ValArrLen < 2)
+        return eSCI_SLAVE_ERROR_MEM_ACCESS_INVALID;
+
+    ui32Offset  = sReq.uValArr[0].ui32_hex;
+    ui32Len     = sReq.uValArr[1].ui32_hex;
+
+    if (ui32Len == 0 || ui32Offset > psWindow->ui32Size || ui32Len > psWindow->ui32Size - ui32Offset)
+        return eSCI_SLAVE_ERROR_MEM_ACCESS_INVALID;
+
+    psControl->ui8ControlByte                   = 0;
+    psControl->ui8ControlBits.firstPacketNotSent= true;
+    psControl->ui32DataIdx                      = 0;
+
+    // Read: The upstream is served directly from the window
+    if (sReq.ui8ValArrLen == 2)
+    {
+        if (!(psWindow->ui8Access & SCI_MEM_ACCESS_READ))
+            return eSCI_SLAVE_ERROR_MEM_ACCESS_INVALID;
+
+        psControl->ui8ControlBits.upstream                              = true;
+        psControl->sRsp.sTransferData.ui8InfoFlagBits.upstreamBufDynamic= false;
+        psControl->sRsp.sTransferData.ui8InfoFlagBits.respGenerated     = false;
+        psControl->sRsp.sTransferData.pui8UpStreamBuf                   = &psWindow->pui8Base[ui32Offset];
+        psControl->sRsp.sTransferData.cbUpStreamRead                    = NULL;
+        psControl->sRsp.sTransferData.ui32DatLen                        = ui32Len;
+        psControl->sRsp.eReqAck                                         = eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM;
+
+        return eSCI_SLAVE_ERROR_NONE;
+    }
+
+    // Write: 4 bytes per request value, LSB first (ui8ValArrLen >= 2 checked above)
+    if (!(psWindow->ui8Access & SCI_MEM_ACCESS_WRITE) || (uint32_t)(sReq.ui8ValArrLen - 2) != (ui32Len + 3) / 4)
+        return eSCI_SLAVE_ERROR_MEM_ACCESS_INVALID;
+
+    for (uint32_t i = 0; i < ui32Len; i++)
+        psWindow->pui8Base[ui32Offset + i] = (uint8_t)(sReq.uValArr[2 + i / 4].ui32_hex >> ((i % 4) * 8));
+
+    psControl->sRsp.eReqAck = eREQUEST_ACK_STATUS_SUCCESS;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _UpstreamFromOffset(tsSCI_TRANSFER_SLAVE *psTransfer, tsREQUEST sReq)
+{
+    tsRESPONSECONTROL *psControl = &psTransfer->sResponseControl;
+    uint32_t ui32Size = psControl->ui32DataIdx + psControl->sRsp.sTransferData.ui32DatLen;
+    uint32_t ui32Offset = sReq.uValArr[sReq.ui8ValArrLen > 1 ? 1 : 0].ui32_hex;
+
+    psControl->sRsp.eReqAck = eREQUEST_ACK_STATUS_SUCCESS;
+
+    // Window (0: One chunk per request) and the offset to continue from. Data that has
+    // not been sent yet can't be skipped, sent data is repeated (resumed transfers).
+    if (sReq.ui8ValArrLen > 1)
+    {
+        if (sReq.uValArr[0].ui32_hex > UINT8_MAX || ui32Offset > psControl->ui32DataIdx)
+            return eSCI_SLAVE_ERROR_UPSTREAM_WINDOW_INVALID;
+
+        psControl->ui8Window                        = (uint8_t)sReq.uValArr[0].ui32_hex;
+        psControl->ui32DataIdx                      = ui32Offset;
+        psControl->ui32AckIdx                       = ui32Offset;
+        psControl->sRsp.sTransferData.ui32DatLen    = ui32Size - ui32Offset;
+        psControl->ui8ControlBits.acknowledged      = true;
+        psControl->ui8ControlBits.freeRunning       = psControl->ui8Window > 0;
+
+        // Free running: The chunks are sent by the state machine as long as the window allows it
+        psControl->ui8ControlBits.noResponse        = psControl->ui8ControlBits.freeRunning;
+
+        return eSCI_SLAVE_ERROR_NONE;
+    }
+
+    // Acknowledges are not answered (an error response would be taken for a chunk)
+    psControl->ui8ControlBits.noResponse = true;
+
+    if (!psControl->ui8ControlBits.acknowledged)
+        return eSCI_SLAVE_ERROR_NONE;
+
+    // All data has arrived (or the master has given up)
+    if (ui32Offset == ui32Size)
+    {
+        SCISlaveTransferClearResponseControl(psTransfer);
+        psControl->ui8ControlBits.noResponse = true;
+    }
+    // Offsets beyond the data sent are ignored
+    else if (ui32Offset >= psControl->ui32AckIdx && ui32Offset <= psControl->ui32DataIdx)
+        psControl->ui32AckIdx = ui32Offset;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _Downstream(tsSCI_TRANSFER_SLAVE *psTransfer, tsREQUEST sReq)
+{
+    tsSCI_DOWNSTREAM *psDownstream = &psTransfer->sDownstream;
+    uint32_t ui32Val;
+
+    if (psTransfer->cbDownstream == NULL)
+        return eSCI_SLAVE_ERROR_DOWNSTREAM_REJECTED;
+
+    // Announce: Total size / Chunk: Offset of the data
+    if (sReq.ui8ValArrLen != 1)
+        return eSCI_SLAVE_ERROR_DOWNSTREAM_RANGE_INVALID;
+
+    #ifdef VALUE_MODE_HEX
+    ui32Val = sReq.uValArr[0].ui32_hex;
+    #else
+    ui32Val = (uint32_t)sReq.uValArr[0].f_float;
+    #endif
+
+    if (sReq.pui8Data == NULL)
+    {
+        psDownstream->bActive = false;
+
+        if (ui32Val == 0)
+            return eSCI_SLAVE_ERROR_DOWNSTREAM_RANGE_INVALID;
+
+        if (!psTransfer->cbDownstream(sReq.i16Num, 0, NULL, 0, ui32Val))
+            return eSCI_SLAVE_ERROR_DOWNSTREAM_REJECTED;
+
+        psDownstream->i16Num    = sReq.i16Num;
+        psDownstream->ui32Size  = ui32Val;
+        psDownstream->ui32Offset= 0;
+        psDownstream->bActive   = true;
+    }
+    else
+    {
+        if (!psDownstream->bActive || psDownstream->i16Num != sReq.i16Num)
+            return eSCI_SLAVE_ERROR_DOWNSTREAM_NOT_INITIATED;
+
+        if (ui32Val > psDownstream->ui32Size || sReq.ui8DataLen > psDownstream->ui32Size - ui32Val)
+            return eSCI_SLAVE_ERROR_DOWNSTREAM_RANGE_INVALID;
+
+        // Repeated or early chunks (and chunks the sink can't take yet) are not consumed,
+        // the acknowledged offset tells the master where to continue
+        if (ui32Val == psDownstream->ui32Offset && sReq.ui8DataLen > 0 &&
+            psTransfer->cbDownstream(sReq.i16Num, ui32Val, sReq.pui8Data, sReq.ui8DataLen, psDownstream->ui32Size))
+        {
+            psDownstream->ui32Offset += sReq.ui8DataLen;
+        }
+    }
+
+    psTransfer->sResponseControl.sRsp.sTransferData.puRespVals[0].ui32_hex = psDownstream->ui32Offset;
+    psTransfer->sResponseControl.sRsp.eReqAck = eREQUEST_ACK_STATUS_SUCCESS;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+bool SCISlaveTransferUpstreamCredit(tsSCI_TRANSFER_SLAVE *psTransfer)
+{
+    tsRESPONSECONTROL *psControl = &psTransfer->sResponseControl;
+
+    return psControl->ui8ControlBits.freeRunning && psControl->sRsp.sTransferData.ui32DatLen > 0 &&
+        psControl->ui32DataIdx - psControl->ui32AckIdx < (uint32_t)psControl->ui8Window * TX_PACKET_LENGTH;
+}
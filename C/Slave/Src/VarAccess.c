@@ -16,14 +16,43 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <string.h>
 #include "SCIVarAccess.h"
 #include "SCIconfig.h"
 #include "SCICommon.h"
+#ifdef SCI_STATIC_VAR_LAYOUT
+#include "SCIVarTable.h"
+#endif
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#ifndef EEPROM_FLUSH_BACKOFF_MAX
+#define EEPROM_FLUSH_BACKOFF_MAX    8
+#endif
+
+// The backoff (2^n idle cycles) is counted in 16 bits
+#if EEPROM_FLUSH_BACKOFF_MAX > 15
+#error "EEPROM_FLUSH_BACKOFF_MAX must not exceed 15"
+#endif
 
 /******************************************************************************
  * Global variables definitions
  *****************************************************************************/
-static const uint8_t ui8ByteLength[7] = {1,1,2,2,4,4,4};
+static const uint8_t ui8ByteLength[10] = {1,1,2,2,4,4,4,8,8,8};
+
+/******************************************************************************
+ * Private function declarations
+ *****************************************************************************/
+static int16_t _GetPartitionIdx(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+static uint8_t _GetEEPROMWordCount(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum);
+static bool _ReadEEPROMWords(tsVAR_ACCESS* pVarAccess, uint32_t *pui32Words, uint16_t ui16Address, uint16_t ui16Len);
+static bool _WriteEEPROMWords(tsVAR_ACCESS* pVarAccess, const uint32_t *pui32Words, uint16_t ui16Address, uint16_t ui16Len);
+static teSCI_SLAVE_ERROR _StoreEEPROMWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, const uint32_t *pui32Words);
+static void _ReadEEPROMBlocks(tsVAR_ACCESS* pVarAccess);
+static bool _LoadRawValue(const tsSCIVAR *psVar, uint32_t *pui32Val);
+static bool _StoreRawValue(const tsSCIVAR *psVar, uint32_t ui32Val);
+static bool _AccessVarWord(const tsSCIVAR *psVar, uint32_t ui32WordIdx, uint32_t *pui32Val, bool bWrite);
 
 /******************************************************************************
  * Function definitions
@@ -31,33 +60,69 @@ static const uint8_t ui8ByteLength[7] = {1,1,2,2,4,4,4};
 
 teSCI_SLAVE_ERROR InitVarstruct(tsVAR_ACCESS* pVarAccess)
 {
-    uint16_t    ui16_currentEEVarAddress = ADDRESS_OFFET;
-    uint8_t     ui8_incrementor = 0;
-    uint8_t     ui8_actualEEIdx = 0;
     teSCI_SLAVE_ERROR  eError = eSCI_SLAVE_ERROR_NONE;
 
+    #ifdef SCI_STATIC_VAR_LAYOUT
+    // The partition table has been generated at compile time
+    pVarAccess->eepromPartitionTable    = sSciVarLayout.pPartitionTable;
+    pVarAccess->pui8PartitionIdx        = sSciVarLayout.pui8PartitionIdx;
+    pVarAccess->ui8EEPROMFlags          = sSciVarLayout.pui8Flags;
+    pVarAccess->ui8EEPROMVarCnt         = sSciVarLayout.ui8EEPROMVarCnt;
+    #else
+    uint16_t    ui16_currentEEVarAddress = ADDRESS_OFFET;
+
+    pVarAccess->ui8EEPROMVarCnt = 0;
+
     for (uint8_t i = 0; i < SIZE_OF_VAR_STRUCT; i++)
     {
         if (pVarAccess->pVarStruct[i].eVartype == eVARTYPE_EEPROM)
         {
             // Check if there is enough space in the address table
-            if (ui8_actualEEIdx == MAX_NUMBER_OF_EEPROM_VARS)
+            if (pVarAccess->ui8EEPROMVarCnt == MAX_NUMBER_OF_EEPROM_VARS)
                 return eSCI_SLAVE_ERROR_EEPROM_PARTITION_TABLE_NOT_SUFFICIENT;
 
-            pVarAccess->eepromPartitionTable[ui8_actualEEIdx].ui8Idx = i;
-            pVarAccess->eepromPartitionTable[ui8_actualEEIdx].ui16Address = ui16_currentEEVarAddress;
+            pVarAccess->eepromPartitionTable[pVarAccess->ui8EEPROMVarCnt].ui8Idx = i;
+            pVarAccess->eepromPartitionTable[pVarAccess->ui8EEPROMVarCnt].ui16Address = ui16_currentEEVarAddress;
+            pVarAccess->ui8EEPROMVarCnt++;
+
+            ui16_currentEEVarAddress += _GetEEPROMWordCount(pVarAccess, i + 1);
+        }
+    }
+    #endif
+
+    pVarAccess->ui8FlushIdx = 0;
+    pVarAccess->ui8FlushFailStreak = 0;
+    pVarAccess->ui16FlushBackoff = 0;
+    pVarAccess->ui32FlushFailCnt = 0;
+
+    for (uint8_t i = 0; i < SIZE_OF_VAR_STRUCT; i++)
+    {
+        // Every variable starts with a distinct generation, so a delta read from generation 0
+        // returns the whole variable structure.
+        pVarAccess->ui32VarGeneration[i] = ++pVarAccess->ui32Generation;
+    }
+
+    for (uint8_t i = 0; i < pVarAccess->ui8EEPROMVarCnt; i++)
+    {
+        pVarAccess->ui8EEPROMFlags[i] = 0;
+
+        // EEPROM variables are limited to scalars up to 32 bit
+        if (!IsVarScalar(pVarAccess, pVarAccess->eepromPartitionTable[i].ui8Idx + 1))
+            return eSCI_SLAVE_ERROR_VAR_NOT_SCALAR;
+    }
 
-            ui8_actualEEIdx++;
-            //WriteEEPROMwithValueFromVarStruct(pVarAccess, i + 1);
-            eError = ReadEEPROMValueIntoVarStruct(pVarAccess, i + 1);
+    if (pVarAccess->cbReadEEPROMBlock != NULL)
+        _ReadEEPROMBlocks(pVarAccess);
+    else
+    {
+        for (uint8_t i = 0; i < pVarAccess->ui8EEPROMVarCnt; i++)
+        {
+            eError = ReadEEPROMValueIntoVarStruct(pVarAccess, pVarAccess->eepromPartitionTable[i].ui8Idx + 1);
 
             // We ignore EEPROM read errors and keep the default value of the RAM variable
             // To enable write Access, we establish the EEPROM partition table anyways.
             // if (eError != eSCI_SLAVE_ERROR_NONE)
             //     return eError;
-
-            ui8_incrementor = ui8ByteLength[pVarAccess->pVarStruct[i].eDatatype] / EEPROM_ADDRESSTYPE;
-            ui16_currentEEVarAddress += ui8_incrementor > 0 ? ui8_incrementor : 1;
         }
     }
 
@@ -65,240 +130,228 @@ teSCI_SLAVE_ERROR InitVarstruct(tsVAR_ACCESS* pVarAccess)
 }
 
 //=============================================================================
-teSCI_SLAVE_ERROR ReadValFromVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, float *pfVal)
+int16_t GetVarNumber(uint16_t ui16Id)
 {
-    int16_t i16_varIdx = i16VarNum - 1;
-    //bool b_success;
-    union
-    {
-        uint8_t     ui8Val;
-        int8_t      i8_val;
-        uint16_t    ui16Val;
-        int16_t     i16Val;
-        uint32_t    ui32Val;
-        int32_t     i32Val;
-        float       fVal;
-    }ret;
+    #ifdef SCI_SPARSE_VAR_IDS
+    const tsSCI_VAR_ID_BLOCK *psBlock = &sSciVarIds.pBlocks[ui16Id >> SCI_VAR_ID_BLOCK_BITS];
+    uint16_t ui16Pos = ui16Id & SCI_VAR_ID_POS_MASK;
+
+    // Position 0 is the block base and no variable
+    if (ui16Pos == 0 || ui16Pos > psBlock->ui16Cnt)
+        return 0;
+
+    return (int16_t)(psBlock->ui16First + ui16Pos - 1);
+    #else
+    return ui16Id <= SIZE_OF_VAR_STRUCT ? (int16_t)ui16Id : 0;
+    #endif
+}
 
-    ret.ui32Val = 0;
+//=============================================================================
+uint16_t GetVarId(int16_t i16VarNum)
+{
+    #ifdef SCI_SPARSE_VAR_IDS
+    if (i16VarNum <= 0 || i16VarNum > SIZE_OF_VAR_STRUCT)
+        return 0;
+
+    return sSciVarIds.pui16Ids[i16VarNum - 1];
+    #else
+    return (uint16_t)i16VarNum;
+    #endif
+}
 
-    if (i16VarNum > 0 && i16VarNum <= SIZE_OF_VAR_STRUCT)
-    {
+//=============================================================================
+uint16_t GetVarElementCount(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    if (i16VarNum <= 0 || i16VarNum > SIZE_OF_VAR_STRUCT)
+        return 0;
 
-        switch (pVarAccess->pVarStruct[i16_varIdx].eDatatype)
-        {
-            case eDTYPE_UINT8:
-                ret.ui8Val = *(uint8_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal);
-                #ifndef VALUE_MODE_HEX
-                *pfVal = (float)ret.ui8Val;
-                #endif
-                break;
-            case eDTYPE_INT8:
-                ret.i8_val = *(int8_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal);
-                #ifndef VALUE_MODE_HEX
-                *pfVal = (float)ret.i8_val;
-                #endif
-                break;
-            case eDTYPE_UINT16:
-                ret.ui16Val = *(uint16_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal);
-                #ifndef VALUE_MODE_HEX
-                *pfVal = (float)ret.ui16Val;
-                #endif
-                break;
-            case eDTYPE_INT16:
-                ret.i16Val = *(int16_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal);
-                #ifndef VALUE_MODE_HEX
-                *pfVal = (float)ret.i16Val;
-                #endif
-                break;
-            case eDTYPE_UINT32:
-                ret.ui32Val = *(uint32_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal);
-                #ifndef VALUE_MODE_HEX
-                *pfVal = (float)ret.ui32Val;
-                #endif
-                break;
-            case eDTYPE_INT32:
-                ret.i32Val = *(int32_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal);
-                #ifndef VALUE_MODE_HEX
-                *pfVal = (float)ret.i32Val;
-                #endif
-                break;
-            case eDTYPE_F32:
-                ret.fVal   = *(float*)(pVarAccess->pVarStruct[i16_varIdx].pVal);
-                #ifndef VALUE_MODE_HEX
-                *pfVal = ret.fVal;
-                #endif
-                break;
+    return pVarAccess->pVarStruct[i16VarNum - 1].ui16Cnt > 0 ? pVarAccess->pVarStruct[i16VarNum - 1].ui16Cnt : 1;
+}
 
-            default:
-                return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
+//=============================================================================
+uint8_t GetVarElementWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    if (i16VarNum <= 0 || i16VarNum > SIZE_OF_VAR_STRUCT || pVarAccess->pVarStruct[i16VarNum - 1].eDatatype > eDTYPE_F64)
+        return 0;
 
-        }
+    return ui8ByteLength[pVarAccess->pVarStruct[i16VarNum - 1].eDatatype] > 4 ? 2 : 1;
+}
 
-        #ifdef VALUE_MODE_HEX
-        *pfVal = ret.fVal;
-        #endif
+//=============================================================================
+bool IsVarScalar(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    return GetVarElementCount(pVarAccess, i16VarNum) * GetVarElementWords(pVarAccess, i16VarNum) == 1;
+}
 
-        return eSCI_SLAVE_ERROR_NONE;
-    }
-    else
+//=============================================================================
+teSCI_SLAVE_ERROR ReadVarWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32WordIdx, tuRESPONSEVALUE *puVals, uint8_t ui8Cnt)
+{
+    uint32_t ui32WordCnt = (uint32_t)GetVarElementCount(pVarAccess, i16VarNum) * GetVarElementWords(pVarAccess, i16VarNum);
+
+    if (ui32WordCnt == 0)
         return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
+
+    if (ui32WordIdx + ui8Cnt > ui32WordCnt)
+        return eSCI_SLAVE_ERROR_ARRAY_RANGE_INVALID;
+
+    for (uint8_t i = 0; i < ui8Cnt; i++)
+    {
+        if (!_AccessVarWord(&pVarAccess->pVarStruct[i16VarNum - 1], ui32WordIdx + i, &puVals[i].ui32_hex, false))
+            return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
+    }
+
+    return eSCI_SLAVE_ERROR_NONE;
 }
 
 //=============================================================================
-teSCI_SLAVE_ERROR WriteValToVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, float fVal)
+teSCI_SLAVE_ERROR WriteVarWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32WordIdx, const tuREQUESTVALUE *puVals, uint8_t ui8Cnt)
 {
-    int16_t i16_varIdx = i16VarNum - 1;
-    //bool b_success;
+    uint32_t ui32WordCnt = (uint32_t)GetVarElementCount(pVarAccess, i16VarNum) * GetVarElementWords(pVarAccess, i16VarNum);
 
-    union
-    {
-        uint8_t     ui8Val;
-        int8_t      i8_val;
-        uint16_t    ui16Val;
-        int16_t     i16Val;
-        uint32_t    ui32Val;
-        int32_t     i32Val;
-        float       fVal;
-    }in;
+    if (ui32WordCnt == 0)
+        return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
 
-    in.fVal = fVal;
+    if (ui32WordIdx + ui8Cnt > ui32WordCnt)
+        return eSCI_SLAVE_ERROR_ARRAY_RANGE_INVALID;
 
-    if (i16VarNum > 0 && i16VarNum <= SIZE_OF_VAR_STRUCT)
+    for (uint8_t i = 0; i < ui8Cnt; i++)
     {
+        uint32_t ui32Val = puVals[i].ui32_hex;
 
-        switch (pVarAccess->pVarStruct[i16_varIdx].eDatatype)
-        {
-            case eDTYPE_UINT8:
-                #ifdef VALUE_MODE_HEX
-                *(uint8_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = in.ui8Val;
-                #else
-                *(uint8_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = (uint8_t)fVal;
-                #endif
-                break;
-            case eDTYPE_INT8:
-                #ifdef VALUE_MODE_HEX
-                *(int8_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = in.i8_val;
-                #else
-                *(int8_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = (int8_t)fVal;
-                #endif
-                break;
-            case eDTYPE_UINT16:
-                #ifdef VALUE_MODE_HEX
-                *(uint16_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = in.ui16Val;
-                #else
-                *(uint16_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = (uint16_t)fVal;
-                #endif
-                break;
-            case eDTYPE_INT16:
-                #ifdef VALUE_MODE_HEX
-                *(int16_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = in.i16Val;
-                #else
-                *(int16_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = (int16_t)fVal;
-                #endif
-                break;
-            case eDTYPE_UINT32:
-                #ifdef VALUE_MODE_HEX
-               *(uint32_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = in.ui32Val;
-               #else
-               *(uint32_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = (uint32_t)fVal;
-               #endif
-               break;
-            case eDTYPE_INT32:
-                #ifdef VALUE_MODE_HEX
-                *(int32_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = in.i32Val;
-                #else
-                *(int32_t*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = (int32_t)fVal;
-                #endif
-                break;
-            case eDTYPE_F32:
-                *(float*)(pVarAccess->pVarStruct[i16_varIdx].pVal) = fVal;
-                break;
+        if (!_AccessVarWord(&pVarAccess->pVarStruct[i16VarNum - 1], ui32WordIdx + i, &ui32Val, true))
+            return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
+    }
 
-            default:
-                return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
-        }
+    return MarkVarModified(pVarAccess, i16VarNum);
+}
 
-        return eSCI_SLAVE_ERROR_NONE;
-    }
-    else
+//=============================================================================
+teSCI_SLAVE_ERROR ReadRawFromVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t *pui32Val)
+{
+    if (i16VarNum <= 0 || i16VarNum > SIZE_OF_VAR_STRUCT)
         return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
+
+    if (!IsVarScalar(pVarAccess, i16VarNum))
+        return eSCI_SLAVE_ERROR_VAR_NOT_SCALAR;
+
+    if (!_LoadRawValue(&pVarAccess->pVarStruct[i16VarNum - 1], pui32Val))
+        return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
+
+    return eSCI_SLAVE_ERROR_NONE;
 }
 
 //=============================================================================
-teSCI_SLAVE_ERROR ReadEEPROMValueIntoVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+teSCI_SLAVE_ERROR WriteRawToVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32Val)
 {
-    bool        successIndicator = true;
-    uint32_t    ui32_tmp = 0;
-    uint8_t     ui8_numberOfIncs = 0;
-    uint16_t    ui16_eepromAddress;
+    if (i16VarNum <= 0 || i16VarNum > SIZE_OF_VAR_STRUCT)
+        return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
 
-    union {
-        uint8_t     ui8Val;
-        int8_t      i8_val;
-        uint16_t    ui16Val;
-        int16_t     i16Val;
-        uint32_t    ui32Val;
-        int32_t     i32Val;
-        float       fVal;
-    } u_tmp;
-    
+    if (!IsVarScalar(pVarAccess, i16VarNum))
+        return eSCI_SLAVE_ERROR_VAR_NOT_SCALAR;
 
+    if (!_StoreRawValue(&pVarAccess->pVarStruct[i16VarNum - 1], ui32Val))
+        return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
+
+    return MarkVarModified(pVarAccess, i16VarNum);
+}
 
-    u_tmp.ui32Val = 0;
-    if (pVarAccess->pVarStruct[i16VarNum - 1].eVartype == eVARTYPE_EEPROM && pVarAccess->cbReadEEPROM != NULL)
+//=============================================================================
+teSCI_SLAVE_ERROR ReadValFromVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, tuREQUESTVALUE *puVal)
+{
+    #ifdef VALUE_MODE_HEX
+    return ReadRawFromVarStruct(pVarAccess, i16VarNum, &puVal->ui32_hex);
+    #else
+    uint32_t ui32Raw;
+    teSCI_SLAVE_ERROR eError = ReadRawFromVarStruct(pVarAccess, i16VarNum, &ui32Raw);
+
+    if (eError != eSCI_SLAVE_ERROR_NONE)
+        return eError;
+
+    RawToVal(pVarAccess, i16VarNum, ui32Raw, puVal);
+    return eSCI_SLAVE_ERROR_NONE;
+    #endif
+}
+
+//=============================================================================
+void RawToVal(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, uint32_t ui32Raw, tuREQUESTVALUE *puVal)
+{
+    #ifdef VALUE_MODE_HEX
+    (void)pVarAccess;
+    (void)i16VarNum;
+    puVal->ui32_hex = ui32Raw;
+    #else
+    switch (pVarAccess->pVarStruct[i16VarNum - 1].eDatatype)
     {
-        // Determine how many EEPROM reads have to be accomplished
-        ui8_numberOfIncs = ui8ByteLength[pVarAccess->pVarStruct[i16VarNum - 1].eDatatype]/EEPROM_ADDRESSTYPE;
-        ui8_numberOfIncs = ui8_numberOfIncs > 0 ? ui8_numberOfIncs : 1;
+        case eDTYPE_UINT8:
+        case eDTYPE_UINT16:
+        case eDTYPE_UINT32:
+            puVal->f_float = (float)ui32Raw;
+            break;
+        case eDTYPE_INT8:
+        case eDTYPE_INT16:
+        case eDTYPE_INT32:
+            puVal->f_float = (float)(int32_t)ui32Raw;
+            break;
+        default:
+            // eDTYPE_F32: Raw bits are the float value
+            puVal->ui32_hex = ui32Raw;
+            break;
+    }
+    #endif
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR WriteValToVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, tuREQUESTVALUE uVal)
+{
+    #ifdef VALUE_MODE_HEX
+    return WriteRawToVarStruct(pVarAccess, i16VarNum, uVal.ui32_hex);
+    #else
+    uint32_t ui32Raw;
+
+    if (i16VarNum <= 0 || i16VarNum > SIZE_OF_VAR_STRUCT)
+        return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
+
+    switch (pVarAccess->pVarStruct[i16VarNum - 1].eDatatype)
+    {
+        case eDTYPE_UINT8:
+        case eDTYPE_UINT16:
+        case eDTYPE_UINT32:
+            ui32Raw = (uint32_t)uVal.f_float;
+            break;
+        case eDTYPE_INT8:
+        case eDTYPE_INT16:
+        case eDTYPE_INT32:
+            ui32Raw = (uint32_t)(int32_t)uVal.f_float;
+            break;
+        default:
+            ui32Raw = uVal.ui32_hex;
+            break;
+    }
 
+    return WriteRawToVarStruct(pVarAccess, i16VarNum, ui32Raw);
+    #endif
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR ReadEEPROMValueIntoVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    uint32_t    ui32Words[4];
+    uint16_t    ui16_eepromAddress;
 
+    if (pVarAccess->pVarStruct[i16VarNum - 1].eVartype == eVARTYPE_EEPROM && 
+        (pVarAccess->cbReadEEPROM != NULL || pVarAccess->cbReadEEPROMBlock != NULL))
+    {
         // Look for the partition table index of the eeprom var
         ui16_eepromAddress = GetEEPROMAddress(pVarAccess, i16VarNum);
 
         if(ui16_eepromAddress == EEEPROM_ADDRESS_ILLEGAL)
             return eSCI_SLAVE_ERROR_EEPROM_ADDRESS_UNKNOWN;
-;
 
-        for (uint8_t i = 0; i < ui8_numberOfIncs; i++)
-        {
-            successIndicator &= pVarAccess->cbReadEEPROM(&ui32_tmp, ui16_eepromAddress + i);
-
-            if (!successIndicator)
-               return eSCI_SLAVE_ERROR_EEPROM_READOUT_FAILED;
-            
-            ui32_tmp <<= (i * EEPROM_ADDRESSTYPE * 8);
-            u_tmp.ui32Val |= ui32_tmp;
-            ui32_tmp = 0;
-        }
+        if (!_ReadEEPROMWords(pVarAccess, ui32Words, ui16_eepromAddress, _GetEEPROMWordCount(pVarAccess, i16VarNum)))
+            return eSCI_SLAVE_ERROR_EEPROM_READOUT_FAILED;
 
         // Write the data structure with the read value
-        switch(pVarAccess->pVarStruct[i16VarNum - 1].eDatatype)
-        {
-            case eDTYPE_UINT8:
-                *(uint8_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal) = u_tmp.ui8Val;
-                break;
-            case eDTYPE_INT8:
-                *(int8_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal) = u_tmp.i8_val;
-                break;
-            case eDTYPE_UINT16:
-                *(uint16_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal) = u_tmp.ui16Val;
-                break;
-            case eDTYPE_INT16:
-                *(int16_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal) = u_tmp.i16Val;
-                break;
-            case eDTYPE_UINT32:
-                *(uint32_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal) = u_tmp.ui32Val;
-                break;
-            case eDTYPE_INT32:
-                *(int32_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal) = u_tmp.i32Val;
-                break;
-            case eDTYPE_F32:
-                *(float*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal) = u_tmp.fVal;
-                break;
-            default:
-                return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
-        }
+        return _StoreEEPROMWords(pVarAccess, i16VarNum, ui32Words);
     }
 
     return eSCI_SLAVE_ERROR_NONE;
@@ -307,24 +360,15 @@ teSCI_SLAVE_ERROR ReadEEPROMValueIntoVarStruct(tsVAR_ACCESS* pVarAccess, int16_t
 //=============================================================================
 teSCI_SLAVE_ERROR WriteEEPROMwithValueFromVarStruct(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
 {
-    bool        successIndicator = true;
-    uint32_t    ui32_mask = 0, ui32_tmp = 0;
+    uint32_t    ui32_mask = 0;
+    uint32_t    ui32Words[4];
     uint8_t     ui8_numberOfIncs = 0;
     uint16_t    ui16_eepromAddress;
 
-    union {
-        uint8_t     ui8Val;
-        int8_t      i8_val;
-        uint16_t    ui16Val;
-        int16_t     i16Val;
-        uint32_t    ui32Val;
-        int32_t     i32Val;
-        float       fVal;
-    } u_tmp;
-    
-    u_tmp.ui32Val = 0;
+    uint32_t    ui32Val;
 
-    if (pVarAccess->pVarStruct[i16VarNum - 1].eVartype == eVARTYPE_EEPROM && pVarAccess->cbWriteEEPROM != NULL)
+    if (pVarAccess->pVarStruct[i16VarNum - 1].eVartype == eVARTYPE_EEPROM && 
+        (pVarAccess->cbWriteEEPROM != NULL || pVarAccess->cbWriteEEPROMBlock != NULL))
     {
         // Look for the partition table index of the eeprom var
         ui16_eepromAddress = GetEEPROMAddress(pVarAccess, i16VarNum);
@@ -333,77 +377,166 @@ teSCI_SLAVE_ERROR WriteEEPROMwithValueFromVarStruct(tsVAR_ACCESS* pVarAccess, in
             return eSCI_SLAVE_ERROR_EEPROM_ADDRESS_UNKNOWN;
 
         // Read data from the data structure
-        switch(pVarAccess->pVarStruct[i16VarNum - 1].eDatatype)
-        {
-            case eDTYPE_UINT8:
-                u_tmp.ui8Val = *(uint8_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal);
-                break;
-            case eDTYPE_INT8:
-                u_tmp.i8_val = *(int8_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal);
-                break;
-            case eDTYPE_UINT16:
-                u_tmp.ui16Val = *(uint16_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal);
-                break;
-            case eDTYPE_INT16:
-                u_tmp.i16Val = *(int16_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal);
-                break;
-            case eDTYPE_UINT32:
-                u_tmp.ui32Val = *(uint32_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal);
-                break;
-            case eDTYPE_INT32:
-                u_tmp.i32Val = *(int32_t*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal);
-                break;
-            case eDTYPE_F32:
-                u_tmp.fVal = *(float*)(pVarAccess->pVarStruct[i16VarNum - 1].pVal);
-                break;
-            default:
-                return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
-        }
+        if (!_LoadRawValue(&pVarAccess->pVarStruct[i16VarNum - 1], &ui32Val))
+            return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
 
-        // Determine how many EEPROM reads have to be accomplished
-        ui8_numberOfIncs = ui8ByteLength[pVarAccess->pVarStruct[i16VarNum - 1].eDatatype]/EEPROM_ADDRESSTYPE;
-        ui8_numberOfIncs = ui8_numberOfIncs > 0 ? ui8_numberOfIncs : 1;
+        // Determine how many EEPROM writes have to be accomplished
+        ui8_numberOfIncs = _GetEEPROMWordCount(pVarAccess, i16VarNum);
 
         // Generate the bit mask
         for (uint8_t i = EEPROM_ADDRESSTYPE; i > 0; i--)
         {
-            ui32_mask |= 0xFF << ((i - 1) * 8);
+            ui32_mask |= 0xFFUL << ((i - 1) * 8);
         }
 
-        // Write EEPROM 
-        for (uint8_t i = ui8_numberOfIncs; i > 0; i--)
+        // Split the value into EEPROM words
+        for (uint8_t i = 0; i < ui8_numberOfIncs; i++)
         {
-            ui32_tmp = u_tmp.ui32Val >> (i - 1) * EEPROM_ADDRESSTYPE * 8;
-            ui32_tmp &= ui32_mask;
+            ui32Words[i] = (ui32Val >> (i * EEPROM_ADDRESSTYPE * 8)) & ui32_mask;
+        }
 
-            successIndicator &= pVarAccess->cbWriteEEPROM(ui32_tmp, ui16_eepromAddress + (i - 1));
+        // Write EEPROM 
+        if (!_WriteEEPROMWords(pVarAccess, ui32Words, ui16_eepromAddress, ui8_numberOfIncs))
+            return eSCI_SLAVE_ERROR_EEPROM_WRITE_FAILED;
 
-            if (!successIndicator)
-                return eSCI_SLAVE_ERROR_EEPROM_WRITE_FAILED;
-        }
+        #if EEPROM_READ_POLICY == EEPROM_READ_AFTER_WRITE
+        // Verify the written value with the next read access
+        pVarAccess->ui8EEPROMFlags[_GetPartitionIdx(pVarAccess, i16VarNum)] &= ~EEPROM_FLAG_VALID;
+        #endif
     }
 
     return eSCI_SLAVE_ERROR_NONE;
 }
 
 //=============================================================================
-uint16_t GetEEPROMAddress(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+bool IsEEPROMValueCached(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    int16_t i16Idx = _GetPartitionIdx(pVarAccess, i16VarNum);
+
+    if (i16Idx < 0)
+        return false;
+
+    // The EEPROM content is outdated until the deferred write happened
+    if (pVarAccess->ui8EEPROMFlags[i16Idx] & EEPROM_FLAG_DIRTY)
+        return true;
+
+    #if EEPROM_READ_POLICY == EEPROM_READ_ALWAYS
+    return false;
+    #else
+    return (pVarAccess->ui8EEPROMFlags[i16Idx] & EEPROM_FLAG_VALID) != 0;
+    #endif
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR MarkEEPROMDirty(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    int16_t i16Idx = _GetPartitionIdx(pVarAccess, i16VarNum);
+
+    if (i16Idx < 0)
+        return eSCI_SLAVE_ERROR_EEPROM_ADDRESS_UNKNOWN;
+
+    pVarAccess->ui8EEPROMFlags[i16Idx] |= EEPROM_FLAG_DIRTY;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR FlushEEPROM(tsVAR_ACCESS* pVarAccess, bool bAll)
 {
-    uint16_t ui16Address = EEEPROM_ADDRESS_ILLEGAL;
-    uint8_t ui8Idx = 0;
+    teSCI_SLAVE_ERROR eError = eSCI_SLAVE_ERROR_NONE;
+    uint8_t ui8Cnt = pVarAccess->ui8EEPROMVarCnt;
 
-    while (ui8Idx < MAX_NUMBER_OF_EEPROM_VARS)
+    if (!bAll && pVarAccess->ui16FlushBackoff > 0)
     {
-        if ((i16VarNum - 1) == pVarAccess->eepromPartitionTable[ui8Idx].ui8Idx)
+        pVarAccess->ui16FlushBackoff--;
+        return eSCI_SLAVE_ERROR_NONE;
+    }
+
+    // Single flushes continue after the variable written last, a failing one doesn't block the others
+    for (uint8_t j = 0; j < ui8Cnt; j++)
+    {
+        uint8_t i = bAll ? j : (uint8_t)((pVarAccess->ui8FlushIdx + j) % ui8Cnt);
+        teSCI_SLAVE_ERROR eWriteError;
+
+        if (!(pVarAccess->ui8EEPROMFlags[i] & EEPROM_FLAG_DIRTY))
+            continue;
+
+        // The entry stays dirty on failure and is retried with a later flush
+        eWriteError = WriteEEPROMwithValueFromVarStruct(pVarAccess, pVarAccess->eepromPartitionTable[i].ui8Idx + 1);
+        if (eWriteError == eSCI_SLAVE_ERROR_NONE)
+            pVarAccess->ui8EEPROMFlags[i] &= ~(EEPROM_FLAG_DIRTY | EEPROM_FLAG_FAILED);
+        else
         {
-            ui16Address = pVarAccess->eepromPartitionTable[ui8Idx].ui16Address;
+            pVarAccess->ui8EEPROMFlags[i] |= EEPROM_FLAG_FAILED;
+            pVarAccess->ui32FlushFailCnt++;
+            if (eError == eSCI_SLAVE_ERROR_NONE)
+                eError = eWriteError;
+        }
+
+        if (!bAll)
+        {
+            pVarAccess->ui8FlushIdx = (uint8_t)((i + 1) % ui8Cnt);
+
+            // Back off exponentially while writes keep failing
+            if (eWriteError == eSCI_SLAVE_ERROR_NONE)
+                pVarAccess->ui8FlushFailStreak = 0;
+            else
+            {
+                if (pVarAccess->ui8FlushFailStreak < EEPROM_FLUSH_BACKOFF_MAX)
+                    pVarAccess->ui8FlushFailStreak++;
+                pVarAccess->ui16FlushBackoff = (uint16_t)(1U << pVarAccess->ui8FlushFailStreak);
+            }
             break;
         }
-        
-        ui8Idx++;
     }
 
-    return ui16Address;
+    return eError;
+}
+
+//=============================================================================
+uint8_t GetEEPROMDirtyCount(tsVAR_ACCESS* pVarAccess)
+{
+    uint8_t ui8Cnt = 0;
+
+    for (uint8_t i = 0; i < pVarAccess->ui8EEPROMVarCnt; i++)
+    {
+        if (pVarAccess->ui8EEPROMFlags[i] & EEPROM_FLAG_DIRTY)
+            ui8Cnt++;
+    }
+
+    return ui8Cnt;
+}
+
+//=============================================================================
+uint32_t GetEEPROMFlushFailCount(tsVAR_ACCESS* pVarAccess)
+{
+    return pVarAccess->ui32FlushFailCnt;
+}
+
+//=============================================================================
+uint16_t GetEEPROMAddress(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    int16_t i16Idx = _GetPartitionIdx(pVarAccess, i16VarNum);
+
+    return i16Idx >= 0 ? pVarAccess->eepromPartitionTable[i16Idx].ui16Address : EEEPROM_ADDRESS_ILLEGAL;
+}
+
+//=============================================================================
+static int16_t _GetPartitionIdx(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    #ifdef SCI_STATIC_VAR_LAYOUT
+    // Generated lookup table
+    if (i16VarNum > 0 && i16VarNum <= SIZE_OF_VAR_STRUCT && pVarAccess->pui8PartitionIdx[i16VarNum - 1] != EEPROM_PARTITION_IDX_NONE)
+        return pVarAccess->pui8PartitionIdx[i16VarNum - 1];
+    #else
+    for (uint8_t ui8Idx = 0; ui8Idx < pVarAccess->ui8EEPROMVarCnt; ui8Idx++)
+    {
+        if ((i16VarNum - 1) == pVarAccess->eepromPartitionTable[ui8Idx].ui8Idx)
+            return ui8Idx;
+    }
+    #endif
+
+    return -1;
 }
 
 //=============================================================================
@@ -416,4 +549,257 @@ teSCI_SLAVE_ERROR GetVar(tsVAR_ACCESS* pVarAccess, tsSCIVAR* pVar, int16_t i16Va
     }
     
     return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
-}
\ No newline at end of file
+}
+
+//=============================================================================
+teSCI_SLAVE_ERROR MarkVarModified(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    if (i16VarNum > 0 && i16VarNum <= SIZE_OF_VAR_STRUCT)
+    {
+        pVarAccess->ui32VarGeneration[i16VarNum - 1] = ++pVarAccess->ui32Generation;
+        return eSCI_SLAVE_ERROR_NONE;
+    }
+
+    return eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID;
+}
+
+//=============================================================================
+uint8_t GetModifiedVars(tsVAR_ACCESS* pVarAccess, uint32_t ui32Generation, int16_t *pi16VarNums, uint8_t ui8MaxCnt, uint32_t *pui32NewGeneration)
+{
+    uint8_t ui8Cnt = 0;
+
+    *pui32NewGeneration = pVarAccess->ui32Generation;
+
+    while (ui8Cnt < ui8MaxCnt)
+    {
+        int16_t i16NextIdx = -1;
+
+        // Search the oldest modification that is newer than the given generation
+        for (int16_t i = 0; i < SIZE_OF_VAR_STRUCT; i++)
+        {
+            if (pVarAccess->ui32VarGeneration[i] > ui32Generation &&
+                (i16NextIdx < 0 || pVarAccess->ui32VarGeneration[i] < pVarAccess->ui32VarGeneration[i16NextIdx]))
+                i16NextIdx = i;
+        }
+
+        // All modifications collected
+        if (i16NextIdx < 0)
+            return ui8Cnt;
+
+        pi16VarNums[ui8Cnt++] = i16NextIdx + 1;
+        ui32Generation = pVarAccess->ui32VarGeneration[i16NextIdx];
+    }
+
+    // Array is full: Only report the generation up to which the caller is in sync,
+    // unless there is nothing left anyway.
+    if (ui32Generation < pVarAccess->ui32Generation)
+    {
+        for (int16_t i = 0; i < SIZE_OF_VAR_STRUCT; i++)
+        {
+            if (pVarAccess->ui32VarGeneration[i] > ui32Generation)
+            {
+                *pui32NewGeneration = ui32Generation;
+                break;
+            }
+        }
+    }
+
+    return ui8Cnt;
+}
+
+//=============================================================================
+static uint8_t _GetEEPROMWordCount(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum)
+{
+    uint8_t ui8WordCnt = ui8ByteLength[pVarAccess->pVarStruct[i16VarNum - 1].eDatatype] / EEPROM_ADDRESSTYPE;
+
+    return ui8WordCnt > 0 ? ui8WordCnt : 1;
+}
+
+//=============================================================================
+static bool _ReadEEPROMWords(tsVAR_ACCESS* pVarAccess, uint32_t *pui32Words, uint16_t ui16Address, uint16_t ui16Len)
+{
+    if (pVarAccess->cbReadEEPROMBlock != NULL)
+        return pVarAccess->cbReadEEPROMBlock(pui32Words, ui16Address, ui16Len);
+
+    for (uint16_t i = 0; i < ui16Len; i++)
+    {
+        pui32Words[i] = 0;
+
+        if (!pVarAccess->cbReadEEPROM(&pui32Words[i], ui16Address + i))
+            return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static bool _WriteEEPROMWords(tsVAR_ACCESS* pVarAccess, const uint32_t *pui32Words, uint16_t ui16Address, uint16_t ui16Len)
+{
+    if (pVarAccess->cbWriteEEPROMBlock != NULL)
+        return pVarAccess->cbWriteEEPROMBlock(pui32Words, ui16Address, ui16Len);
+
+    for (uint16_t i = ui16Len; i > 0; i--)
+    {
+        if (!pVarAccess->cbWriteEEPROM(pui32Words[i - 1], ui16Address + (i - 1)))
+            return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static teSCI_SLAVE_ERROR _StoreEEPROMWords(tsVAR_ACCESS* pVarAccess, int16_t i16VarNum, const uint32_t *pui32Words)
+{
+    uint8_t ui8_numberOfIncs = _GetEEPROMWordCount(pVarAccess, i16VarNum);
+
+    uint32_t ui32Val = 0;
+
+    // Assemble the value from the EEPROM words (lowest address holds the least significant word)
+    for (uint8_t i = 0; i < ui8_numberOfIncs; i++)
+        ui32Val |= pui32Words[i] << (i * EEPROM_ADDRESSTYPE * 8);
+
+    if (!_StoreRawValue(&pVarAccess->pVarStruct[i16VarNum - 1], ui32Val))
+        return eSCI_SLAVE_ERROR_UNKNOWN_DATATYPE;
+
+    // RAM and EEPROM are in sync now
+    pVarAccess->ui8EEPROMFlags[_GetPartitionIdx(pVarAccess, i16VarNum)] |= EEPROM_FLAG_VALID;
+
+    return eSCI_SLAVE_ERROR_NONE;
+}
+
+//=============================================================================
+static void _ReadEEPROMBlocks(tsVAR_ACCESS* pVarAccess)
+{
+    uint32_t ui32Words[EEPROM_BLOCK_LENGTH];
+    uint8_t  ui8First = 0;
+
+    while (ui8First < pVarAccess->ui8EEPROMVarCnt)
+    {
+        const tsEEPROM_PARTITION_INFO *psTable = pVarAccess->eepromPartitionTable;
+        uint16_t ui16Len = 0;
+        uint8_t  ui8Last = ui8First;
+
+        // Merge contiguous variables as long as they fit into the block buffer
+        while (ui8Last < pVarAccess->ui8EEPROMVarCnt)
+        {
+            uint8_t ui8WordCnt = _GetEEPROMWordCount(pVarAccess, psTable[ui8Last].ui8Idx + 1);
+
+            if (psTable[ui8Last].ui16Address != psTable[ui8First].ui16Address + ui16Len || 
+                ui16Len + ui8WordCnt > EEPROM_BLOCK_LENGTH)
+                break;
+
+            ui16Len += ui8WordCnt;
+            ui8Last++;
+        }
+
+        // We ignore EEPROM read errors and keep the default values of the RAM variables
+        if (_ReadEEPROMWords(pVarAccess, ui32Words, psTable[ui8First].ui16Address, ui16Len))
+        {
+            uint16_t ui16Offset = 0;
+
+            for (uint8_t i = ui8First; i < ui8Last; i++)
+            {
+                _StoreEEPROMWords(pVarAccess, psTable[i].ui8Idx + 1, &ui32Words[ui16Offset]);
+                ui16Offset += _GetEEPROMWordCount(pVarAccess, psTable[i].ui8Idx + 1);
+            }
+        }
+
+        ui8First = ui8Last;
+    }
+}
+
+//=============================================================================
+static bool _LoadRawValue(const tsSCIVAR *psVar, uint32_t *pui32Val)
+{
+    switch (psVar->eDatatype)
+    {
+        case eDTYPE_UINT8:
+            *pui32Val = *(uint8_t*)psVar->pVal;
+            break;
+        case eDTYPE_INT8:
+            *pui32Val = (uint32_t)(int32_t)*(int8_t*)psVar->pVal;
+            break;
+        case eDTYPE_UINT16:
+            *pui32Val = *(uint16_t*)psVar->pVal;
+            break;
+        case eDTYPE_INT16:
+            *pui32Val = (uint32_t)(int32_t)*(int16_t*)psVar->pVal;
+            break;
+        case eDTYPE_UINT32:
+        case eDTYPE_INT32:
+            *pui32Val = *(uint32_t*)psVar->pVal;
+            break;
+        case eDTYPE_F32:
+            // Bit copy, no float instructions involved
+            memcpy(pui32Val, psVar->pVal, sizeof(uint32_t));
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static bool _StoreRawValue(const tsSCIVAR *psVar, uint32_t ui32Val)
+{
+    switch (psVar->eDatatype)
+    {
+        case eDTYPE_UINT8:
+        case eDTYPE_INT8:
+            *(uint8_t*)psVar->pVal = (uint8_t)ui32Val;
+            break;
+        case eDTYPE_UINT16:
+        case eDTYPE_INT16:
+            *(uint16_t*)psVar->pVal = (uint16_t)ui32Val;
+            break;
+        case eDTYPE_UINT32:
+        case eDTYPE_INT32:
+            *(uint32_t*)psVar->pVal = ui32Val;
+            break;
+        case eDTYPE_F32:
+            memcpy(psVar->pVal, &ui32Val, sizeof(uint32_t));
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static bool _AccessVarWord(const tsSCIVAR *psVar, uint32_t ui32WordIdx, uint32_t *pui32Val, bool bWrite)
+{
+    uint8_t ui8ByteCnt = ui8ByteLength[psVar->eDatatype];
+
+    // 64 bit elements consist of two words (low word first)
+    if (ui8ByteCnt == 8)
+    {
+        uint8_t     *pui8Elem = (uint8_t*)psVar->pVal + (ui32WordIdx / 2) * 8;
+        uint8_t     ui8Shift = (ui32WordIdx % 2) * 32;
+        uint64_t    ui64Val;
+
+        memcpy(&ui64Val, pui8Elem, sizeof(uint64_t));
+
+        if (!bWrite)
+        {
+            *pui32Val = (uint32_t)(ui64Val >> ui8Shift);
+            return true;
+        }
+
+        ui64Val &= ~(0xFFFFFFFFULL << ui8Shift);
+        ui64Val |= (uint64_t)*pui32Val << ui8Shift;
+        memcpy(pui8Elem, &ui64Val, sizeof(uint64_t));
+
+        return true;
+    }
+    else
+    {
+        // Element access through a scalar view of the element
+        tsSCIVAR sElem = *psVar;
+
+        sElem.pVal = (uint8_t*)psVar->pVal + ui32WordIdx * ui8ByteCnt;
+
+        return bWrite ? _StoreRawValue(&sElem, *pui32Val) : _LoadRawValue(&sElem, pui32Val);
+    }
+}
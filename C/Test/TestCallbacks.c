@@ -18,6 +18,8 @@
 #include "SCISlave.h"
 #include "SCIMaster.h"
 #include "SCIconfig.h"
+#include "SCIEEPROMJournal.h"
+#include "TestCallbacks.h"
 
 /******************************************************************************
  * Global variable definition
@@ -27,6 +29,27 @@ char cRxMsgBuf[RX_PACKET_LENGTH + 2] = {0};
 uint8_t ui8EEPROMByteAddressable [MAX_NUMBER_OF_EEPROM_VARS * 4] = {0};
 uint16_t ui16EEPROMWordAddressable [MAX_NUMBER_OF_EEPROM_VARS * 2] = {0};
 uint32_t ui32EEPROMDWordAddressable [MAX_NUMBER_OF_EEPROM_VARS] = {0};
+
+tsMASTER_TEST_RESULTS sMasterTestResults = {0};
+tsSLAVE_TEST_RESULTS sSlaveTestResults = {0};
+
+// Simulated physical EEPROM of the journal backend
+uint32_t ui32JournalEEPROM[2 * EEPROM_JOURNAL_BANK_SIZE];
+uint32_t ui32JournalWear[2 * EEPROM_JOURNAL_BANK_SIZE];
+
+// Memory windows of the slave (1: Read only diagnostics, 2: Read / write configuration)
+uint8_t ui8DiagMemory[300];
+uint8_t ui8ConfigMemory[16];
+
+const tsSCI_MEM_WINDOW sTestMemWindows[] = {{ui8DiagMemory, sizeof(ui8DiagMemory), SCI_MEM_ACCESS_READ},
+                                            {ui8ConfigMemory, sizeof(ui8ConfigMemory), SCI_MEM_ACCESS_READ | SCI_MEM_ACCESS_WRITE}};
+
+// Downstream sink of the slave
+uint8_t ui8DownstreamSink[256];
+
+// Simulated microsecond clock
+uint32_t ui32SimClockUs = 0;
+
 /******************************************************************************
  * Function definitions
  *****************************************************************************/
@@ -43,6 +66,32 @@ bool SlaveGetBusyState (void)
         return true;
 }
 
+bool MasterGetBusyState (void)
+{
+    static uint8_t ui8BsyCnt = 0;
+
+    if (++ui8BsyCnt > 3)
+    {
+        ui8BsyCnt = 0;
+        return false;
+    }
+    else 
+        return true;
+}
+
+// Slave -> master line with simulated byte loss
+static void _SlaveLine(uint8_t* pui8Data, uint8_t ui8Size)
+{
+    for (uint8_t i = 0; i < ui8Size; i++)
+    {
+        uint32_t ui32Cnt = ++sMasterTestResults.ui32RxLineCnt;
+
+        if (sMasterTestResults.ui32RxDropAt == 0 || ui32Cnt < sMasterTestResults.ui32RxDropAt ||
+            ui32Cnt - sMasterTestResults.ui32RxDropAt > sMasterTestResults.ui32RxDropCnt)
+            SCIMasterReceiveData(&pui8Data[i], 1);
+    }
+}
+
 uint8_t SlaveTxCbNonBlocking(uint8_t* pui8Data, uint8_t ui8Size)
 {
     static uint8_t ui8Idx = 0;
@@ -51,14 +100,15 @@ uint8_t SlaveTxCbNonBlocking(uint8_t* pui8Data, uint8_t ui8Size)
     {
         ui8Idx = 1;
         cTxMsgBuf[0] = STX;
+        sSlaveTestResults.ui32TxFrameCnt++;
     }
     else
     {
         memcpy(&cTxMsgBuf[ui8Idx], pui8Data, ui8Size);
+        ui8Idx += ui8Size;
     }
 
-    for(uint8_t i = 0; i < ui8Size; i++)
-        SCIMasterReceiveData(&pui8Data[i], ui8Size);
+    _SlaveLine(pui8Data, ui8Size);
     
     return ui8Size;
 }
@@ -71,6 +121,7 @@ void SlaveTxCbBlocking(uint8_t* pui8Data, uint8_t ui8Size)
     {
         ui8Idx = 1;
         cTxMsgBuf[0] = STX;
+        sSlaveTestResults.ui32TxFrameCnt++;
     }
     else
     {
@@ -78,12 +129,13 @@ void SlaveTxCbBlocking(uint8_t* pui8Data, uint8_t ui8Size)
         ui8Idx += ui8Size;
     }
 
-    for(uint8_t i = 0; i < ui8Size; i++)
-        SCIMasterReceiveData(&pui8Data[i], ui8Size);   
+    _SlaveLine(pui8Data, ui8Size);
 }
 
 bool SlaveReadEEROM (uint32_t *ui32Val, uint16_t ui16Address)
 {
+    sSlaveTestResults.ui32EEPROMReadCnt++;
+
     #if EEPROM_ADDRESSTYPE == EEPROM_BYTE_ADDRESSABLE
     *ui32Val = ui8EEPROMByteAddressable[ui16Address];
     #elif EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
@@ -97,6 +149,11 @@ bool SlaveReadEEROM (uint32_t *ui32Val, uint16_t ui16Address)
 
 bool SlaveWriteEEROM (uint32_t ui32Val, uint16_t ui16Address)
 {
+    sSlaveTestResults.ui32EEPROMWriteCnt++;
+    sSlaveTestResults.ui16EEPROMLastAddress = ui16Address;
+    if (sSlaveTestResults.ui16EEPROMBadCell == ui16Address + 1)
+        return false;
+
     #if EEPROM_ADDRESSTYPE == EEPROM_BYTE_ADDRESSABLE
     ui8EEPROMByteAddressable[ui16Address] = ui32Val;
     #elif EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
@@ -108,11 +165,294 @@ bool SlaveWriteEEROM (uint32_t ui32Val, uint16_t ui16Address)
     return true;
 }
 
+bool SlaveReadEEROMBlock (uint32_t *pui32Vals, uint16_t ui16Address, uint16_t ui16Len)
+{
+    sSlaveTestResults.ui32EEPROMReadCnt++;
+
+    for (uint16_t i = 0; i < ui16Len; i++)
+    {
+        #if EEPROM_ADDRESSTYPE == EEPROM_BYTE_ADDRESSABLE
+        pui32Vals[i] = ui8EEPROMByteAddressable[ui16Address + i];
+        #elif EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
+        pui32Vals[i] = ui16EEPROMWordAddressable[ui16Address + i];
+        #else
+        pui32Vals[i] = ui32EEPROMDWordAddressable[ui16Address + i];
+        #endif
+    }
+
+    return true;
+}
+
+bool SlaveWriteEEROMBlock (const uint32_t *pui32Vals, uint16_t ui16Address, uint16_t ui16Len)
+{
+    sSlaveTestResults.ui32EEPROMWriteCnt++;
+    sSlaveTestResults.ui16EEPROMLastAddress = ui16Address;
+    if (sSlaveTestResults.ui16EEPROMBadCell > ui16Address && sSlaveTestResults.ui16EEPROMBadCell <= ui16Address + ui16Len)
+        return false;
+
+    for (uint16_t i = 0; i < ui16Len; i++)
+    {
+        #if EEPROM_ADDRESSTYPE == EEPROM_BYTE_ADDRESSABLE
+        ui8EEPROMByteAddressable[ui16Address + i] = pui32Vals[i];
+        #elif EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
+        ui16EEPROMWordAddressable[ui16Address + i] = pui32Vals[i];
+        #else
+        ui32EEPROMDWordAddressable[ui16Address + i] = pui32Vals[i];
+        #endif
+    }
+
+    return true;
+}
+
+bool SimJournalReadEEPROM (uint32_t *ui32Val, uint16_t ui16Address)
+{
+    if (ui16Address >= 2 * EEPROM_JOURNAL_BANK_SIZE)
+        return false;
+
+    *ui32Val = ui32JournalEEPROM[ui16Address];
+    return true;
+}
+
+bool SimJournalWriteEEPROM (uint32_t ui32Val, uint16_t ui16Address)
+{
+    if (ui16Address >= 2 * EEPROM_JOURNAL_BANK_SIZE)
+        return false;
+
+    ui32JournalEEPROM[ui16Address] = ui32Val;
+    ui32JournalWear[ui16Address]++;
+    return true;
+}
+
+bool SlaveDownstreamCb(int16_t i16Num, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8Len, uint32_t ui32Size)
+{
+    (void)i16Num;
+
+    // Announce
+    if (pui8Data == NULL)
+    {
+        sSlaveTestResults.ui32DownstreamSize = ui32Size;
+        sSlaveTestResults.ui32DownstreamChunkCnt = 0;
+        return ui32Size <= sizeof(ui8DownstreamSink);
+    }
+
+    // Simulated busy sink
+    if (sSlaveTestResults.ui8DownstreamRefuseCnt > 0)
+    {
+        sSlaveTestResults.ui8DownstreamRefuseCnt--;
+        return false;
+    }
+
+    memcpy(&ui8DownstreamSink[ui32Offset], pui8Data, ui8Len);
+    sSlaveTestResults.ui32DownstreamChunkCnt++;
+
+    return true;
+}
+
+void MasterTxCbBlocking(uint8_t* pui8Data, uint8_t ui8Size)
+{
+    sMasterTestResults.ui32TxLineCnt += ui8Size;
+
+    for(uint8_t i = 0; i < ui8Size; i++)
+    {
+        // Simulated frame loss
+        if (sMasterTestResults.ui8TxDropCnt == 0)
+            SCISlaveReceiveData(pui8Data[i]);
+        else if (pui8Data[i] == ETX)
+            sMasterTestResults.ui8TxDropCnt--;
+    }
+}
+
+void MasterNotifyCb(int16_t i16Num, uint32_t ui32Data)
+{
+    sMasterTestResults.ui32NotifyCnt++;
+    sMasterTestResults.i16Num = i16Num;
+    sMasterTestResults.ui32Data = ui32Data;
+}
+
+void MasterCompleteCb(int16_t i16Num, teREQUEST_ACKNOWLEDGE eAck)
+{
+    sMasterTestResults.ui32CompleteCnt++;
+    sMasterTestResults.i16Num = i16Num;
+    sMasterTestResults.eCompleteAck = eAck;
+}
+
+void MasterQueueDoneCb(void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum)
+{
+    uint32_t i = sMasterTestResults.ui32QueueDoneCnt++ % 16;
+
+    (void)i16Num;
+
+    sMasterTestResults.uQueueCtx[i] = (uintptr_t)pCtx;
+    sMasterTestResults.eQueueAck[i] = eAck;
+    sMasterTestResults.ui32QueueVal[i] = ui32Value;
+    sMasterTestResults.ui16QueueErr[i] = ui16ErrNum;
+}
+
+void MasterPollValueCb(void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum)
+{
+    uintptr_t i = (uintptr_t)pCtx % 8;
+
+    (void)i16Num;
+
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS)
+    {
+        sMasterTestResults.ui32PollErrors++;
+        sMasterTestResults.ui16PollErr = ui16ErrNum;
+        return;
+    }
+
+    sMasterTestResults.ui32PollCnt[i]++;
+    sMasterTestResults.ui32PollVal[i] = ui32Value;
+}
+
+teTRANSFER_ACK MasterDeltaCb(teREQUEST_ACKNOWLEDGE eAck, uint32_t ui32Generation, uint32_t *pui32Pairs, uint8_t ui8PairCnt, uint16_t ui16ErrNum)
+{
+    (void)eAck;
+    (void)ui16ErrNum;
+
+    sMasterTestResults.ui32DeltaCnt++;
+    sMasterTestResults.ui32Generation = ui32Generation;
+    sMasterTestResults.ui32PairCnt += ui8PairCnt;
+
+    if (ui8PairCnt > 0)
+    {
+        sMasterTestResults.ui32LastPair[0] = pui32Pairs[2 * ui8PairCnt - 2];
+        sMasterTestResults.ui32LastPair[1] = pui32Pairs[2 * ui8PairCnt - 1];
+    }
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+teTRANSFER_ACK MasterGetArrayCb(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    sMasterTestResults.eArrayAck = eAck;
+    sMasterTestResults.i16Num = i16Num;
+    sMasterTestResults.ui16ArrayErr = ui16ErrNum;
+    sMasterTestResults.ui32ArrayCnt = ui32DataCnt;
+
+    if (ui32DataCnt > 32)
+        ui32DataCnt = 32;
+
+    if (pui32Data != NULL)
+        memcpy(sMasterTestResults.ui32ArrayData, pui32Data, ui32DataCnt * sizeof(uint32_t));
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+teTRANSFER_ACK MasterMemoryCb(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Window, uint8_t *pui8Data, uint32_t ui32ByteCnt, uint16_t ui16ErrNum)
+{
+    sMasterTestResults.eMemAck = eAck;
+    sMasterTestResults.i16Num = i16Window;
+    sMasterTestResults.ui16MemErr = ui16ErrNum;
+    sMasterTestResults.ui32MemCnt = ui32ByteCnt;
+
+    if (ui32ByteCnt > sizeof(sMasterTestResults.ui8MemData))
+        ui32ByteCnt = sizeof(sMasterTestResults.ui8MemData);
+
+    if (pui8Data != NULL)
+        memcpy(sMasterTestResults.ui8MemData, pui8Data, ui32ByteCnt);
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+teTRANSFER_ACK MasterCommandCb(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    sMasterTestResults.eCmdAck = eAck;
+    sMasterTestResults.i16Num = i16Num;
+    sMasterTestResults.ui16CmdErr = ui16ErrNum;
+    sMasterTestResults.ui32CmdCnt = ui32DataCnt;
+    sMasterTestResults.ui32CmdSum = 0;
+
+    for (uint32_t i = 0; pui32Data != NULL && i < ui32DataCnt; i++)
+        sMasterTestResults.ui32CmdSum += pui32Data[i];
+
+    if (pui32Data != NULL && ui32DataCnt > 0)
+        sMasterTestResults.ui32CmdLast = pui32Data[ui32DataCnt - 1];
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+teTRANSFER_ACK MasterUpstreamCb(int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    sMasterTestResults.i16Num = i16Num;
+    sMasterTestResults.ui32UpsCnt = ui32ByteCnt;
+
+    if (ui32ByteCnt > sizeof(sMasterTestResults.ui8UpsData))
+        ui32ByteCnt = sizeof(sMasterTestResults.ui8UpsData);
+
+    // Streamed upstreams are delivered by the chunk callback
+    if (pui8Data != NULL)
+        memcpy(sMasterTestResults.ui8UpsData, pui8Data, ui32ByteCnt);
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+teTRANSFER_ACK MasterUpstreamChunkCb(int16_t i16Num, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8Len)
+{
+    (void)i16Num;
+
+    if (ui32Offset != sMasterTestResults.ui32ChunkBytes)
+        sMasterTestResults.ui32ChunkErrors++;
+
+    for (uint8_t i = 0; i < ui8Len; i++)
+    {
+        if (pui8Data[i] != (uint8_t)((ui32Offset + i) * 7 + 3))
+            sMasterTestResults.ui32ChunkErrors++;
+    }
+
+    sMasterTestResults.ui32ChunkCnt++;
+    sMasterTestResults.ui32ChunkBytes += ui8Len;
+    if (ui8Len > sMasterTestResults.ui8ChunkPeak)
+        sMasterTestResults.ui8ChunkPeak = ui8Len;
+
+    if (sMasterTestResults.ui32ChunkAbortAt > 0 && sMasterTestResults.ui32ChunkBytes >= sMasterTestResults.ui32ChunkAbortAt)
+        return eTRANSFER_ACK_ABORT;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+teTRANSFER_ACK MasterDownstreamCb(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32ByteCnt, uint16_t ui16ErrNum)
+{
+    sMasterTestResults.eDownAck = eAck;
+    sMasterTestResults.i16Num = i16Num;
+    sMasterTestResults.ui16DownErr = ui16ErrNum;
+    sMasterTestResults.ui32DownCnt = ui32ByteCnt;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
 /******************************************************************************
  * Callback structure definition
  *****************************************************************************/
+uint32_t SimClockUs(void)
+{
+    return ui32SimClockUs;
+}
+
+uint32_t SimClockMs(void)
+{
+    return ui32SimClockUs / 1000;
+}
+
 tsSCI_SLAVE_CALLBACKS sSlaveTestCbs =   {   .cbGetTxBusyState = SlaveGetBusyState,
                                             .cbTransmitBlocking = SlaveTxCbBlocking,
                                             .cbTransmitNonBlocking = SlaveTxCbNonBlocking,
                                             .cbReadEEPROM = SlaveReadEEROM,
-                                            .cbWriteEEPROM = SlaveWriteEEROM};
\ No newline at end of file
+                                            .cbWriteEEPROM = SlaveWriteEEROM,
+                                            .cbReadEEPROMBlock = SlaveReadEEROMBlock,
+                                            .cbWriteEEPROMBlock = SlaveWriteEEROMBlock,
+                                            .pMemWindows = sTestMemWindows,
+                                            .ui8MemWindowCnt = 2,
+                                            .cbDownstream = SlaveDownstreamCb,
+                                            .cbGetTimeUs = SimClockUs};
+
+tsSCI_MASTER_CALLBACKS sMasterTestCbs = {   .BlockingTxExternalCB = MasterTxCbBlocking,
+                                            .NotifyExternalCB = MasterNotifyCb,
+                                            .DeltaExternalCB = MasterDeltaCb,
+                                            .GetArrayExternalCB = MasterGetArrayCb,
+                                            .MemoryExternalCB = MasterMemoryCb,
+                                            .DownstreamExternalCB = MasterDownstreamCb,
+                                            .UpstreamExternalCB = MasterUpstreamCb,
+                                            .CommandExternalCB = MasterCommandCb,
+                                            .CompleteExternalCB = MasterCompleteCb,
+                                            .GetTickMsExternalCB = SimClockMs};
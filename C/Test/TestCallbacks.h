@@ -16,10 +16,92 @@
 #include <string.h>
 #include <stdlib.h>
 
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Results reported to the master test callbacks.*/
+typedef struct
+{
+    uint32_t ui32NotifyCnt;
+    int16_t  i16Num;
+    uint32_t ui32Data;
+    uint32_t ui32DeltaCnt;
+    uint32_t ui32Generation;
+    uint32_t ui32PairCnt;
+    uint32_t ui32LastPair[2];
+    teREQUEST_ACKNOWLEDGE eArrayAck;
+    uint16_t ui16ArrayErr;
+    uint32_t ui32ArrayCnt;
+    uint32_t ui32ArrayData[32];
+    teREQUEST_ACKNOWLEDGE eMemAck;
+    uint16_t ui16MemErr;
+    uint32_t ui32MemCnt;
+    uint8_t  ui8MemData[512];
+    teREQUEST_ACKNOWLEDGE eDownAck;
+    uint16_t ui16DownErr;
+    uint32_t ui32DownCnt;
+    uint32_t ui32UpsCnt;
+    uint8_t  ui8UpsData[1024];
+    teREQUEST_ACKNOWLEDGE eCmdAck;
+    uint16_t ui16CmdErr;
+    uint32_t ui32CmdCnt;
+    uint32_t ui32CmdSum;
+    uint32_t ui32CmdLast;
+    uint32_t ui32CompleteCnt;
+    teREQUEST_ACKNOWLEDGE eCompleteAck;
+    uint32_t ui32QueueDoneCnt;
+    uintptr_t uQueueCtx[16];
+    teREQUEST_ACKNOWLEDGE eQueueAck[16];
+    uint32_t ui32QueueVal[16];
+    uint16_t ui16QueueErr[16];
+    uint8_t  ui8TxDropCnt;              /*!< Number of master frames lost on the line.*/
+    uint32_t ui32TxLineCnt;             /*!< Bytes the master has sent to the slave.*/
+    uint32_t ui32ChunkCnt;
+    uint32_t ui32ChunkBytes;
+    uint32_t ui32ChunkErrors;           /*!< Gaps or unexpected data (pattern of test command 4).*/
+    uint8_t  ui8ChunkPeak;
+    uint32_t ui32ChunkAbortAt;          /*!< Abort the stream after this number of bytes (0: Never).*/
+    uint32_t ui32RxLineCnt;             /*!< Bytes the slave has sent to the master.*/
+    uint32_t ui32RxDropAt;              /*!< Slave byte lost on the line (1 based, 0: None).*/
+    uint32_t ui32RxDropCnt;             /*!< Further bytes lost after the first one (line outage).*/
+    uint32_t ui32PollCnt[8];            /*!< Values per polled variable (context = index).*/
+    uint32_t ui32PollVal[8];
+    uint32_t ui32PollErrors;
+    uint16_t ui16PollErr;               /*!< Error number of the last failed poll.*/
+}tsMASTER_TEST_RESULTS;
+
+/** \brief Access statistics of the simulated slave EEPROM.*/
+typedef struct
+{
+    uint32_t ui32EEPROMReadCnt;
+    uint32_t ui32EEPROMWriteCnt;
+    uint32_t ui32DownstreamSize;
+    uint32_t ui32DownstreamChunkCnt;
+    uint8_t  ui8DownstreamRefuseCnt;    /*!< Number of chunks the sink refuses (busy).*/
+    uint32_t ui32TxFrameCnt;            /*!< Frames sent by the slave.*/
+    uint16_t ui16EEPROMLastAddress;     /*!< Address of the latest EEPROM write.*/
+    uint16_t ui16EEPROMBadCell;         /*!< Address + 1 of a cell that fails to write (0: None).*/
+}tsSLAVE_TEST_RESULTS;
+
 /******************************************************************************
  * Global variable definition
  *****************************************************************************/
+extern tsMASTER_TEST_RESULTS sMasterTestResults;
+extern tsSLAVE_TEST_RESULTS sSlaveTestResults;
+extern uint16_t ui16EEPROMWordAddressable[];
+extern uint32_t ui32JournalEEPROM[];
+extern uint32_t ui32JournalWear[];
+extern uint8_t ui8DiagMemory[];
+extern uint8_t ui8ConfigMemory[];
+extern uint8_t ui8DownstreamSink[];
+extern uint32_t ui32SimClockUs;
 
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
+bool SimJournalReadEEPROM (uint32_t *ui32Val, uint16_t ui16Address);
+bool MasterGetBusyState (void);
+teTRANSFER_ACK MasterUpstreamChunkCb(int16_t i16Num, uint32_t ui32Offset, const uint8_t *pui8Data, uint8_t ui8Len);
+void MasterQueueDoneCb(void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum);
+void MasterPollValueCb(void *pCtx, teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Value, uint16_t ui16ErrNum);
+bool SimJournalWriteEEPROM (uint32_t ui32Val, uint16_t ui16Address);
@@ -1,27 +1,50 @@
 #include <stdio.h>
+#include <time.h>
+#include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <unity.h>
 #include "SCISlave.h"
 #include "SCIMaster.h"
+#include "SCIEEPROMJournal.h"
+#include "SCIVarTable.h"
+#include "TestCallbacks.h"
 
 /******************************************************************************
  * Defines
  *****************************************************************************/
 #define NUMBER_OF_LOOPS 100
+#define NUMBER_OF_TRANSFER_LOOPS 4000
+#define BYTE_TIME 4                 // State machine calls per transmitted byte (see SlaveGetBusyState / MasterGetBusyState)
 
 /******************************************************************************
  * External Globals
  *****************************************************************************/
-extern tsSCIVAR varStruct;
-extern COMMAND_CB cmdStruct;
+extern const tsSCIVAR varStruct[];
+extern COMMAND_CB cmdStruct[];
 extern tsSCI_SLAVE_CALLBACKS sSlaveTestCbs;
+extern tsSCI_MASTER_CALLBACKS sMasterTestCbs;
 extern char cTxMsgBuf[];
 extern char cRxMsgBuf[];
+extern uint8_t ui8_test;
+extern uint32_t i32_test;
+extern uint16_t ui16_eeTest;
+extern uint32_t ui32_eeTest;
+extern uint16_t ui16_arrTest[];
+extern uint64_t ui64_test;
+extern uint32_t ui32_modTest;
+extern uint32_t ui32_upsSourceReads;
+extern uint32_t ui32_genCalls;
+extern uint32_t ui32_genVals;
+extern uint8_t ui8_genPeak;
+extern uint32_t ui32_asyncCalls;
+extern uint32_t ui32_stepCalls;
+extern uint8_t ui8_upsSourcePeak;
+extern uint32_t ui32_upsSourceBytes;
 
 void setUp(void)
 {
-    SCISlaveInit(sSlaveTestCbs, &varStruct, &cmdStruct);
+    SCISlaveInit(sSlaveTestCbs, varStruct, cmdStruct);
 }
 
 void tearDown(void)
@@ -111,6 +134,1275 @@ void test_SCISlavePollVarF32 (void)
     TEST_ASSERT_EQUAL_CHAR_ARRAY(ui8AnsExp,cTxMsgBuf, sizeof(ui8AnsExp));
 }
 
+void test_SCISlaveRawVarAccess (void)
+{
+    tsVAR_ACCESS sVarAccess = tsVAR_ACCESS_DEFAULTS;
+    uint32_t ui32FormerVal = i32_test;
+    uint32_t ui32Val = 0;
+
+    sVarAccess.pVarStruct = varStruct;
+
+    // Values above 2^24 pass without a float round trip
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, WriteRawToVarStruct(&sVarAccess, 5, 0x89ABCDEF));
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, ReadRawFromVarStruct(&sVarAccess, 5, &ui32Val));
+    TEST_ASSERT_EQUAL(0x89ABCDEF, ui32Val);
+
+    // Writes are truncated to the variable size
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, WriteRawToVarStruct(&sVarAccess, 3, 0x1F5));
+    TEST_ASSERT_EQUAL(0xF5, ui8_test);
+
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID, ReadRawFromVarStruct(&sVarAccess, SIZE_OF_VAR_STRUCT + 1, &ui32Val));
+
+    i32_test = ui32FormerVal;
+}
+
+void test_SCISlaveNotifyDeadband (void)
+{
+    uint8_t ui8AnsExp[]= {0x02, '3', '*', 'F', '8', 0x03};
+    tuREQUESTVALUE uDeadband = {.ui32_hex = 2};
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(cTxMsgBuf, 0, sizeof(ui8AnsExp));
+    sMasterTestResults.ui32NotifyCnt = 0;
+
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, SCISlaveSubscribeVar(3, uDeadband));
+
+    // Change within the deadband
+    ui8_test = 247;
+    for(uint8_t i = 0; i < NUMBER_OF_LOOPS; i++)
+    {
+        SCISlaveStatemachine();
+        SCIMasterSM();
+    }
+    TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32NotifyCnt);
+
+    // Change exceeds the deadband
+    ui8_test = 248;
+    for(uint8_t i = 0; i < NUMBER_OF_LOOPS; i++)
+    {
+        SCISlaveStatemachine();
+        SCIMasterSM();
+    }
+
+    SCISlaveUnsubscribeVar(3);
+    ui8_test = 245;
+
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(ui8AnsExp,cTxMsgBuf, sizeof(ui8AnsExp));
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32NotifyCnt);
+    TEST_ASSERT_EQUAL(3, sMasterTestResults.i16Num);
+    TEST_ASSERT_EQUAL(0xF8, sMasterTestResults.ui32Data);
+}
+
+void test_SCISlaveDeltaRead (void)
+{
+    tuREQUESTVALUE uVal = {.ui32_hex = 0xF0};
+    uint32_t ui32Generation;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    // Generation 0 reports all variables (more than fit into one response)
+    SCIRequestDelta(0);
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+    TEST_ASSERT_EQUAL((SIZE_OF_VAR_STRUCT + MAX_NUM_DELTA_PAIRS - 1) / MAX_NUM_DELTA_PAIRS, sMasterTestResults.ui32DeltaCnt);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32DeltaCnt > 1);
+    TEST_ASSERT_EQUAL(SIZE_OF_VAR_STRUCT, sMasterTestResults.ui32PairCnt);
+    ui32Generation = sMasterTestResults.ui32Generation;
+
+    SCIRequestSetVar(3, uVal);
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+
+    // Only the modified variable is reported
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    SCIRequestDelta(ui32Generation);
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+    ui8_test = 245;
+
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32DeltaCnt);
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32PairCnt);
+    TEST_ASSERT_EQUAL(3, sMasterTestResults.ui32LastPair[0]);
+    TEST_ASSERT_EQUAL(0xF0, sMasterTestResults.ui32LastPair[1]);
+    TEST_ASSERT_EQUAL(ui32Generation + 1, sMasterTestResults.ui32Generation);
+}
+
+static void _RunTransfer (void)
+{
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+}
+
+static void _RunTransferTimed (void)
+{
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        ui32SimClockUs += 1000;
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+}
+
+void test_SCISlaveArrayAccess (void)
+{
+    tuREQUESTVALUE uVals[2] = {{.ui32_hex = 0xBEEF}, {.ui32_hex = 0xCAFE}};
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    for (uint8_t i = 0; i < 20; i++)
+        ui16_arrTest[i] = 0x100 + i;
+
+    // Whole array, spans several responses
+    SCIRequestGetArray(8, 0, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS_DATA, sMasterTestResults.eArrayAck);
+    TEST_ASSERT_EQUAL(20, sMasterTestResults.ui32ArrayCnt);
+    for (uint8_t i = 0; i < 20; i++)
+        TEST_ASSERT_EQUAL(0x100 + i, sMasterTestResults.ui32ArrayData[i]);
+
+    // Slice
+    SCIRequestGetArray(8, 5, 3);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(3, sMasterTestResults.ui32ArrayCnt);
+    TEST_ASSERT_EQUAL(0x105, sMasterTestResults.ui32ArrayData[0]);
+    TEST_ASSERT_EQUAL(0x107, sMasterTestResults.ui32ArrayData[2]);
+
+    // Out of range slice
+    SCIRequestGetArray(8, 18, 3);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eArrayAck);
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_ARRAY_RANGE_INVALID + SCI_ERROR_OFFSET, sMasterTestResults.ui16ArrayErr);
+
+    // Write two elements
+    TEST_ASSERT_TRUE(SCIRequestSetArray(8, 18, uVals, 2));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(0xBEEF, ui16_arrTest[18]);
+    TEST_ASSERT_EQUAL(0xCAFE, ui16_arrTest[19]);
+    TEST_ASSERT_EQUAL(0x111, ui16_arrTest[17]);
+
+    // 64 bit variable: Low word first
+    SCIRequestGetArray(9, 0, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(2, sMasterTestResults.ui32ArrayCnt);
+    TEST_ASSERT_EQUAL(0x89ABCDEF, sMasterTestResults.ui32ArrayData[0]);
+    TEST_ASSERT_EQUAL(0x01234567, sMasterTestResults.ui32ArrayData[1]);
+
+    uVals[0].ui32_hex = 0x11111111;
+    uVals[1].ui32_hex = 0x22222222;
+    TEST_ASSERT_TRUE(SCIRequestSetArray(9, 0, uVals, 2));
+    _RunTransfer();
+    TEST_ASSERT_TRUE(ui64_test == 0x2222222211111111ULL);
+    ui64_test = 0x0123456789ABCDEFULL;
+}
+
+void test_SCISlaveMemoryWindow (void)
+{
+    uint8_t ui8Data[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    for (uint16_t i = 0; i < 300; i++)
+        ui8DiagMemory[i] = (uint8_t)(i * 7);
+
+    // Read spanning several upstream packets
+    SCIRequestMemRead(1, 10, 280);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM, sMasterTestResults.eMemAck);
+    TEST_ASSERT_EQUAL(280, sMasterTestResults.ui32MemCnt);
+    TEST_ASSERT_EQUAL_MEMORY(&ui8DiagMemory[10], sMasterTestResults.ui8MemData, 280);
+
+    // Outside of the window
+    SCIRequestMemRead(1, 290, 11);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eMemAck);
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_MEM_ACCESS_INVALID + SCI_ERROR_OFFSET, sMasterTestResults.ui16MemErr);
+
+    // Unknown window
+    SCIRequestMemRead(3, 0, 1);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_MEM_WINDOW_INVALID + SCI_ERROR_OFFSET, sMasterTestResults.ui16MemErr);
+
+    // Read only window
+    TEST_ASSERT_TRUE(SCIRequestMemWrite(1, 0, ui8Data, sizeof(ui8Data)));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eMemAck);
+    TEST_ASSERT_EQUAL(0, ui8DiagMemory[0]);
+
+    memset(ui8ConfigMemory, 0, 16);
+    TEST_ASSERT_TRUE(SCIRequestMemWrite(2, 9, ui8Data, sizeof(ui8Data)));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eMemAck);
+    TEST_ASSERT_EQUAL_MEMORY(ui8Data, &ui8ConfigMemory[9], sizeof(ui8Data));
+    TEST_ASSERT_EQUAL(0, ui8ConfigMemory[8]);
+    TEST_ASSERT_EQUAL(0, ui8ConfigMemory[15]);
+}
+
+static void _SlaveRequest (const char *pcReq)
+{
+    SCISlaveReceiveData(STX);
+    while (*pcReq != '\0')
+        SCISlaveReceiveData((uint8_t)*pcReq++);
+    SCISlaveReceiveData(ETX);
+
+    _RunTransfer();
+}
+
+void test_SCISlaveDownstream (void)
+{
+    uint8_t ui8Data[300];
+    uint8_t ui8AnsExp[]= {0x02, '5', '<', 'A', 'C', 'K', ';', 'A', 0x03};
+    char cReq[32];
+    uint8_t ui8Len;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    memset(ui8DownstreamSink, 0, 256);
+
+    for (uint16_t i = 0; i < sizeof(ui8Data); i++)
+        ui8Data[i] = (uint8_t)(i * 13 + 1);
+
+    // Chunks require an announced transfer
+    TEST_ASSERT_TRUE(SCIRequestDownstreamResume(5, ui8Data, 200));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eDownAck);
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_DOWNSTREAM_NOT_INITIATED + SCI_ERROR_OFFSET, sMasterTestResults.ui16DownErr);
+
+    // The sink rejects transfers it can't hold
+    TEST_ASSERT_TRUE(SCIRequestDownstream(5, ui8Data, 300));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_DOWNSTREAM_REJECTED + SCI_ERROR_OFFSET, sMasterTestResults.ui16DownErr);
+
+    // Several chunks, the sink is busy twice -> The chunk is repeated after a backoff
+    sSlaveTestResults.ui8DownstreamRefuseCnt = 2;
+    TEST_ASSERT_TRUE(SCIRequestDownstream(5, ui8Data, 200));
+    _RunTransferTimed();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eDownAck);
+    TEST_ASSERT_EQUAL(200, sMasterTestResults.ui32DownCnt);
+    TEST_ASSERT_EQUAL(200, sSlaveTestResults.ui32DownstreamSize);
+    TEST_ASSERT_EQUAL((200 + SCI_DOWNSTREAM_CHUNK_MAX_BYTES - 1) / SCI_DOWNSTREAM_CHUNK_MAX_BYTES, sSlaveTestResults.ui32DownstreamChunkCnt);
+    TEST_ASSERT_EQUAL(0, sSlaveTestResults.ui8DownstreamRefuseCnt);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ui8Data, ui8DownstreamSink, 200);
+
+    // Interrupted transfer: Announce and first chunk of another master
+    memset(ui8DownstreamSink, 0, 256);
+    _SlaveRequest("5<C8");
+    ui8Len = (uint8_t)sprintf(cReq, "5<0;");
+    for (uint8_t i = 0; i < 10; i++)
+        ui8Len += (uint8_t)sprintf(&cReq[ui8Len], "%02X", ui8Data[i]);
+    _SlaveRequest(cReq);
+
+    // A repeated chunk is acknowledged, but not consumed again
+    _SlaveRequest(cReq);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(ui8AnsExp, cTxMsgBuf, sizeof(ui8AnsExp));
+    TEST_ASSERT_EQUAL(1, sSlaveTestResults.ui32DownstreamChunkCnt);
+
+    // Resume at the acknowledged offset
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    TEST_ASSERT_TRUE(SCIRequestDownstreamResume(5, ui8Data, 200));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eDownAck);
+    TEST_ASSERT_EQUAL(200, sMasterTestResults.ui32DownCnt);
+    TEST_ASSERT_EQUAL(1 + (190 + SCI_DOWNSTREAM_CHUNK_MAX_BYTES - 1) / SCI_DOWNSTREAM_CHUNK_MAX_BYTES, sSlaveTestResults.ui32DownstreamChunkCnt);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ui8Data, ui8DownstreamSink, 200);
+
+    // The sink stays busy -> The master gives up after the retries of the policy
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    sSlaveTestResults.ui8DownstreamRefuseCnt = 100;
+    TEST_ASSERT_TRUE(SCIRequestDownstream(5, ui8Data, 200));
+    _RunTransferTimed();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eDownAck);
+    TEST_ASSERT_EQUAL(eSCI_MASTER_ERROR_DOWNSTREAM_REFUSED, sMasterTestResults.ui16DownErr);
+    TEST_ASSERT_EQUAL(100 - (SCI_MASTER_MAX_RETRIES + 1), sSlaveTestResults.ui8DownstreamRefuseCnt);
+    sSlaveTestResults.ui8DownstreamRefuseCnt = 0;
+}
+
+void test_SCISlaveUpstreamSource (void)
+{
+    tuREQUESTVALUE uSize = {.ui32_hex = 1000};
+    uint8_t ui8Loops = 0;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    ui32_upsSourceReads = 0;
+    ui8_upsSourcePeak = 0;
+    ui32_upsSourceBytes = 0;
+
+    SCIRequestCommand(4, &uSize, 1);
+    while (sMasterTestResults.ui32UpsCnt == 0 && ui8Loops++ < 10)
+        _RunTransfer();
+
+    TEST_ASSERT_EQUAL(1000, sMasterTestResults.ui32UpsCnt);
+    for (uint16_t i = 0; i < 1000; i++)
+        TEST_ASSERT_EQUAL((uint8_t)(i * 7 + 3), sMasterTestResults.ui8UpsData[i]);
+
+    // The source is read once per packet: At most one packet is staged, every byte is read once
+    TEST_ASSERT_EQUAL((1000 + TX_PACKET_LENGTH - 1) / TX_PACKET_LENGTH, ui32_upsSourceReads);
+    TEST_ASSERT_EQUAL(TX_PACKET_LENGTH, ui8_upsSourcePeak);
+    TEST_ASSERT_EQUAL(1000, ui32_upsSourceBytes);
+    printf("Upstream source: 1000 bytes in %u reads, peak staging %u bytes\n", (unsigned)ui32_upsSourceReads, (unsigned)ui8_upsSourcePeak);
+}
+
+void test_SCIMasterUpstreamChunks (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = sMasterTestCbs;
+    tuREQUESTVALUE uSize = {.ui32_hex = 40000};
+    uint16_t ui16Loops = 0;
+
+    // Larger than the transfer pool, nothing is buffered by the master
+    sCbs.UpstreamChunkExternalCB = MasterUpstreamChunkCb;
+    SCIMasterInit(sCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    SCIRequestCommand(4, &uSize, 1);
+    while (sMasterTestResults.ui32UpsCnt == 0 && ui16Loops++ < 1000)
+        _RunTransfer();
+
+    TEST_ASSERT_EQUAL(40000, sMasterTestResults.ui32UpsCnt);
+    TEST_ASSERT_EQUAL(40000, sMasterTestResults.ui32ChunkBytes);
+    TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32ChunkErrors);
+    TEST_ASSERT_EQUAL((40000 + TX_PACKET_LENGTH - 1) / TX_PACKET_LENGTH, sMasterTestResults.ui32ChunkCnt);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui8ChunkPeak <= RX_PACKET_LENGTH);
+
+    // The application stops the stream
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    sMasterTestResults.ui32ChunkAbortAt = 300;
+    SCIRequestCommand(4, &uSize, 1);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(3 * TX_PACKET_LENGTH, sMasterTestResults.ui32UpsCnt);
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+}
+
+void test_SCIMasterUpstreamThroughput (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = sMasterTestCbs;
+    tuREQUESTVALUE uSize = {.ui32_hex = 40000};
+    uint32_t ui32Calls = 0;
+    uint32_t ui32Percent;
+
+    sCbs.UpstreamChunkExternalCB = MasterUpstreamChunkCb;
+    sCbs.GetTxBusyStateExternalCB = MasterGetBusyState;
+    SCIMasterInit(sCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    SCIRequestCommand(4, &uSize, 1);
+    while (sMasterTestResults.ui32UpsCnt == 0 && ui32Calls < 1000000)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+        ui32Calls++;
+    }
+    // Let the link settle (final acknowledge of the free running upstream)
+    _RunTransfer();
+
+    // Simulated UART: Both sides transmit one byte every BYTE_TIME state machine calls
+    ui32Percent = (uint32_t)((uint64_t)uSize.ui32_hex * BYTE_TIME * 100 / ui32Calls);
+    printf("Upstream throughput: %u bytes in %u byte times (%u %% of the line rate)\n", 
+           (unsigned)uSize.ui32_hex, (unsigned)(ui32Calls / BYTE_TIME), (unsigned)ui32Percent);
+
+    TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32ChunkErrors);
+    TEST_ASSERT_EQUAL(uSize.ui32_hex, sMasterTestResults.ui32ChunkBytes);
+    #if defined(SCI_MASTER_UPSTREAM_PIPELINE) || defined(SCI_MASTER_UPSTREAM_WINDOW)
+    // Only the frame overhead remains, the link doesn't idle between the chunks
+    TEST_ASSERT_TRUE(ui32Percent >= 97);
+    #else
+    TEST_ASSERT_TRUE(ui32Percent >= 90);
+    #endif
+}
+
+void test_SCISlaveCommandGenerator (void)
+{
+    const uint32_t ui32Cnt = 2000;
+    tuREQUESTVALUE uCnt = {.ui32_hex = ui32Cnt};
+    uint32_t ui32SumExp = 0;
+    uint8_t ui8Loops = 0;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    ui32_genCalls = 0;
+    ui32_genVals = 0;
+    ui8_genPeak = 0;
+    sSlaveTestResults.ui32TxFrameCnt = 0;
+
+    SCIRequestCommand(5, &uCnt, 1);
+    while (sMasterTestResults.ui32CmdCnt == 0 && ui8Loops++ < 100)
+        _RunTransfer();
+
+    for (uint32_t i = 0; i < ui32Cnt; i++)
+        ui32SumExp += i * 3 + 1;
+
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS_DATA, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(ui32Cnt, sMasterTestResults.ui32CmdCnt);
+    TEST_ASSERT_EQUAL(ui32SumExp, sMasterTestResults.ui32CmdSum);
+    TEST_ASSERT_EQUAL((ui32Cnt - 1) * 3 + 1, sMasterTestResults.ui32CmdLast);
+
+    // The generator fills whole packets window by window, no value is generated twice
+    TEST_ASSERT_TRUE(ui8_genPeak <= SCI_RESPONSE_GEN_WINDOW);
+    TEST_ASSERT_EQUAL(ui32Cnt, ui32_genVals);
+    TEST_ASSERT_EQUAL((ui32Cnt + MAX_NUM_RESPONSE_VALUES - 1) / MAX_NUM_RESPONSE_VALUES, sSlaveTestResults.ui32TxFrameCnt);
+    printf("Result generator: %u values in %u frames, %u generated\n", (unsigned)ui32Cnt, (unsigned)sSlaveTestResults.ui32TxFrameCnt, (unsigned)ui32_genVals);
+}
+
+void test_SCISlaveAsyncCommand (void)
+{
+    tuRESPONSEVALUE uResults[2] = {{.ui32_hex = 0x12}, {.ui32_hex = 0x34}};
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    ui32_asyncCalls = 0;
+
+    SCIRequestCommand(6, NULL, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_PENDING, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(1, ui32_asyncCalls);
+
+    // Other requests are served while the command is running
+    SCIRequestGetArray(8, 0, 2);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS_DATA, sMasterTestResults.eArrayAck);
+
+    // Repeating the command polls it
+    SCIRequestCommand(6, NULL, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_PENDING, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(1, ui32_asyncCalls);
+
+    // The completion is announced unsolicited
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, SCISlaveCompleteCommand(6, eREQUEST_ACK_STATUS_SUCCESS_DATA, uResults, 2, 0));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32CompleteCnt);
+    TEST_ASSERT_EQUAL(6, sMasterTestResults.i16Num);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS_DATA, sMasterTestResults.eCompleteAck);
+
+    // Fetch the result
+    SCIRequestCommand(6, NULL, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS_DATA, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(2, sMasterTestResults.ui32CmdCnt);
+    TEST_ASSERT_EQUAL(0x34, sMasterTestResults.ui32CmdLast);
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_COMMAND_NOT_PENDING, SCISlaveCompleteCommand(6, eREQUEST_ACK_STATUS_SUCCESS, NULL, 0, 0));
+
+    // The next invocation executes the command again, this time failing
+    SCIRequestCommand(6, NULL, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(2, ui32_asyncCalls);
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, SCISlaveCompleteCommand(6, eREQUEST_ACK_STATUS_ERROR, NULL, 0, 0x42));
+    _RunTransfer();
+    SCIRequestCommand(6, NULL, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(0x42, sMasterTestResults.ui16CmdErr);
+    TEST_ASSERT_EQUAL(2, sMasterTestResults.ui32CompleteCnt);
+}
+
+void test_SCISlaveCommandSteps (void)
+{
+    tuREQUESTVALUE uSteps = {.ui32_hex = 50};
+    uint32_t ui32MaxCallUs = 0;
+    uint32_t ui32Loops = 0;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+    ui32_stepCalls = 0;
+
+    // Measure the time the slave spends per state machine call until the completion is announced
+    SCIRequestCommand(7, &uSteps, 1);
+    while (sMasterTestResults.ui32CompleteCnt == 0 && ui32Loops++ < NUMBER_OF_TRANSFER_LOOPS)
+    {
+        uint32_t ui32Start = ui32SimClockUs;
+
+        SCIMasterSM();
+        SCISlaveStatemachine();
+
+        if (ui32SimClockUs - ui32Start > ui32MaxCallUs)
+            ui32MaxCallUs = ui32SimClockUs - ui32Start;
+    }
+
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_PENDING, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32CompleteCnt);
+    TEST_ASSERT_EQUAL(50, ui32_stepCalls);
+
+    // Steps are only started if they end within the budget
+    TEST_ASSERT_TRUE(ui32MaxCallUs <= SCI_COMMAND_STEP_BUDGET_US);
+    printf("Command steps: 50 steps of 30 us, max. %u us per state machine call (budget %u us)\n", 
+        (unsigned)ui32MaxCallUs, (unsigned)SCI_COMMAND_STEP_BUDGET_US);
+
+    // The result is fetched like for any pending command
+    SCIRequestCommand(7, NULL, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS_DATA, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32CmdCnt);
+    TEST_ASSERT_EQUAL(50, sMasterTestResults.ui32CmdLast);
+}
+
+void test_SCIMasterRequestQueue (void)
+{
+    tuREQUESTVALUE uVal = {.ui32_hex = 0x55AA};
+    uint32_t ui32Gaps = 0;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_SETVAR, 7, &uVal, 1, MasterQueueDoneCb, (void*)1));
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 7, NULL, 0, MasterQueueDoneCb, (void*)2));
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_COMMAND, 1, NULL, 0, MasterQueueDoneCb, (void*)3));
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 5, NULL, 0, MasterQueueDoneCb, (void*)4));
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 99, NULL, 0, MasterQueueDoneCb, (void*)5));
+    TEST_ASSERT_FALSE(SCIQueueRequest(eREQUEST_TYPE_UPSTREAM, 1, NULL, 0, MasterQueueDoneCb, NULL));
+
+    // The master is never idle while requests are queued
+    for (uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS && SCIGetQueuedRequestCount() > 0; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+
+        if (SCIGetQueuedRequestCount() > 0 && SCIGetProtocolState() == ePROTOCOL_IDLE)
+            ui32Gaps++;
+    }
+
+    TEST_ASSERT_EQUAL(0, ui32Gaps);
+    TEST_ASSERT_EQUAL(5, sMasterTestResults.ui32QueueDoneCnt);
+    for (uintptr_t i = 0; i < 5; i++)
+        TEST_ASSERT_EQUAL(i + 1, sMasterTestResults.uQueueCtx[i]);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[0]);
+    TEST_ASSERT_EQUAL(0x55AA, sMasterTestResults.ui32QueueVal[1]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[3]);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eQueueAck[4]);
+
+    // Bounded: The active request occupies an entry as well
+    for (uint8_t i = 0; i < SCI_MASTER_QUEUE_LENGTH; i++)
+        TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 3, NULL, 0, NULL, NULL));
+    TEST_ASSERT_FALSE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 3, NULL, 0, NULL, NULL));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(0, SCIGetQueuedRequestCount());
+}
+
+void test_SCIMasterTimeoutRetry (void)
+{
+    tsSCI_MASTER_STATS sStats;
+    tuREQUESTVALUE uVal = {.ui32_hex = 0x55AA};
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    // A lost GETVAR is sent again
+    sMasterTestResults.ui8TxDropCnt = 1;
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 5, NULL, 0, MasterQueueDoneCb, (void*)1));
+    _RunTransferTimed();
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[0]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[0]);
+    TEST_ASSERT_EQUAL(1, sStats.ui32Timeouts);
+    TEST_ASSERT_EQUAL(1, sStats.ui32Retries);
+    TEST_ASSERT_EQUAL(0, sStats.ui32Failures);
+
+    // Retries are bounded, afterwards the timeout is reported
+    sMasterTestResults.ui8TxDropCnt = 10;
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 5, NULL, 0, MasterQueueDoneCb, (void*)2));
+    _RunTransferTimed();
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_EQUAL(7, sMasterTestResults.ui8TxDropCnt);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eQueueAck[1]);
+    TEST_ASSERT_EQUAL(eSCI_MASTER_ERROR_RESPONSE_TIMEOUT, sMasterTestResults.ui16QueueErr[1]);
+    TEST_ASSERT_EQUAL(1 + SCI_MASTER_MAX_RETRIES, sStats.ui32Retries);
+    TEST_ASSERT_EQUAL(1, sStats.ui32Failures);
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+
+    // COMMANDs are not repeated
+    sMasterTestResults.ui8TxDropCnt = 10;
+    TEST_ASSERT_TRUE(SCIRequestCommand(1, NULL, 0));
+    _RunTransferTimed();
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_EQUAL(9, sMasterTestResults.ui8TxDropCnt);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(eSCI_MASTER_ERROR_RESPONSE_TIMEOUT, sMasterTestResults.ui16CmdErr);
+    TEST_ASSERT_EQUAL(1 + SCI_MASTER_MAX_RETRIES, sStats.ui32Retries);
+    TEST_ASSERT_EQUAL(2, sStats.ui32Failures);
+
+    // The line is back
+    sMasterTestResults.ui8TxDropCnt = 0;
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 5, NULL, 0, MasterQueueDoneCb, (void*)3));
+    _RunTransferTimed();
+    TEST_ASSERT_EQUAL(3, sMasterTestResults.ui32QueueDoneCnt);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[2]);
+    TEST_ASSERT_EQUAL(0, SCIGetMasterStats().ui32StaleFrames);
+
+    // SETVARs are not repeated by default ...
+    sMasterTestResults.ui8TxDropCnt = 10;
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_SETVAR, 7, &uVal, 1, MasterQueueDoneCb, (void*)4));
+    _RunTransferTimed();
+    TEST_ASSERT_EQUAL(9, sMasterTestResults.ui8TxDropCnt);
+    TEST_ASSERT_EQUAL(eSCI_MASTER_ERROR_RESPONSE_TIMEOUT, sMasterTestResults.ui16QueueErr[3]);
+
+    // ... unless enabled
+    sMasterTestResults.ui8TxDropCnt = 1;
+    TEST_ASSERT_TRUE(SCISetRetryPolicy(eREQUEST_TYPE_SETVAR, SCI_MASTER_TIMEOUT_MS, 1));
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_SETVAR, 7, &uVal, 1, MasterQueueDoneCb, (void*)5));
+    _RunTransferTimed();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[4]);
+}
+
+void test_SCIMasterDeferredRequest (void)
+{
+    tsREQUEST sUnanswered = {3, eREQUEST_TYPE_GETVAR, NULL, 0, NULL, 0};
+    uint32_t ui32TxBytes;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    // The transmitter is busy with a request without response
+    TEST_ASSERT_TRUE(SCIInitiateUnansweredRequest(sUnanswered));
+    ui32TxBytes = sMasterTestResults.ui32TxLineCnt;
+
+    // The next request is deferred instead of waiting for the transmitter
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 5, NULL, 0, MasterQueueDoneCb, (void*)1));
+    TEST_ASSERT_EQUAL(ePROTOCOL_SENDING, SCIGetProtocolState());
+    TEST_ASSERT_EQUAL(ui32TxBytes, sMasterTestResults.ui32TxLineCnt);
+
+    // Both frames are sent completely, the stale response is dropped
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32QueueDoneCnt);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[0]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[0]);
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+}
+
+#ifdef SCI_MASTER_UPSTREAM_WINDOW
+void test_SCIMasterUpstreamWindowLoss (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = sMasterTestCbs;
+    tuREQUESTVALUE uSize = {.ui32_hex = 3000};
+    tsSCI_MASTER_STATS sStats;
+    uint16_t ui16Loops = 0;
+
+    sCbs.UpstreamChunkExternalCB = MasterUpstreamChunkCb;
+    SCIMasterInit(sCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    // A byte of the fifth chunk is lost, the following chunks of the window are dropped as well
+    sMasterTestResults.ui32RxDropAt = 600;
+    SCIRequestCommand(4, &uSize, 1);
+    while (sMasterTestResults.ui32UpsCnt == 0 && ui16Loops++ < 100)
+        _RunTransferTimed();
+    _RunTransferTimed();
+
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_EQUAL(uSize.ui32_hex, sMasterTestResults.ui32UpsCnt);
+    TEST_ASSERT_EQUAL(uSize.ui32_hex, sMasterTestResults.ui32ChunkBytes);
+    TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32ChunkErrors);
+    TEST_ASSERT_EQUAL(1, sStats.ui32Retries);
+    TEST_ASSERT_EQUAL(0, sStats.ui32Failures);
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+
+    // The link is ready for the next request
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 5, NULL, 0, MasterQueueDoneCb, (void*)1));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[0]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[0]);
+}
+#endif
+
+void test_SCIMasterUpstreamResume (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = sMasterTestCbs;
+    tuREQUESTVALUE uSize = {.ui32_hex = 1500};
+    tsSCI_MASTER_STATS sStats;
+    uint16_t ui16Loops = 0;
+
+    sCbs.UpstreamChunkExternalCB = MasterUpstreamChunkCb;
+    SCIMasterInit(sCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    // Nothing to resume
+    TEST_ASSERT_FALSE(SCIResumeUpstream());
+
+    // The line fails in the middle of the upstream, all retries are lost
+    sMasterTestResults.ui32RxDropAt = 500;
+    sMasterTestResults.ui32RxDropCnt = UINT32_MAX;
+    SCIRequestCommand(4, &uSize, 1);
+    _RunTransferTimed();
+
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(eSCI_MASTER_ERROR_RESPONSE_TIMEOUT, sMasterTestResults.ui16CmdErr);
+    TEST_ASSERT_EQUAL(SCI_MASTER_MAX_RETRIES, sStats.ui32Retries);
+    TEST_ASSERT_EQUAL(1, sStats.ui32Failures);
+    TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32UpsCnt);
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+
+    // Line restored -> Continue with the first byte that is missing
+    sMasterTestResults.ui32RxDropAt = 0;
+    TEST_ASSERT_TRUE(SCIResumeUpstream());
+    while (sMasterTestResults.ui32UpsCnt == 0 && ui16Loops++ < 100)
+        _RunTransferTimed();
+    _RunTransferTimed();
+
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_EQUAL(uSize.ui32_hex, sMasterTestResults.ui32UpsCnt);
+    TEST_ASSERT_EQUAL(uSize.ui32_hex, sMasterTestResults.ui32ChunkBytes);
+    TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32ChunkErrors);
+    TEST_ASSERT_EQUAL(1, sStats.ui32Failures);
+    TEST_ASSERT_FALSE(SCIResumeUpstream());
+
+    // A new request drops the upstream on both sides
+    SCIRequestCommand(4, &uSize, 1);
+    sMasterTestResults.ui32RxDropAt = sMasterTestResults.ui32RxLineCnt + 200;
+    _RunTransferTimed();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eCmdAck);
+    sMasterTestResults.ui32RxDropAt = 0;
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 5, NULL, 0, MasterQueueDoneCb, (void*)1));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[0]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[0]);
+    TEST_ASSERT_FALSE(SCIResumeUpstream());
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+}
+
+void test_SCIMasterTransferMemory (void)
+{
+    uint32_t ui32Dst[8] = {0};
+    tuREQUESTVALUE uCnt = {.ui32_hex = SCI_MASTER_POOL_BLOCK_SIZE / sizeof(uint32_t) + 1};
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    for (uint8_t i = 0; i < 20; i++)
+        ui16_arrTest[i] = 0x100 + i;
+
+    // Results are stored in the destination buffer of the application
+    SCISetTransferDestination(ui32Dst, sizeof(ui32Dst));
+    SCIRequestGetArray(8, 5, 3);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(3, sMasterTestResults.ui32ArrayCnt);
+    TEST_ASSERT_EQUAL(0x105, ui32Dst[0]);
+    TEST_ASSERT_EQUAL(0x107, ui32Dst[2]);
+
+    // Results exceeding the destination buffer are refused cleanly
+    SCIRequestGetArray(8, 0, 0);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eArrayAck);
+    TEST_ASSERT_EQUAL(eSCI_MASTER_ERROR_OUT_OF_TRANSFER_MEMORY, sMasterTestResults.ui16ArrayErr);
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+
+    // Pool blocks are released after every transfer
+    SCISetTransferDestination(NULL, 0);
+    for (uint8_t i = 0; i < 2 * SCI_MASTER_POOL_BLOCK_CNT + 1; i++)
+    {
+        sMasterTestResults.ui32ArrayCnt = 0;
+        SCIRequestGetArray(8, 0, 0);
+        _RunTransfer();
+        TEST_ASSERT_EQUAL(20, sMasterTestResults.ui32ArrayCnt);
+    }
+
+    // Results exceeding a pool block
+    SCIRequestCommand(5, &uCnt, 1);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eCmdAck);
+    TEST_ASSERT_EQUAL(eSCI_MASTER_ERROR_OUT_OF_TRANSFER_MEMORY, sMasterTestResults.ui16CmdErr);
+    TEST_ASSERT_EQUAL(ePROTOCOL_IDLE, SCIGetProtocolState());
+}
+
+#ifdef SCI_MASTER_MIRROR_SIZE
+void test_SCIMasterMirror (void)
+{
+    uint32_t ui32FormerVal = i32_test;
+    tuREQUESTVALUE uVal = {.ui32_hex = 0x1234};
+    tsSCI_MASTER_STATS sStats;
+    uint32_t ui32Val = 0;
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    // Concurrent reads of a variable share one transfer
+    TEST_ASSERT_FALSE(SCIMirrorGet(5, 100, &ui32Val));
+    TEST_ASSERT_TRUE(SCIMirrorRead(5, 100, MasterQueueDoneCb, (void*)1));
+    TEST_ASSERT_TRUE(SCIMirrorRead(5, 100, MasterQueueDoneCb, (void*)2));
+    TEST_ASSERT_EQUAL(1, SCIGetQueuedRequestCount());
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(2, sMasterTestResults.ui32QueueDoneCnt);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_SUCCESS, sMasterTestResults.eQueueAck[1]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[0]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[1]);
+
+    // Recent values are served without transfer
+    TEST_ASSERT_TRUE(SCIMirrorRead(5, 100, MasterQueueDoneCb, (void*)3));
+    TEST_ASSERT_EQUAL(3, sMasterTestResults.ui32QueueDoneCnt);
+    TEST_ASSERT_EQUAL(0, SCIGetQueuedRequestCount());
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32QueueVal[2]);
+
+    // SETVAR responses drop the mirrored value, the next read gets the value the slave has stored
+    SCIRequestSetVar(5, uVal);
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(0x1234, i32_test);
+    TEST_ASSERT_FALSE(SCIMirrorGet(5, 100, &ui32Val));
+    TEST_ASSERT_TRUE(SCIMirrorRead(3, 100, NULL, NULL));
+    _RunTransfer();
+    TEST_ASSERT_TRUE(SCIMirrorGet(3, 100, &ui32Val));
+    uVal.ui32_hex = 0x1FF;
+    SCIRequestSetVar(3, uVal);
+    _RunTransfer();
+    TEST_ASSERT_FALSE(SCIMirrorGet(3, 100, &ui32Val));
+    TEST_ASSERT_TRUE(SCIMirrorRead(3, 100, NULL, NULL));
+    _RunTransfer();
+    TEST_ASSERT_TRUE(SCIMirrorGet(3, 100, &ui32Val));
+    TEST_ASSERT_EQUAL(0xFF, ui32Val);
+    ui8_test = 245;
+
+    // Values exceeding the maximum age are transferred again
+    ui32SimClockUs += 200000;
+    TEST_ASSERT_FALSE(SCIMirrorGet(5, 100, &ui32Val));
+    i32_test = ui32FormerVal;
+    TEST_ASSERT_TRUE(SCIMirrorRead(5, 100, MasterQueueDoneCb, (void*)4));
+    TEST_ASSERT_EQUAL(1, SCIGetQueuedRequestCount());
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(ui32FormerVal, sMasterTestResults.ui32QueueVal[3]);
+
+    // Errors are passed to every waiting read and leave no value behind
+    TEST_ASSERT_TRUE(SCIMirrorRead(999, 100, MasterQueueDoneCb, (void*)5));
+    TEST_ASSERT_TRUE(SCIMirrorRead(999, 100, MasterQueueDoneCb, (void*)6));
+    _RunTransfer();
+    TEST_ASSERT_EQUAL(6, sMasterTestResults.ui32QueueDoneCnt);
+    TEST_ASSERT_TRUE(sMasterTestResults.eQueueAck[5] != eREQUEST_ACK_STATUS_SUCCESS);
+    TEST_ASSERT_FALSE(SCIMirrorGet(999, 100, &ui32Val));
+
+    SCIMirrorInvalidate(5);
+    TEST_ASSERT_FALSE(SCIMirrorGet(5, 100, &ui32Val));
+
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_EQUAL(1, sStats.ui32MirrorHits);
+    TEST_ASSERT_EQUAL(2, sStats.ui32MirrorCoalesced);
+}
+#endif
+
+#ifdef SCI_MASTER_POLL_SIZE
+// Simulated UART at the baud rate (10 bits per byte): The clock advances by a byte time every BYTE_TIME calls
+static void _RunPolled (uint32_t ui32Baud, uint32_t ui32DurationMs)
+{
+    uint32_t ui32CallNs = (uint32_t)(10000000000ULL / ui32Baud / BYTE_TIME);
+    uint32_t ui32End = ui32SimClockUs + ui32DurationMs * 1000;
+    uint32_t ui32Ns = 0;
+
+    while ((int32_t)(ui32SimClockUs - ui32End) < 0)
+    {
+        ui32Ns += ui32CallNs;
+        ui32SimClockUs += ui32Ns / 1000;
+        ui32Ns %= 1000;
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+}
+
+void test_SCIMasterPollScheduler (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = sMasterTestCbs;
+    tsSCI_MASTER_STATS sStats;
+    tsSCI_POLL_STATS sPollStats;
+    tuREQUESTVALUE uVal;
+    uint32_t ui32Polls = 0;
+    uint32_t ui32Cnt[3], ui32Errors;
+    int8_t i8Handle[6];
+
+    sCbs.GetTxBusyStateExternalCB = MasterGetBusyState;
+    SCIMasterInit(sCbs);
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    // 100 Hz, 10 Hz and 1 Hz rate groups
+    i8Handle[0] = SCIPollRegister(3, 10, MasterPollValueCb, (void*)0);
+    i8Handle[1] = SCIPollRegister(4, 10, MasterPollValueCb, (void*)1);
+    i8Handle[2] = SCIPollRegister(5, 10, MasterPollValueCb, (void*)2);
+    i8Handle[3] = SCIPollRegister(1, 100, MasterPollValueCb, (void*)3);
+    i8Handle[4] = SCIPollRegister(2, 100, MasterPollValueCb, (void*)4);
+    i8Handle[5] = SCIPollRegister(7, 1000, MasterPollValueCb, (void*)5);
+    for (uint8_t i = 0; i < 6; i++)
+        TEST_ASSERT_TRUE(i8Handle[i] >= 0);
+
+    _RunPolled(115200, 2000);
+
+    TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32PollErrors);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[0] + 1 >= 200 && sMasterTestResults.ui32PollCnt[0] <= 200 + 1);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[2] + 1 >= 200 && sMasterTestResults.ui32PollCnt[2] <= 200 + 1);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[3] + 1 >= 20 && sMasterTestResults.ui32PollCnt[3] <= 20 + 1);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[4] + 1 >= 20 && sMasterTestResults.ui32PollCnt[4] <= 20 + 1);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[5] + 1 >= 2 && sMasterTestResults.ui32PollCnt[5] <= 2 + 1);
+    TEST_ASSERT_EQUAL(ui8_test, sMasterTestResults.ui32PollVal[0]);
+    TEST_ASSERT_EQUAL(34534, sMasterTestResults.ui32PollVal[1]);
+    TEST_ASSERT_EQUAL(i32_test, sMasterTestResults.ui32PollVal[2]);
+    TEST_ASSERT_EQUAL(ui32_eeTest, sMasterTestResults.ui32PollVal[5]);
+
+    // No deadline missed, the values arrive within the period
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_TRUE(SCIPollGetStats(i8Handle[i], &sPollStats));
+        TEST_ASSERT_EQUAL(0, sPollStats.ui32Missed);
+        TEST_ASSERT_EQUAL(0, sPollStats.ui32Errors);
+        TEST_ASSERT_TRUE(sPollStats.ui16MaxLatencyMs < 10);
+        TEST_ASSERT_TRUE(sPollStats.ui16MinLatencyMs <= sPollStats.ui16MaxLatencyMs);
+        TEST_ASSERT_TRUE(sPollStats.ui16MaxJitterMs <= sPollStats.ui16MaxLatencyMs - sPollStats.ui16MinLatencyMs);
+        TEST_ASSERT_TRUE(sPollStats.ui32JitterSumMs <= (sPollStats.ui32Polls - 1) * sPollStats.ui16MaxJitterMs);
+        ui32Polls += sPollStats.ui32Polls;
+    }
+
+    // A frame per release of the 100 Hz group, the slower groups are packed into it
+    sStats = SCIGetMasterStats();
+    TEST_ASSERT_TRUE(sStats.ui32PollFrames <= 201);
+    TEST_ASSERT_EQUAL(ui32Polls, sMasterTestResults.ui32PollCnt[0] + sMasterTestResults.ui32PollCnt[1] + sMasterTestResults.ui32PollCnt[2] +
+                      sMasterTestResults.ui32PollCnt[3] + sMasterTestResults.ui32PollCnt[4] + sMasterTestResults.ui32PollCnt[5]);
+
+    // Unregistered variables are no longer polled, others join the free slot
+    SCIPollUnregister(i8Handle[2]);
+    TEST_ASSERT_FALSE(SCIPollGetStats(i8Handle[2], &sPollStats));
+    _RunPolled(115200, 100);
+    ui32Polls = sMasterTestResults.ui32PollCnt[2];
+    _RunPolled(115200, 100);
+    TEST_ASSERT_EQUAL(ui32Polls, sMasterTestResults.ui32PollCnt[2]);
+    TEST_ASSERT_EQUAL(i8Handle[2], SCIPollRegister(6, 10, MasterPollValueCb, (void*)6));
+
+    // Variable errors are reported per variable, the others of the group keep receiving values
+    TEST_ASSERT_TRUE(SCIPollRegister(99, 10, MasterPollValueCb, (void*)7) >= 0);
+    _RunPolled(115200, 10);
+    ui32Cnt[0] = sMasterTestResults.ui32PollCnt[0];
+    ui32Cnt[1] = sMasterTestResults.ui32PollCnt[1];
+    ui32Cnt[2] = sMasterTestResults.ui32PollCnt[6];
+    ui32Errors = sMasterTestResults.ui32PollErrors;
+    _RunPolled(115200, 100);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[0] - ui32Cnt[0] >= 9);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[1] - ui32Cnt[1] >= 9);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollCnt[6] - ui32Cnt[2] >= 9);
+    TEST_ASSERT_TRUE(sMasterTestResults.ui32PollErrors - ui32Errors >= 9);
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_VAR_NUMBER_INVALID + SCI_ERROR_OFFSET, sMasterTestResults.ui16PollErr);
+    TEST_ASSERT_EQUAL(ui8_test, sMasterTestResults.ui32PollVal[0]);
+
+    // Request values of a scalar GETVAR without the list marker are rejected
+    uVal.ui32_hex = 4;
+    TEST_ASSERT_TRUE(SCIQueueRequest(eREQUEST_TYPE_GETVAR, 3, &uVal, 1, MasterQueueDoneCb, (void*)0));
+    _RunPolled(115200, 20);
+    TEST_ASSERT_EQUAL(eREQUEST_ACK_STATUS_ERROR, sMasterTestResults.eQueueAck[0]);
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_VAR_LIST_INVALID + SCI_ERROR_OFFSET, sMasterTestResults.ui16QueueErr[0]);
+
+    // Registrations are dropped by the initialization
+    SCIMasterInit(sCbs);
+    TEST_ASSERT_FALSE(SCIPollGetStats(i8Handle[0], &sPollStats));
+}
+
+void test_SCIMasterPollRate (void)
+{
+    const uint32_t ui32Bauds[] = {19200, 115200, 921600};
+    tsSCI_MASTER_CALLBACKS sCbs = sMasterTestCbs;
+    tsSCI_MASTER_STATS sStats;
+
+    sCbs.GetTxBusyStateExternalCB = MasterGetBusyState;
+
+    // The shortest period (1 ms) is longer than a frame at high baud rates, the line is idle in between:
+    // The rates are derived from the bytes on the line (values per byte at a fully occupied line)
+    for (uint8_t b = 0; b < sizeof(ui32Bauds) / sizeof(ui32Bauds[0]); b++)
+    {
+        uint32_t ui32Single, ui32Values = 0, ui32Bytes;
+
+        // One variable per frame
+        SCIMasterInit(sCbs);
+        SCISetRetryPolicy(eREQUEST_TYPE_GETVAR, (uint16_t)(2 * TX_PACKET_LENGTH * 10000 / ui32Bauds[b] + SCI_MASTER_TIMEOUT_MS), SCI_MASTER_MAX_RETRIES);
+        memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+        SCIPollRegister(5, 1, MasterPollValueCb, (void*)0);
+        _RunPolled(ui32Bauds[b], 1000);
+        TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32PollErrors);
+        ui32Single = (uint32_t)((uint64_t)sMasterTestResults.ui32PollCnt[0] * (ui32Bauds[b] / 10) /
+                                (sMasterTestResults.ui32TxLineCnt + sMasterTestResults.ui32RxLineCnt));
+
+        // Seven variables polled faster than the line allows: Packed into full frames
+        SCIMasterInit(sCbs);
+        SCISetRetryPolicy(eREQUEST_TYPE_GETVAR, (uint16_t)(2 * TX_PACKET_LENGTH * 10000 / ui32Bauds[b] + SCI_MASTER_TIMEOUT_MS), SCI_MASTER_MAX_RETRIES);
+        memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+        for (uint8_t i = 0; i < 7; i++)
+            SCIPollRegister(i + 1, 1, MasterPollValueCb, (void*)(uintptr_t)i);
+        _RunPolled(ui32Bauds[b], 1000);
+        TEST_ASSERT_EQUAL(0, sMasterTestResults.ui32PollErrors);
+        for (uint8_t i = 0; i < 7; i++)
+            ui32Values += sMasterTestResults.ui32PollCnt[i];
+        ui32Bytes = sMasterTestResults.ui32TxLineCnt + sMasterTestResults.ui32RxLineCnt;
+        ui32Values = (uint32_t)((uint64_t)ui32Values * (ui32Bauds[b] / 10) / ui32Bytes);
+        sStats = SCIGetMasterStats();
+
+        printf("Poll rate at %u baud: %u values/s in %u frames/s (one variable per frame: %u values/s)\n",
+               (unsigned)ui32Bauds[b], (unsigned)ui32Values, (unsigned)((uint64_t)sStats.ui32PollFrames * (ui32Bauds[b] / 10) / ui32Bytes),
+               (unsigned)ui32Single);
+
+        // The marker and the status word of a list cost about two values
+        TEST_ASSERT_TRUE(2 * ui32Values > 3 * ui32Single);
+    }
+
+    // Stop polling
+    SCIMasterInit(sMasterTestCbs);
+}
+#endif
+
+#ifdef SCI_SPARSE_VAR_IDS
+void test_SCISlaveSparseVarIds (void)
+{
+    uint8_t ui8Msg[] = {0x02, '1', '0', '0', '1', '?', 0x03};
+    uint8_t ui8AnsExp[]= {0x02, '1', '0', '0', '1', '?', 'A', 'C', 'K', ';', '1', '2', '3', '4', 0x03};
+    tuREQUESTVALUE uVal = {.ui32_hex = 0x4321};
+    const uint32_t ui32Lookups = 10000000;
+    uint32_t ui32Generation;
+    volatile uint32_t ui32Sink = 0;
+    clock_t tStart;
+    double dDirect, dSparse;
+
+    // Directory lookup
+    TEST_ASSERT_EQUAL(3, GetVarNumber(0x0003));
+    TEST_ASSERT_EQUAL(SIZE_OF_VAR_STRUCT, GetVarNumber(0x1001));
+    TEST_ASSERT_EQUAL(0x1001, GetVarId(SIZE_OF_VAR_STRUCT));
+    TEST_ASSERT_EQUAL(0, GetVarNumber(0x0000));
+    TEST_ASSERT_EQUAL(0, GetVarNumber(0x1000));
+    TEST_ASSERT_EQUAL(0, GetVarNumber(0x1002));
+    TEST_ASSERT_EQUAL(0, GetVarNumber(0x2001));
+
+    // The response carries the requested ID
+    for(uint8_t i = 0, j = 0; i < NUMBER_OF_LOOPS; i++)
+    {
+        if (j < sizeof(ui8Msg))
+            SCISlaveReceiveData(ui8Msg[j++]);
+
+        SCISlaveStatemachine();
+    }
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(ui8AnsExp, cTxMsgBuf, sizeof(ui8AnsExp));
+
+    // DELTA reports IDs
+    SCIMasterInit(sMasterTestCbs);
+    SCIRequestDelta(0);
+    _RunTransfer();
+    ui32Generation = sMasterTestResults.ui32Generation;
+    memset(&sMasterTestResults, 0, sizeof(sMasterTestResults));
+
+    SCIRequestSetVar(0x1001, uVal);
+    _RunTransfer();
+    SCIRequestDelta(ui32Generation);
+    _RunTransfer();
+    ui32_modTest = 0x1234;
+
+    TEST_ASSERT_EQUAL(1, sMasterTestResults.ui32PairCnt);
+    TEST_ASSERT_EQUAL(0x1001, sMasterTestResults.ui32LastPair[0]);
+    TEST_ASSERT_EQUAL(0x4321, sMasterTestResults.ui32LastPair[1]);
+
+    // Benchmark against the direct indexing of dense variable numbers
+    tStart = clock();
+    for (uint32_t i = 0; i < ui32Lookups; i++)
+        ui32Sink += varStruct[(i & 7)].eDatatype;
+    dDirect = (double)(clock() - tStart) / CLOCKS_PER_SEC;
+
+    tStart = clock();
+    for (uint32_t i = 0; i < ui32Lookups; i++)
+        ui32Sink += varStruct[GetVarNumber((i & 7) + 1) - 1].eDatatype;
+    dSparse = (double)(clock() - tStart) / CLOCKS_PER_SEC;
+
+    printf("Variable lookup: direct %.2f ns, sparse ID %.2f ns\n",
+            dDirect * 1e9 / ui32Lookups, dSparse * 1e9 / ui32Lookups);
+}
+#endif
+
+#if EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
+void test_SCISlaveEEPROMBlockInit (void)
+{
+    uint16_t ui16EEPROMImage[] = {0xBEEF, 0x5678, 0x1234};
+
+    // Variable 6 (16 bit) and variable 7 (32 bit) are stored back to back
+    memcpy(ui16EEPROMWordAddressable, ui16EEPROMImage, sizeof(ui16EEPROMImage));
+    memset(&sSlaveTestResults, 0, sizeof(sSlaveTestResults));
+
+    SCISlaveInit(sSlaveTestCbs, varStruct, cmdStruct);
+
+    TEST_ASSERT_EQUAL(1, sSlaveTestResults.ui32EEPROMReadCnt);
+    TEST_ASSERT_EQUAL(0xBEEF, ui16_eeTest);
+    TEST_ASSERT_EQUAL(0x12345678, ui32_eeTest);
+}
+#endif
+
+#if defined(SCI_STATIC_VAR_LAYOUT) && EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
+void test_SCISlaveStaticVarLayout (void)
+{
+    // Variables 6 and 7 are the only EEPROM variables
+    TEST_ASSERT_EQUAL(2, sSciVarLayout.ui8EEPROMVarCnt);
+    TEST_ASSERT_EQUAL(EEPROM_PARTITION_IDX_NONE, sSciVarLayout.pui8PartitionIdx[0]);
+    TEST_ASSERT_EQUAL(0, sSciVarLayout.pui8PartitionIdx[5]);
+    TEST_ASSERT_EQUAL(1, sSciVarLayout.pui8PartitionIdx[6]);
+    TEST_ASSERT_EQUAL(5, sSciVarLayout.pPartitionTable[0].ui8Idx);
+    TEST_ASSERT_EQUAL(ADDRESS_OFFET, sSciVarLayout.pPartitionTable[0].ui16Address);
+    TEST_ASSERT_EQUAL(6, sSciVarLayout.pPartitionTable[1].ui8Idx);
+    TEST_ASSERT_EQUAL(ADDRESS_OFFET + 1, sSciVarLayout.pPartitionTable[1].ui16Address);
+}
+#endif
+
+#if EEPROM_READ_POLICY != EEPROM_READ_ALWAYS
+void test_SCISlaveEEPROMReadOnce (void)
+{
+    tuREQUESTVALUE uVal = {.ui32_hex = 0x1234};
+
+    SCIMasterInit(sMasterTestCbs);
+
+    // The EEPROM has been read by SCISlaveInit
+    memset(&sSlaveTestResults, 0, sizeof(sSlaveTestResults));
+
+    for (uint8_t j = 0; j < 3; j++)
+    {
+        SCIRequestGetVar(6);
+        for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+        {
+            SCIMasterSM();
+            SCISlaveStatemachine();
+        }
+    }
+    TEST_ASSERT_EQUAL(0, sSlaveTestResults.ui32EEPROMReadCnt);
+
+    // RAM value stays in sync on write
+    SCIRequestSetVar(6, uVal);
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+    SCIRequestGetVar(6);
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+
+    #if EEPROM_READ_POLICY == EEPROM_READ_ONCE
+    TEST_ASSERT_EQUAL(0, sSlaveTestResults.ui32EEPROMReadCnt);
+    #else
+    // EEPROM_READ_AFTER_WRITE: The written value is verified by the next read
+    TEST_ASSERT_EQUAL(1, sSlaveTestResults.ui32EEPROMReadCnt);
+    #endif
+    TEST_ASSERT_EQUAL(1, sSlaveTestResults.ui32EEPROMWriteCnt);
+    TEST_ASSERT_EQUAL(0x1234, ui16_eeTest);
+}
+
+#endif
+
+#ifdef EEPROM_WRITE_BACK
+void test_SCISlaveEEPROMWriteBack (void)
+{
+    tuREQUESTVALUE uVal = {.ui32_hex = 0x77};
+
+    SCIMasterInit(sMasterTestCbs);
+    memset(&sSlaveTestResults, 0, sizeof(sSlaveTestResults));
+
+    // Application updates are coalesced
+    ui16_eeTest = 0x55;
+    SCISlaveVarUpdated(6);
+    SCISlaveVarUpdated(6);
+    TEST_ASSERT_EQUAL(1, SCISlaveEEPROMGetDirtyCount());
+    TEST_ASSERT_EQUAL(0, sSlaveTestResults.ui32EEPROMWriteCnt);
+
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, SCISlaveEEPROMFlush());
+    TEST_ASSERT_EQUAL(0, SCISlaveEEPROMGetDirtyCount());
+    TEST_ASSERT_EQUAL(1, sSlaveTestResults.ui32EEPROMWriteCnt);
+
+    // SETVAR answers without EEPROM access, the write happens in idle time
+    SCIRequestSetVar(6, uVal);
+    for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+    {
+        SCIMasterSM();
+        SCISlaveStatemachine();
+    }
+
+    TEST_ASSERT_EQUAL(2, sSlaveTestResults.ui32EEPROMWriteCnt);
+    TEST_ASSERT_EQUAL(0, SCISlaveEEPROMGetDirtyCount());
+
+    // A bad cell doesn't keep the other variables from being written
+    sSlaveTestResults.ui16EEPROMBadCell = sSlaveTestResults.ui16EEPROMLastAddress + 1;
+    SCISlaveVarUpdated(6);
+    SCISlaveVarUpdated(7);
+    TEST_ASSERT_TRUE(SCISlaveEEPROMFlush() != eSCI_SLAVE_ERROR_NONE);
+    TEST_ASSERT_EQUAL(1, SCISlaveEEPROMGetDirtyCount());
+    TEST_ASSERT_EQUAL(1, SCISlaveEEPROMGetFailCount());
+
+    // Idle time: The failing write backs off instead of being repeated every cycle
+    SCISlaveVarUpdated(7);
+    sSlaveTestResults.ui32EEPROMWriteCnt = 0;
+    for (uint16_t i = 0; i < 1000; i++)
+        SCISlaveStatemachine();
+    TEST_ASSERT_EQUAL(1, SCISlaveEEPROMGetDirtyCount());
+    TEST_ASSERT_TRUE(SCISlaveEEPROMGetFailCount() <= 1 + EEPROM_FLUSH_BACKOFF_MAX + 2);
+    TEST_ASSERT_TRUE(sSlaveTestResults.ui32EEPROMWriteCnt <= EEPROM_FLUSH_BACKOFF_MAX + 3);
+
+    // Writes succeed again once the cell recovers
+    sSlaveTestResults.ui16EEPROMBadCell = 0;
+    TEST_ASSERT_EQUAL(eSCI_SLAVE_ERROR_NONE, SCISlaveEEPROMFlush());
+    TEST_ASSERT_EQUAL(0, SCISlaveEEPROMGetDirtyCount());
+}
+
+#endif
+
+void test_SCIEEPROMJournal (void)
+{
+    tsSCI_SLAVE_CALLBACKS sJournalCbs = sSlaveTestCbs;
+    tsEEPROM_JOURNAL_STATS sStats;
+    uint32_t ui32MaxWear = 0;
+    const uint16_t ui16Writes = 200;
+
+    sJournalCbs.cbReadEEPROM        = SCIEEPROMJournalRead;
+    sJournalCbs.cbWriteEEPROM       = SCIEEPROMJournalWrite;
+    sJournalCbs.cbReadEEPROMBlock   = NULL;
+    sJournalCbs.cbWriteEEPROMBlock  = NULL;
+
+    memset(ui32JournalEEPROM, 0xFF, 2 * EEPROM_JOURNAL_BANK_SIZE * sizeof(uint32_t));
+    memset(ui32JournalWear, 0, 2 * EEPROM_JOURNAL_BANK_SIZE * sizeof(uint32_t));
+
+    TEST_ASSERT_TRUE(SCIEEPROMJournalInit(SimJournalReadEEPROM, SimJournalWriteEEPROM));
+    SCISlaveInit(sJournalCbs, varStruct, cmdStruct);
+    SCIMasterInit(sMasterTestCbs);
+
+    // Frequently tuned parameter
+    for (uint16_t j = 1; j <= ui16Writes; j++)
+    {
+        tuREQUESTVALUE uVal = {.ui32_hex = j};
+
+        SCIRequestSetVar(6, uVal);
+        for(uint16_t i = 0; i < NUMBER_OF_TRANSFER_LOOPS; i++)
+        {
+            SCIMasterSM();
+            SCISlaveStatemachine();
+        }
+    }
+    sStats = SCIEEPROMJournalGetStats();
+
+    for (uint16_t i = 0; i < 2 * EEPROM_JOURNAL_BANK_SIZE; i++)
+        ui32MaxWear = ui32JournalWear[i] > ui32MaxWear ? ui32JournalWear[i] : ui32MaxWear;
+
+    printf("Journal: %u logical writes, %u physical writes (amplification %.2f), %u compactions, max cell wear %u\n",
+            (unsigned)sStats.ui32LogicalWrites, (unsigned)sStats.ui32PhysicalWrites, 
+            (float)sStats.ui32PhysicalWrites / sStats.ui32LogicalWrites, (unsigned)sStats.ui32Compactions, (unsigned)ui32MaxWear);
+
+    TEST_ASSERT_EQUAL(ui16Writes, sStats.ui32LogicalWrites);
+    TEST_ASSERT_TRUE(sStats.ui32Compactions > 0);
+    TEST_ASSERT_TRUE(ui32MaxWear < ui16Writes / 4);
+
+    // Boot: Replay restores the last value
+    ui16_eeTest = 0;
+    TEST_ASSERT_TRUE(SCIEEPROMJournalInit(SimJournalReadEEPROM, SimJournalWriteEEPROM));
+    sStats = SCIEEPROMJournalGetStats();
+    SCISlaveInit(sJournalCbs, varStruct, cmdStruct);
+
+    printf("Journal: Replay with %u physical reads\n", (unsigned)sStats.ui32PhysicalReads);
+
+    TEST_ASSERT_EQUAL(ui16Writes, ui16_eeTest);
+    TEST_ASSERT_TRUE(sStats.ui32PhysicalReads <= 2 * EEPROM_JOURNAL_UNIT_SIZE + EEPROM_JOURNAL_RECORDS_PER_BANK * EEPROM_JOURNAL_RECORD_SIZE);
+}
+
 int main (void)
 {
     UNITY_BEGIN();
@@ -119,6 +1411,49 @@ int main (void)
     RUN_TEST(test_SCISlavePollVarUI16);
     RUN_TEST(test_SCISlavePollVarI32);
     RUN_TEST(test_SCISlavePollVarF32);
+    RUN_TEST(test_SCISlaveRawVarAccess);
+    RUN_TEST(test_SCISlaveNotifyDeadband);
+    RUN_TEST(test_SCISlaveDeltaRead);
+    RUN_TEST(test_SCISlaveArrayAccess);
+    RUN_TEST(test_SCISlaveMemoryWindow);
+    RUN_TEST(test_SCISlaveDownstream);
+    RUN_TEST(test_SCISlaveUpstreamSource);
+    RUN_TEST(test_SCIMasterUpstreamChunks);
+    RUN_TEST(test_SCIMasterUpstreamThroughput);
+    #ifdef SCI_MASTER_UPSTREAM_WINDOW
+    RUN_TEST(test_SCIMasterUpstreamWindowLoss);
+    #endif
+    RUN_TEST(test_SCISlaveCommandGenerator);
+    RUN_TEST(test_SCISlaveAsyncCommand);
+    RUN_TEST(test_SCISlaveCommandSteps);
+    RUN_TEST(test_SCIMasterRequestQueue);
+    RUN_TEST(test_SCIMasterTimeoutRetry);
+    RUN_TEST(test_SCIMasterDeferredRequest);
+    RUN_TEST(test_SCIMasterUpstreamResume);
+    RUN_TEST(test_SCIMasterTransferMemory);
+    #ifdef SCI_MASTER_MIRROR_SIZE
+    RUN_TEST(test_SCIMasterMirror);
+    #endif
+    #ifdef SCI_MASTER_POLL_SIZE
+    RUN_TEST(test_SCIMasterPollScheduler);
+    RUN_TEST(test_SCIMasterPollRate);
+    #endif
+    #ifdef SCI_SPARSE_VAR_IDS
+    RUN_TEST(test_SCISlaveSparseVarIds);
+    #endif
+    #if EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
+    RUN_TEST(test_SCISlaveEEPROMBlockInit);
+    #endif
+    #if defined(SCI_STATIC_VAR_LAYOUT) && EEPROM_ADDRESSTYPE == EEPROM_WORD_ADDRESSABLE
+    RUN_TEST(test_SCISlaveStaticVarLayout);
+    #endif
+    #if EEPROM_READ_POLICY != EEPROM_READ_ALWAYS
+    RUN_TEST(test_SCISlaveEEPROMReadOnce);
+    #endif
+    #ifdef EEPROM_WRITE_BACK
+    RUN_TEST(test_SCISlaveEEPROMWriteBack);
+    #endif
+    RUN_TEST(test_SCIEEPROMJournal);
 
     
     return UNITY_END();
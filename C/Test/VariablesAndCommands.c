@@ -4,19 +4,54 @@
 #include "SCIVariables.h"
 #include "SCIconfig.h"
 #include "CommandStucture.h"
+#include "SCISlave.h"
 #include "Helpers.h"
+#include "SCIVarTable.h"
 
 float testVar = 2.356;
 uint8_t ui8_test = 245;
 uint16_t ui16_test = 34534;
 uint32_t i32_test = -87344381;
 float   f_test = 2.4533;
+uint16_t ui16_eeTest = 0;
+uint32_t ui32_eeTest = 0;
+uint16_t ui16_arrTest[20];
+uint64_t ui64_test = 0x0123456789ABCDEFULL;
+uint32_t ui32_modTest = 0x1234;
 
-tsSCIVAR varStruct[] = {{&testVar, eVARTYPE_RAM, eDTYPE_F32,NULL},           // Number 1
-                        {&f_test, eVARTYPE_RAM, eDTYPE_F32,NULL},         // Number 2
-                        {&ui8_test, eVARTYPE_RAM, eDTYPE_UINT8,NULL},     // Number 3
-                        {&ui16_test, eVARTYPE_RAM, eDTYPE_UINT16,NULL},   // Number 4
-                        {&i32_test, eVARTYPE_RAM, eDTYPE_INT32,NULL}};    // Number 5
+#ifdef SCI_STATIC_VAR_LAYOUT
+#define TEST_VAR_TABLE(X) \
+    X(testVar,      &testVar,       eVARTYPE_RAM,       eDTYPE_F32,     NULL, 0)    /* Number 1 */ \
+    X(f_test,       &f_test,        eVARTYPE_RAM,       eDTYPE_F32,     NULL, 0)    /* Number 2 */ \
+    X(ui8_test,     &ui8_test,      eVARTYPE_RAM,       eDTYPE_UINT8,   NULL, 0)    /* Number 3 */ \
+    X(ui16_test,    &ui16_test,     eVARTYPE_RAM,       eDTYPE_UINT16,  NULL, 0)    /* Number 4 */ \
+    X(i32_test,     &i32_test,      eVARTYPE_RAM,       eDTYPE_INT32,   NULL, 0)    /* Number 5 */ \
+    X(ui16_eeTest,  &ui16_eeTest,   eVARTYPE_EEPROM,    eDTYPE_UINT16,  NULL, 0)    /* Number 6 */ \
+    X(ui32_eeTest,  &ui32_eeTest,   eVARTYPE_EEPROM,    eDTYPE_UINT32,  NULL, 0)    /* Number 7 */ \
+    X(ui16_arrTest, ui16_arrTest,   eVARTYPE_RAM,       eDTYPE_UINT16,  NULL, 20)   /* Number 8 */ \
+    X(ui64_test,    &ui64_test,     eVARTYPE_RAM,       eDTYPE_UINT64,  NULL, 0)    /* Number 9 */
+
+#define TEST_MODULE_VAR_TABLE(X) \
+    X(ui32_modTest, &ui32_modTest,  eVARTYPE_RAM,       eDTYPE_UINT32,  NULL, 0)    /* Number 10, ID 0x1001 */
+
+#define TEST_VAR_BLOCKS(B) \
+    B(CORE,     0x0,    TEST_VAR_TABLE) \
+    B(MODULE,   0x1,    TEST_MODULE_VAR_TABLE)
+
+SCI_VAR_BLOCKS_DECLARE(TEST_VAR_BLOCKS)
+SCI_VAR_BLOCKS_DEFINE(TEST_VAR_BLOCKS, varStruct)
+#else
+const tsSCIVAR varStruct[] = {{&testVar, eVARTYPE_RAM, eDTYPE_F32,NULL,0},           // Number 1
+                        {&f_test, eVARTYPE_RAM, eDTYPE_F32,NULL,0},         // Number 2
+                        {&ui8_test, eVARTYPE_RAM, eDTYPE_UINT8,NULL,0},     // Number 3
+                        {&ui16_test, eVARTYPE_RAM, eDTYPE_UINT16,NULL,0},   // Number 4
+                        {&i32_test, eVARTYPE_RAM, eDTYPE_INT32,NULL,0},     // Number 5
+                        {&ui16_eeTest, eVARTYPE_EEPROM, eDTYPE_UINT16,NULL,0},  // Number 6
+                        {&ui32_eeTest, eVARTYPE_EEPROM, eDTYPE_UINT32,NULL,0},  // Number 7
+                        {ui16_arrTest, eVARTYPE_RAM, eDTYPE_UINT16,NULL,20},  // Number 8
+                        {&ui64_test, eVARTYPE_RAM, eDTYPE_UINT64,NULL,0},     // Number 9
+                        {&ui32_modTest, eVARTYPE_RAM, eDTYPE_UINT32,NULL,0}}; // Number 10
+#endif
 
 uint8_t ui8_testBuffer[20] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
 uint32_t ui32_testBuffer[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
@@ -25,6 +60,9 @@ uint32_t ui32_testBuffer[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
 #ifdef VALUE_MODE_HEX
 teREQUEST_ACKNOWLEDGE testCmd (uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
 {
+    (void)pui32_valArray;
+    (void)ui8_valArrayLen;
+
     memcpy(psData->puRespVals, ui32_testBuffer, sizeof(ui32_testBuffer));
     psData->ui32DatLen  = 10;
 
@@ -45,4 +83,127 @@ COMMAND_CB_STATUS testCmd (float* pf_valArray, uint8_t ui8_valArrayLen, PROCESS_
 }
 #endif
 
-COMMAND_CB cmdStruct = {testCmd};
+#ifdef VALUE_MODE_HEX
+// Upstream source generating the data on demand
+uint32_t ui32_upsSourceReads = 0;
+uint8_t ui8_upsSourcePeak = 0;
+uint32_t ui32_upsSourceBytes = 0;
+
+static uint8_t testUpstreamSource (void *pCtx, uint32_t ui32Offset, uint8_t *pui8Dst, uint8_t ui8MaxLen)
+{
+    ui32_upsSourceReads++;
+    if (ui8MaxLen > ui8_upsSourcePeak)
+        ui8_upsSourcePeak = ui8MaxLen;
+    ui32_upsSourceBytes += ui8MaxLen;
+
+    for (uint8_t i = 0; i < ui8MaxLen; i++)
+        pui8Dst[i] = (uint8_t)((ui32Offset + i) * 7 + *(uint8_t*)pCtx);
+
+    return ui8MaxLen;
+}
+
+teREQUEST_ACKNOWLEDGE testUpstreamCmd (uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+{
+    static uint8_t ui8Seed = 3;
+
+    if (ui8_valArrayLen < 1)
+        return eREQUEST_ACK_STATUS_ERROR;
+
+    psData->cbUpStreamRead  = testUpstreamSource;
+    psData->pUpStreamCtx    = &ui8Seed;
+    psData->ui32DatLen      = pui32_valArray[0];
+
+    return eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM;
+}
+
+// Result generator producing the values on demand
+uint32_t ui32_genCalls = 0;
+uint32_t ui32_genVals = 0;
+uint8_t ui8_genPeak = 0;
+
+static uint8_t testResultGenerator (void *pCtx, uint32_t ui32Idx, tuRESPONSEVALUE *puVals, uint8_t ui8MaxCnt)
+{
+    (void)pCtx;
+
+    ui32_genCalls++;
+    ui32_genVals += ui8MaxCnt;
+    if (ui8MaxCnt > ui8_genPeak)
+        ui8_genPeak = ui8MaxCnt;
+
+    for (uint8_t i = 0; i < ui8MaxCnt; i++)
+        puVals[i].ui32_hex = (ui32Idx + i) * 3 + 1;
+
+    return ui8MaxCnt;
+}
+
+teREQUEST_ACKNOWLEDGE testGeneratorCmd (uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+{
+    if (ui8_valArrayLen < 1)
+        return eREQUEST_ACK_STATUS_ERROR;
+
+    psData->ui8InfoFlagBits.respGenerated = true;
+    psData->cbRespGen   = testResultGenerator;
+    psData->pRespGenCtx = NULL;
+    psData->ui32DatLen  = pui32_valArray[0];
+
+    return eREQUEST_ACK_STATUS_SUCCESS_DATA;
+}
+
+// Slow operation, completed later through SCISlaveCompleteCommand
+uint32_t ui32_asyncCalls = 0;
+
+teREQUEST_ACKNOWLEDGE testAsyncCmd (uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+{
+    (void)pui32_valArray;
+    (void)ui8_valArrayLen;
+    (void)psData;
+
+    ui32_asyncCalls++;
+
+    return eREQUEST_ACK_STATUS_PENDING;
+}
+
+// Slow operation executed in slices of 30 us (simulated clock)
+#define TEST_STEP_US    30
+extern uint32_t ui32SimClockUs;
+uint32_t ui32_stepCalls = 0;
+
+static teREQUEST_ACKNOWLEDGE testStep (void *pCtx, tuRESPONSEVALUE *puVals, uint8_t *pui8ValCnt, uint16_t *pui16Error)
+{
+    uint32_t *pui32Remaining = (uint32_t*)pCtx;
+
+    (void)pui16Error;
+
+    ui32SimClockUs += TEST_STEP_US;
+    ui32_stepCalls++;
+
+    if (--(*pui32Remaining) > 0)
+        return eREQUEST_ACK_STATUS_PENDING;
+
+    puVals[0].ui32_hex = ui32_stepCalls;
+    *pui8ValCnt = 1;
+    return eREQUEST_ACK_STATUS_SUCCESS_DATA;
+}
+
+teREQUEST_ACKNOWLEDGE testStepCmd (uint32_t* pui32_valArray, uint8_t ui8_valArrayLen, tsTRANSFER_DATA *psData)
+{
+    static uint32_t ui32Remaining;
+
+    if (ui8_valArrayLen < 1 || pui32_valArray[0] == 0)
+        return eREQUEST_ACK_STATUS_ERROR;
+
+    ui32Remaining       = pui32_valArray[0];
+    psData->cbStep      = testStep;
+    psData->pStepCtx    = &ui32Remaining;
+
+    return eREQUEST_ACK_STATUS_PENDING;
+}
+#endif
+
+COMMAND_CB cmdStruct[] = {testCmd,                        // Number 1
+                          SCISlaveCmdEEPROMFlush,         // Number 2
+                          SCISlaveCmdEEPROMDirtyCount,    // Number 3
+                          testUpstreamCmd,                // Number 4
+                          testGeneratorCmd,               // Number 5
+                          testAsyncCmd,                   // Number 6
+                          testStepCmd};                   // Number 7
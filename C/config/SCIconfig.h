@@ -28,17 +28,34 @@
 #define RX_PACKET_LENGTH    128
 #define TX_PACKET_LENGTH    128
 
-#define SIZE_OF_VAR_STRUCT  5
-#define SIZE_OF_CMD_STRUCT  2
+#define SIZE_OF_VAR_STRUCT  10
+#define SIZE_OF_CMD_STRUCT  7
 #define MAX_NUMBER_OF_EEPROM_VARS 10
 
+// Optional switches that are commented out below keep the previous behaviour. The unit tests run with
+// this configuration and once more with the switches given on the compiler command line:
+// -DEEPROM_READ_POLICY=EEPROM_READ_ONCE -DEEPROM_WRITE_BACK
+// -DSCI_NO_FLOAT -DSCI_STATIC_VAR_LAYOUT -DSCI_SPARSE_VAR_IDS
+
 // Mode configuration
 #define SEND_MODE_BYTE_BY_BYTE
 #define VALUE_MODE_HEX
+// #define SCI_NO_FLOAT     // Float support compiled out (requires VALUE_MODE_HEX)
 
 // EEPROM configuration
 #define EEPROM_ADDRESSTYPE  EEPROM_WORD_ADDRESSABLE
 #define ADDRESS_OFFET       0
+// #define EEPROM_READ_POLICY  EEPROM_READ_ONCE     // Default: EEPROM_READ_ALWAYS
+// #define EEPROM_WRITE_BACK                        // Default: Write through
+#define EEPROM_FLUSH_BACKOFF_MAX    8   // Idle cycles skipped after failed writes: 2^n for n consecutive failures, up to this n (max. 15)
+
+// Variable table and EEPROM layout are generated at compile time (see SCIVarTable.h)
+// #define SCI_STATIC_VAR_LAYOUT                    // Default: Table and layout set up at runtime
+#define SCI_EEPROM_SIZE     0x800
+
+// Sparse, stable variable IDs grouped into blocks (requires SCI_STATIC_VAR_LAYOUT)
+// #define SCI_SPARSE_VAR_IDS                       // Default: Variable IDs are the table positions
+#define SCI_VAR_ID_BLOCK_BITS 12
 
 // SCI error offset (SCI currently defines 11 errors)
 #define SCI_ERROR_OFFSET    0x100
@@ -47,4 +64,45 @@
 #define MAX_NUM_REQUEST_VALUES  10
 #define MAX_NUM_RESPONSE_VALUES 10
 
+// Number of requests the master can queue
+#define SCI_MASTER_QUEUE_LENGTH 8
+
+// Default response timeouts and retries of the master (see SCISetRetryPolicy)
+#define SCI_MASTER_TIMEOUT_MS           50
+#define SCI_MASTER_COMMAND_TIMEOUT_MS   500
+#define SCI_MASTER_MAX_RETRIES          2
+
+// Static memory of the master for transfer results and upstream data (one block per transfer)
+#define SCI_MASTER_POOL_BLOCK_SIZE  8192
+#define SCI_MASTER_POOL_BLOCK_CNT   2
+
+// Upstream speedup, only one of both may be enabled:
+// Request the next upstream chunk while the current one is received
+// #define SCI_MASTER_UPSTREAM_PIPELINE
+
+// Free running upstream: The slave sends up to this number of chunks beyond the offset the master 
+// has acknowledged without further requests
+#define SCI_MASTER_UPSTREAM_WINDOW  8
+
+#if defined(SCI_MASTER_UPSTREAM_PIPELINE) && defined(SCI_MASTER_UPSTREAM_WINDOW)
+#error "SCI_MASTER_UPSTREAM_PIPELINE and SCI_MASTER_UPSTREAM_WINDOW are mutually exclusive"
+#endif
+
+// Mirror of variable values on the master (optional, see SCIMirrorRead): Number of variables and
+// number of reads that can wait for the GETVAR of their variable
+#define SCI_MASTER_MIRROR_SIZE      8
+#define SCI_MASTER_MIRROR_WAITERS   8
+
+// Polling scheduler of the master (optional, see SCIPollRegister): Number of polled variables
+#define SCI_MASTER_POLL_SIZE        16
+
+// Number of variables that can be subscribed for change notifications
+#define MAX_NUMBER_OF_SUBSCRIPTIONS 4
+
+// Number of commands that can be completed asynchronously at the same time
+#define MAX_NUMBER_OF_PENDING_COMMANDS 2
+
+// Time budget of the sliced command steps per state machine call
+#define SCI_COMMAND_STEP_BUDGET_US  100
+
 #endif // _SCICONFIG_H_
\ No newline at end of file
@@ -8,6 +8,7 @@ History:
 """
 
 import serial
+import string
 import struct
 import time
 from enum import Enum
@@ -25,6 +26,8 @@ class CommandID(Enum):
     COMMAND     = ':'
     UPSTREAM    = '>'
     DOWNSTREAM  = '<'
+    NOTIFY      = '*'
+    COMPLETE    = '$'
 
 class Datatype(Enum):
     DTYPE_UINT8    = ('B',1)
@@ -71,15 +74,39 @@ class Function:
         self.returnTypeList     : Iterable[Datatype]    = returnTypeList
         self.requestsUpstream   : bool                  = requestsUpstream
 
+class MirrorEntry:
+
+    def __init__(self):
+        self.value      : Optional[Union[float, int]]   = None
+        self.timestamp  : Optional[float]               = None  # time.monotonic() of the value
+        self.pending    : Optional[MirrorRead]          = None  # GETVAR in flight
+
+class MirrorRead:
+
+    def __init__(self):
+        self.done       : threading.Event               = threading.Event()
+        self.value      : Optional[Union[float, int]]   = None
+        self.error      : Optional[Exception]           = None
+
 class SCI:
     STX = 2
     ETX = 3
 
     #==============================================================================
-    def __init__(self, port : str, maxPacketSize : int, baud : int = 115200, timeout : float = 5, numberFormat : NumberFormat = NumberFormat.HEX):
+    def __init__(self, port : str, maxPacketSize : int, baud : int = 115200, timeout : float = 5, numberFormat : NumberFormat = NumberFormat.HEX, mirrorMaxAge : Optional[float] = None):
+        """
+        Parameters:
+        -----------
+        - mirrorMaxAge  : Values read or set within this number of seconds are returned by 
+                          getvalue without transfer (None: No mirror, see getvalue)
+        """
 
         self.ressourceLock = threading.Lock()
 
+        self.mirrorMaxAge   = mirrorMaxAge
+        self.mirrorLock     = threading.Lock()
+        self.mirror         : Dict[int, MirrorEntry] = {}
+
         self.device = serial.Serial(port=port, baudrate=baud, timeout=timeout)
         # serial module needs settling time...
         time.sleep(1)
@@ -87,6 +114,9 @@ class SCI:
         self.numberFormat = numberFormat
         self.maxPacketSize = maxPacketSize
 
+        # Numbers of commands the device announced as completed ("$" frames)
+        self.completed      : Set[int] = set()
+
     #==============================================================================
     def _decode(self, msg : bytearray, cmdID : CommandID, ongoing : bool = False) -> Response:
         """
@@ -152,8 +182,8 @@ class SCI:
                 datStrArr = msgDat[0].split(',')
                 rsp.dataArray = [int(data, 16) for data in datStrArr]
 
-        elif cmdID.name == 'GETVAR' or cmdID == 'SETVAR':
-            # Data Transfer and Upstream
+        elif cmdID.name == 'GETVAR' or cmdID.name == 'DOWNSTREAM' or cmdID == 'SETVAR':
+            # Data Transfer and Upstream (DOWNSTREAM: next offset expected by the device)
             if len(msgDat) > 1:
                 if self.numberFormat.name == 'HEX':
                     rsp.dataArray = [int(msgDat[1], 16)]
@@ -192,7 +222,7 @@ class SCI:
                 #     raise ValueError('command.dataArray and command.datatypeArray must be iterables.')
                 
                 formatArray = f'{"".join(type.value[0] for type in command.datatypeArray)}'
-                byteStringArray = [struct.pack(f'>{formatItem}', dataItem).hex().upper().lstrip('0') for formatItem, dataItem in zip(formatArray, command.dataArray)]
+                byteStringArray = [(struct.pack(f'>{formatItem}', dataItem).hex().upper().lstrip('0') or '0') for formatItem, dataItem in zip(formatArray, command.dataArray)]
 
             if byteStringArray is not None:
                 packet = f'{num}{command.commandID.value}{",".join(item for item in byteStringArray)}'
@@ -240,14 +270,57 @@ class SCI:
 
     
     #==============================================================================
-    def command(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None) -> Union[List[Union[float, int]], int]:
+    def _discardInput(self):
+        """
+        Drops the data the device still sends for an aborted transfer: Waits until
+        the line is quiet, then clears the input buffer.
+        """
+
+        while self.device.read(size = self.maxPacketSize + 2):
+            pass
+        self.device.reset_input_buffer()
+
+    #==============================================================================
+    def _readResponse(self) -> bytes:
+        """
+        Reads the next response line. Frames the device sends without request
+        (NOTIFY, COMPLETE announcements of asynchronous commands) are skipped,
+        completions are recorded in self.completed.
+
+        Returns:
+        --------
+        - Received data line (STX -> ETX), empty on timeout
+        """
+
+        while True:
+            response = self.device.read_until(b'\x03')
+            if len(response) < 2:
+                return response
+
+            msgStr = response[1:-1].decode(errors='replace')
+            idx = 0
+            while idx < len(msgStr) and (msgStr[idx] in string.hexdigits or msgStr[idx] in '.-'):
+                idx += 1
+
+            if idx == len(msgStr) or msgStr[idx] not in (CommandID.NOTIFY.value, CommandID.COMPLETE.value):
+                return response
+
+            if msgStr[idx] == CommandID.COMPLETE.value:
+                try:
+                    self.completed.add(int(msgStr[:idx], 16) if self.numberFormat.name == 'HEX' else int(float(msgStr[:idx]) + 0.5))
+                except ValueError:
+                    pass
+
+    #==============================================================================
+    def command(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None, pollInterval : float = 0.05) -> Union[List[Union[float, int]], int]:
         """
         Send a command to the SCI device.
 
         Parameters:
         -----------
-        - function  : Function object of the external callback to execute
-        - paramList : List of parameters to be passed to the external callback
+        - function      : Function object of the external callback to execute
+        - paramList     : List of parameters to be passed to the external callback
+        - pollInterval  : Delay between polls of a command the device completes asynchronously (PND)
 
         Returns:
         --------
@@ -277,7 +350,7 @@ class SCI:
                 packet = self._encode(cmd)
                 self.device.flush()
                 self._send(packet)
-                response = self.device.read_until(b'\x03')
+                response = self._readResponse()
                 if len(response) == 0:
                     raise Exception('COMMAND - Timeout occured')
                 rsp = self._decode(bytearray(response), cmd.commandID, ongoing)
@@ -291,6 +364,12 @@ class SCI:
                     raise Exception(f'COMMAND - Error: {rsp.dataArray[0]}')
                 elif rsp.acknowledge == 'NAK':
                     raise Exception('COMMAND - Unknown Command')
+                elif rsp.acknowledge == 'PND':
+                    # Still running on the device: repeating the command polls it (right away once completed)
+                    if function.number not in self.completed:
+                        time.sleep(pollInterval)
+                    self.completed.discard(function.number)
+                    continue
                 # elif rsp.acknowledge == 'DAT':
                 #     expectedDatalen = rsp.dataLength
                 
@@ -334,13 +413,20 @@ class SCI:
             packet = self._encode(cmd)
             self.device.flush()
             self._send(packet)
-            response = self.device.read_until(b'\x03')
+            response = self._readResponse()
 
         if len(response) == 0:
             raise Exception('SETVALUE - Timeout occured')
         rsp = self._decode(bytearray(response), cmd.commandID)
 
         if rsp.acknowledge == 'ACK':
+            # The mirror holds the value as stored by the device (the transfer's datatype conversion)
+            if self.numberFormat.name == 'HEX' or variable.type == Datatype.DTYPE_F32:
+                fmt = f'>{variable.type.value[0]}'
+                self._mirrorStore(variable.number, struct.unpack(fmt, struct.pack(fmt, value))[0])
+            else:
+                # Integer conversion of a float transfer is done by the device
+                self.invalidate(variable)
             return
         elif rsp.acknowledge == 'ERR':
             raise Exception(f'SETVALUE - Error: {rsp.dataArray[0]}')
@@ -348,18 +434,98 @@ class SCI:
             raise Exception('SETVALUE - Variable unknown')
 
 
-    def getvalue(self, variable : Variable) -> Union[float,int]:
+    def getvalue(self, variable : Variable, maxAge : Optional[float] = None) -> Union[float,int]:
         """
         Requests a variable value from the variable struct.
 
+        With the mirror enabled (mirrorMaxAge or maxAge), a value read or set within
+        the maximum age is returned without transfer. Threads requesting a variable 
+        whose transfer is in flight wait for its result instead of starting another one.
+
         Parameters:
         -----------
-        - variable: Object of the variable to request
+        - variable  : Object of the variable to request
+        - maxAge    : Maximum age of a mirrored value in seconds (None: mirrorMaxAge)
 
         Returns:
         --------
         - Variable value of the requested struct variable
         """
+
+        if maxAge is None:
+            maxAge = self.mirrorMaxAge
+
+        if maxAge is None:
+            return self._getvalue(variable)
+
+        with self.mirrorLock:
+            entry = self.mirror.setdefault(variable.number, MirrorEntry())
+
+            if entry.timestamp is not None and time.monotonic() - entry.timestamp <= maxAge:
+                return entry.value
+
+            read = entry.pending
+            owner = read is None
+            if owner:
+                read = entry.pending = MirrorRead()
+
+        # Coalesced with the transfer of another thread
+        if not owner:
+            read.done.wait()
+            if read.error is not None:
+                raise read.error
+            return read.value
+
+        started = time.monotonic()
+        try:
+            read.value = self._getvalue(variable)
+        except Exception as e:
+            read.error = e
+
+        with self.mirrorLock:
+            entry.pending = None
+            # A value set meanwhile is newer
+            if read.error is None:
+                if entry.timestamp is None or entry.timestamp < started:
+                    entry.value = read.value
+                    entry.timestamp = time.monotonic()
+            else:
+                entry.timestamp = None
+        read.done.set()
+
+        if read.error is not None:
+            raise read.error
+        return read.value
+
+    def invalidate(self, variable : Optional[Variable] = None):
+        """
+        Drops mirrored values, the next getvalue transfers them.
+
+        Parameters:
+        -----------
+        - variable  : Variable to drop (None: All variables)
+        """
+
+        with self.mirrorLock:
+            for number, entry in self.mirror.items():
+                if variable is None or number == variable.number:
+                    entry.timestamp = None
+
+    def _mirrorStore(self, number : int, value : Union[float, int]):
+        """
+        Takes over a value the device has acknowledged (mirrored variables only).
+        """
+
+        with self.mirrorLock:
+            entry = self.mirror.get(number)
+            if entry is not None:
+                entry.value = value
+                entry.timestamp = time.monotonic()
+
+    def _getvalue(self, variable : Variable) -> Union[float,int]:
+        """
+        GETVAR transfer of getvalue.
+        """
         
         # Construct command
         cmd = Command()
@@ -372,7 +538,7 @@ class SCI:
             packet = self._encode(cmd)
             self.device.flush()
             self._send(packet)
-            response = self.device.read_until(b'\x03')
+            response = self._readResponse()
 
         if len(response) == 0:
             raise Exception('GETVALUE - Timeout occured')
@@ -387,7 +553,7 @@ class SCI:
             raise Exception('GETVALUE - Variable unknown')
 
 
-    def requestUpstream(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None) -> bytearray:
+    def requestUpstream(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None, window : Optional[int] = None) -> bytearray:
         """
         Upstream request function. 
         TODO: To be tested!!!
@@ -396,6 +562,8 @@ class SCI:
         -----------
         - function  : Function object of the external callback to request.
         - paramList : Parameter to be passed to the external function
+        - window    : Free running upstream: Number of chunks the device sends beyond
+                      the acknowledged data without further requests (HEX number format only)
 
         Returns:
         --------
@@ -405,6 +573,9 @@ class SCI:
         # Request upstream
         upstreamSize = self.command(function, paramList=paramList)
 
+        if window is not None:
+            return self._requestUpstreamWindow(function.number, int(upstreamSize), window)
+
         cmd = Command()
         cmd.number      = function.number
         cmd.commandID   = CommandID.UPSTREAM
@@ -413,6 +584,14 @@ class SCI:
 
         with self.ressourceLock:
 
+            # The next chunk is requested as soon as the device starts sending the current
+            # one, so the line doesn't idle between the chunks (the device accepts one
+            # request while it transmits)
+            packet = self._encode(cmd)
+            self.device.flush()
+            if upstreamSize > 0:
+                self._send(packet)
+
             while (len(data) < upstreamSize):
                 remainingData = (upstreamSize - len(data))
 
@@ -422,29 +601,188 @@ class SCI:
                     rspDatLen =  remainingData
 
                 rspDatLen += 2 # Take care for STX and ETX
-                
-                # Send the request
-                packet = self._encode(cmd)
-                self.device.flush()
-                self._send(packet)
+
+                # Wait for the start of the chunk
+                response = self.device.read(size = 1)
+
+                if response and (remainingData > self.maxPacketSize):
+                    self._send(packet)
 
                 # TODO: This has to be replaced by a function reading number of bytes if the upstream has been switched to binary format
-                # response = self.device.read_until(b'\x03')
-                response = self.device.read(size = rspDatLen)
+                response += self.device.read(size = rspDatLen - len(response))
 
                 if len(response) < rspDatLen:
+                    # The chunk of a pipelined request must not be taken as response of the next command
+                    self._discardInput()
                     raise Exception('UPSTREAM REQUEST - Timeout occured')
 
                  # Remove STX and ETX
                 response = bytearray(response[1 : -1])
 
-                # rsp = self._decode(bytearray(response), cmd.commandID)
-                
-                data.extend(response.copy())
-                # Sleep time necessary for reliable data transmission
-                time.sleep(0.01)
+                data.extend(response)
+
+        return data
+
+    def _requestUpstreamWindow(self, number : int, upstreamSize : int, window : int, maxRetries : int = 2) -> bytearray:
+        """
+        Free running upstream: The device streams the chunks back to back as long as
+        they are within the window beyond the acknowledged offset. Every half window
+        is acknowledged. A lost chunk is requested again from the first missing byte
+        once the line is quiet.
+
+        Parameters:
+        -----------
+        - number        : Number of the function that initiated the upstream
+        - upstreamSize  : Number of bytes announced by the device
+        - window        : Window size in chunks
+        - maxRetries    : Number of restarts before giving up
+
+        Returns:
+        --------
+        - bytearray holding the upstream data
+        """
+
+        if self.numberFormat.name != 'HEX':
+            raise ValueError('The free running upstream requires the HEX number format.')
+
+        def request(values : List[int]):
+            cmd = Command()
+            cmd.number          = number
+            cmd.commandID       = CommandID.UPSTREAM
+            cmd.dataArray       = values
+            cmd.datatypeArray   = [Datatype.DTYPE_UINT32] * len(values)
+            self._send(self._encode(cmd))
+
+        data = bytearray([])
+        acked = 0
+        retries = 0
+        ackDistance = ((window + 1) // 2) * self.maxPacketSize
+
+        with self.ressourceLock:
+
+            self.device.flush()
+            request([window, 0])
+
+            while (len(data) < upstreamSize):
+                rspDatLen = min(self.maxPacketSize, upstreamSize - len(data)) + 2
+
+                response = self.device.read(size = rspDatLen)
+
+                # Lost chunk: Wait until the device has sent the rest of the window, then restart
+                if len(response) < rspDatLen or response[0] != self.STX or response[-1] != self.ETX:
+                    if retries == maxRetries:
+                        self._discardInput()
+                        raise Exception('UPSTREAM REQUEST - Timeout occured')
+                    retries += 1
+
+                    while self.device.read(size = self.maxPacketSize + 2):
+                        pass
+
+                    acked = len(data)
+                    request([window, acked])
+                    continue
+
+                data.extend(response[1 : -1])
+                retries = 0
+
+                # Acknowledge every half window (the last acknowledge releases the data on the device)
+                if len(data) - acked >= ackDistance or len(data) == upstreamSize:
+                    acked = len(data)
+                    request([acked])
 
         return data
     
 
+    #==============================================================================
+    def _downstreamRequest(self, cmd : Command, value : int, chunk : Optional[bytes] = None) -> int:
+        """
+        Sends a single DOWNSTREAM request (announce or chunk).
+
+        Parameters:
+        -----------
+        - cmd   : DOWNSTREAM command
+        - value : Size of the transfer (announce) or offset of the chunk
+        - chunk : Chunk data (None: announce)
+
+        Returns:
+        --------
+        - Offset the device expects next
+        """
+
+        cmd.dataArray = [value]
+        packet = self._encode(cmd)
+
+        # Chunk data follows as hex digit pairs
+        if chunk is not None:
+            packet.extend(bytearray(';' + chunk.hex().upper(), 'ASCII'))
+
+        self.device.flush()
+        self._send(packet)
+        response = self._readResponse()
+
+        if len(response) == 0:
+            raise Exception('DOWNSTREAM - Timeout occured')
+
+        rsp = self._decode(bytearray(response), cmd.commandID)
+
+        if rsp.acknowledge == 'ACK':
+            return int(rsp.dataArray[0])
+        elif rsp.acknowledge == 'ERR':
+            raise Exception(f'DOWNSTREAM - Error: {rsp.dataArray[0]}')
+        else:
+            raise Exception('DOWNSTREAM - Unknown request')
+
+    #==============================================================================
+    def downstream(self, number : int, data : Union[bytes, bytearray], resume : bool = False, maxRetries : int = 2) -> int:
+        """
+        Transfers binary data to the downstream sink of the SCI device.
+
+        The transfer is announced with its size, afterwards the data is sent in chunks
+        from the offset the device acknowledges. Chunks the device did not take are
+        repeated with a growing delay, the transfer is aborted after maxRetries
+        consecutive refusals of the same chunk.
+
+        Parameters:
+        -----------
+        - number        : Downstream number (passed to the sink of the device)
+        - data          : Bytes to transfer
+        - resume        : Continue an interrupted transfer at the offset of the device
+        - maxRetries    : Number of repetitions of a refused chunk before giving up
+
+        Returns:
+        --------
+        - Number of bytes acknowledged by the device
+        """
+
+        # "FFFF<FFFFFFFF;" header, two hex digits per byte
+        chunkSize = (self.maxPacketSize - 16) // 2
+
+        cmd = Command()
+        cmd.number          = number
+        cmd.commandID       = CommandID.DOWNSTREAM
+        cmd.datatypeArray   = [Datatype.DTYPE_UINT32]
+
+        with self.ressourceLock:
+            # An empty chunk just returns the offset of the device
+            if resume:
+                offset = self._downstreamRequest(cmd, 0, bytes())
+            else:
+                offset = self._downstreamRequest(cmd, len(data))
+
+            refusals = 0
+            while offset < len(data):
+                newOffset = self._downstreamRequest(cmd, offset, bytes(data[offset : offset + chunkSize]))
+
+                # Sink busy -> Back off, give up after the retries
+                if newOffset == offset:
+                    refusals += 1
+                    if refusals > maxRetries:
+                        raise Exception('DOWNSTREAM - Chunk at offset ' + str(offset) + ' refused ' + str(refusals) + ' times')
+                    time.sleep(0.01 * (1 << refusals))
+                else:
+                    refusals = 0
+                    # Sleep time necessary for reliable data transmission
+                    time.sleep(0.01)
+                offset = newOffset
 
+        return offset
@@ -21,6 +21,8 @@ data = inst.command(fcn2, paramList=[4])
 print(data)
 data = inst.getvalue(par1)
 print(data)
+data = inst.downstream(1, bytes(range(200)))
+print(data)
 print(time() - start)
 # packet.insert(0,2)
 # packet.append(3)